@@ -0,0 +1,192 @@
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "priority_queue.hpp"
+#include "test-utility.hpp"
+
+template <typename T, typename C>
+std::vector<T> Drain(sjtu::priority_queue<T, C> q)
+{
+	std::vector<T> out;
+	while (!q.empty()) {
+		out.push_back(q.top());
+		q.pop();
+	}
+	return out;
+}
+
+// pushes and pops at random, a walk of the size that stays above n / 2
+void Churn(sjtu::priority_queue<int> &q, size_t n, size_t rounds)
+{
+	for (size_t i = 0; i < rounds; ++i) {
+		if (q.size() < n / 2 || (q.size() < 2 * n && rand64() % 2 == 0)) {
+			q.push(static_cast<int>(rand64() % 1000000007));
+		} else {
+			q.pop();
+		}
+	}
+}
+
+// copying throws once armed and the countdown runs out, moving may throw too
+int copies_left = -1;
+
+struct Fragile {
+	int value;
+	Fragile(int v) : value(v) {}
+	Fragile(const Fragile &other) : value(other.value)
+	{
+		if (copies_left == 0) {
+			throw sjtu::runtime_error();
+		}
+		if (copies_left > 0) {
+			--copies_left;
+		}
+	}
+	Fragile(Fragile &&other) : value(other.value) {}
+	Fragile &operator=(const Fragile &) = default;
+	bool operator<(const Fragile &other) const
+	{
+		return value < other.value;
+	}
+	bool operator==(const Fragile &other) const
+	{
+		return value == other.value;
+	}
+};
+
+void TestCompact()
+{
+	std::cout << "Testing compact..." << std::endl;
+	sjtu::priority_queue<int> q;
+	Churn(q, 1000, 20000);
+	std::vector<int> before = Drain(q);
+	size_t held = q.capacity();
+	q.compact();
+	std::cout << (held > q.size()) << " " << (q.capacity() == q.size()) << " " << (Drain(q) == before) << std::endl;
+	// it keeps working as a heap after compaction
+	Churn(q, 1000, 5000);
+	sjtu::priority_queue<int> copy(q);
+	std::cout << (copy.capacity() == copy.size()) << " " << (Drain(copy) == Drain(q)) << std::endl;
+	while (!q.empty()) {
+		q.pop();
+	}
+	q.compact();
+	q.compact();
+	std::cout << q.capacity() << " " << q.size() << std::endl;
+	q.push(5);
+	q.compact();
+	std::cout << q.top() << " " << q.capacity() << std::endl;
+}
+
+void TestExceptions()
+{
+	std::cout << "Testing exception safety..." << std::endl;
+	sjtu::priority_queue<Fragile> q;
+	for (int i = 0; i < 500; ++i) {
+		q.push(Fragile(static_cast<int>(rand64() % 1000)));
+	}
+	for (int i = 0; i < 200; ++i) {
+		q.pop();
+	}
+	std::vector<Fragile> before = Drain(q);
+	size_t held = q.capacity();
+	// the move constructor is not noexcept, so compact copies
+	copies_left = 100;
+	try {
+		q.compact();
+		std::cout << "no throw" << std::endl;
+	} catch (const sjtu::runtime_error &) {
+		copies_left = -1;
+		std::cout << (q.capacity() == held) << " " << (Drain(q) == before) << std::endl;
+	}
+	copies_left = -1;
+	q.compact();
+	std::cout << (q.capacity() == q.size()) << " " << (Drain(q) == before) << std::endl;
+}
+
+void TestAutoCompact()
+{
+	std::cout << "Testing automatic compaction..." << std::endl;
+	sjtu::priority_queue<int> manual, automatic;
+	automatic.set_auto_compact(4);
+	// the same operations on both: a large heap first, then a small one
+	unsigned long long saved = seed;
+	Churn(manual, 5000, 50000);
+	Churn(manual, 100, 50000);
+	seed = saved;
+	Churn(automatic, 5000, 50000);
+	Churn(automatic, 100, 50000);
+	std::cout << (Drain(manual) == Drain(automatic)) << " " << (manual.capacity() >= 2500) << " "
+	          << (automatic.capacity() < 200) << std::endl;
+	// the setting goes with copies, constructed or assigned
+	sjtu::priority_queue<int> copied(automatic), assigned;
+	assigned = automatic;
+	Churn(copied, 5000, 50000);
+	Churn(copied, 100, 50000);
+	Churn(assigned, 5000, 50000);
+	Churn(assigned, 100, 50000);
+	std::cout << (copied.capacity() < 1000) << " " << (assigned.capacity() < 1000) << std::endl;
+}
+
+void TestMerge()
+{
+	std::cout << "Testing merge..." << std::endl;
+	sjtu::priority_queue<int> a, b;
+	Churn(a, 300, 3000);
+	Churn(b, 300, 3000);
+	std::vector<int> all = Drain(a);
+	std::vector<int> rest = Drain(b);
+	all.insert(all.end(), rest.begin(), rest.end());
+	size_t held = a.capacity() + b.capacity();
+	a.merge(b);
+	std::cout << b.capacity() << " " << (a.capacity() <= held) << " " << (a.size() == all.size()) << std::endl;
+	// the merged heap lives in both pools, pops and pushes reuse their slots
+	Churn(a, 600, 3000);
+	std::vector<int> merged = Drain(a);
+	a.compact();
+	std::cout << (Drain(a) == merged) << " " << (a.capacity() == a.size()) << std::endl;
+}
+
+// the same churned heap of about n elements popped before and after compaction
+void Benchmark(size_t n)
+{
+	const size_t pops = n / 4;
+	sjtu::priority_queue<int> q;
+	Churn(q, n, 8 * n);
+	sjtu::priority_queue<int> scattered;
+	unsigned long long saved = seed;
+	seed = 1;
+	Churn(scattered, n, 8 * n);
+	seed = 1;
+	sjtu::priority_queue<int> compacted;
+	Churn(compacted, n, 8 * n);
+	seed = saved;
+	compacted.compact();
+	long long sum[2] = {0, 0};
+	double ms[2];
+	sjtu::priority_queue<int> *queues[2] = {&scattered, &compacted};
+	for (int k = 0; k < 2; ++k) {
+		ms[k] = TimeMs([&] {
+			for (size_t i = 0; i < pops; ++i) {
+				sum[k] += queues[k]->top();
+				queues[k]->pop();
+			}
+		});
+	}
+	std::cerr << (sum[0] == sum[1] ? "" : "FAIL ") << pops << " pops from " << scattered.size() + pops << " elements (ms): after churn " << ms[0]
+	          << ", after compact " << ms[1] << std::endl;
+}
+
+int main(int argc, char const *argv[])
+{
+	seed = 2236067977499789ULL;
+	TestCompact();
+	TestExceptions();
+	TestAutoCompact();
+	TestMerge();
+	// timings only on request, e.g. compact 1048576
+	if (argc > 1) {
+		Benchmark(std::strtoul(argv[1], nullptr, 10));
+	}
+	return 0;
+}
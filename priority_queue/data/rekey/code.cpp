@@ -0,0 +1,248 @@
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <vector>
+#include "priority_queue.hpp"
+#include "test-utility.hpp"
+
+template <typename T, typename C>
+std::vector<T> Drain(sjtu::priority_queue<T, C> q)
+{
+	std::vector<T> out;
+	while (!q.empty()) {
+		out.push_back(q.top());
+		q.pop();
+	}
+	return out;
+}
+
+// pushes and pops at random so the heap is not just a fresh build
+void Fill(sjtu::priority_queue<int> &q, std::vector<int> &values, size_t n)
+{
+	while (q.size() < n) {
+		q.push(static_cast<int>(rand64() % 1000000007));
+		if (rand64() % 4 == 0) {
+			q.pop();
+		}
+	}
+	values = Drain(q);
+}
+
+std::vector<int> Descending(std::vector<int> values)
+{
+	std::sort(values.begin(), values.end(), std::greater<int>());
+	return values;
+}
+
+// compares throw once armed and the countdown runs out
+int compares_left = -1;
+
+struct Counted {
+	int value;
+	Counted(int v) : value(v) {}
+};
+
+struct FaultyLess {
+	bool operator()(const Counted &a, const Counted &b) const
+	{
+		if (compares_left == 0) {
+			throw sjtu::runtime_error();
+		}
+		if (compares_left > 0) {
+			--compares_left;
+		}
+		return a.value < b.value;
+	}
+};
+
+std::vector<int> Values(sjtu::priority_queue<Counted, FaultyLess> q)
+{
+	std::vector<int> out;
+	while (!q.empty()) {
+		out.push_back(q.top().value);
+		q.pop();
+	}
+	return out;
+}
+
+void TestRekey()
+{
+	std::cout << "Testing rekey_all..." << std::endl;
+	sjtu::priority_queue<int> q;
+	q.rekey_all([](int &x) { x = -x; });
+	std::cout << q.empty() << std::endl;
+	std::vector<int> values;
+	Fill(q, values, 100000);
+	for (int &x : values) {
+		x = static_cast<int>((x * 7LL + 3) % 1000003);
+	}
+	q.rekey_all([](int &x) { x = static_cast<int>((x * 7LL + 3) % 1000003); });
+	std::cout << q.size() << " " << (q.capacity() == q.size()) << " " << (Drain(q) == Descending(values)) << std::endl;
+	// reversing the order is the worst case for the old shape
+	q.rekey_all([](int &x) { x = -x; });
+	for (int &x : values) {
+		x = -x;
+	}
+	std::cout << (Drain(q) == Descending(values)) << std::endl;
+	// popping right after each push takes the largest of them all
+	for (int i = 0; i < 1000; ++i) {
+		q.push(i * 1000);
+		values.push_back(i * 1000);
+		q.pop();
+	}
+	values = Descending(values);
+	values.erase(values.begin(), values.begin() + 1000);
+	std::cout << (Drain(q) == values) << std::endl;
+	sjtu::priority_queue<int> one;
+	one.push(5);
+	one.rekey_all([](int &x) { x *= 3; });
+	std::cout << one.size() << " " << one.top() << std::endl;
+}
+
+void TestEraseIf()
+{
+	std::cout << "Testing erase_if..." << std::endl;
+	sjtu::priority_queue<int> q;
+	std::cout << q.erase_if([](int) { return true; }) << std::endl;
+	std::vector<int> values;
+	Fill(q, values, 100000);
+	auto third = [](int x) { return x % 3 == 0; };
+	size_t expected = static_cast<size_t>(std::count_if(values.begin(), values.end(), third));
+	values.erase(std::remove_if(values.begin(), values.end(), third), values.end());
+	std::cout << (q.erase_if(third) == expected) << " " << (q.size() == values.size()) << " "
+	          << (Drain(q) == values) << std::endl;
+	std::cout << q.erase_if(third) << std::endl;
+	// only the top goes, only the top stays
+	int top = q.top();
+	std::cout << q.erase_if([top](int x) { return x == top; }) << " " << (q.top() == values[1]) << std::endl;
+	int last = values.back();
+	std::cout << (q.erase_if([last](int x) { return x != last; }) == values.size() - 2) << " " << q.size() << " "
+	          << (q.top() == last) << std::endl;
+	std::cout << q.erase_if([](int) { return true; }) << " " << q.empty() << std::endl;
+	// the freed nodes are used again
+	Fill(q, values, 50000);
+	size_t held = q.capacity();
+	q.erase_if([](int x) { return x % 2 == 0; });
+	for (size_t i = 0; i < 10000; ++i) {
+		q.push(static_cast<int>(rand64() % 1000));
+	}
+	std::cout << (q.capacity() == held) << std::endl;
+}
+
+void TestExceptions()
+{
+	std::cout << "Testing exceptions..." << std::endl;
+	sjtu::priority_queue<Counted, FaultyLess> q;
+	for (int i = 0; i < 20000; ++i) {
+		q.push(Counted(static_cast<int>(rand64() % 100000)));
+	}
+	std::vector<int> before = Values(q);
+	int thrown = 0;
+	for (int after : {0, 1, 100, 5000}) {
+		compares_left = after;
+		try {
+			q.rekey_all([](Counted &c) { c.value = 100000 - c.value; });
+		} catch (const sjtu::runtime_error &) {
+			++thrown;
+		}
+		compares_left = -1;
+		std::cout << (Values(q) == before) << " ";
+		compares_left = after;
+		try {
+			q.erase_if([](const Counted &c) { return c.value % 5 == 0; });
+		} catch (const sjtu::runtime_error &) {
+			++thrown;
+		}
+		compares_left = -1;
+		std::cout << (Values(q) == before) << " ";
+	}
+	std::cout << thrown << std::endl;
+	// fn and pred throwing part way through
+	int calls = 0;
+	try {
+		q.rekey_all([&calls](Counted &c) {
+			if (++calls == 1000) {
+				throw sjtu::runtime_error();
+			}
+			c.value = -c.value;
+		});
+	} catch (const sjtu::runtime_error &) {
+		++thrown;
+	}
+	calls = 0;
+	try {
+		q.erase_if([&calls](const Counted &c) {
+			if (++calls == 1000) {
+				throw sjtu::runtime_error();
+			}
+			return c.value % 2 == 0;
+		});
+	} catch (const sjtu::runtime_error &) {
+		++thrown;
+	}
+	std::cout << thrown << " " << (Values(q) == before) << std::endl;
+	// and the queue still works
+	q.erase_if([](const Counted &c) { return c.value % 2 == 0; });
+	q.rekey_all([](Counted &c) { c.value = -c.value; });
+	std::vector<int> after;
+	for (int x : before) {
+		if (x % 2 != 0) {
+			after.push_back(-x);
+		}
+	}
+	std::reverse(after.begin(), after.end());
+	std::cout << (Values(q) == after) << std::endl;
+}
+
+// rekey_all and erase_if against popping everything and pushing it back
+void Benchmark(size_t n)
+{
+	sjtu::priority_queue<int> q;
+	std::vector<int> values;
+	Fill(q, values, n);
+	sjtu::priority_queue<int> other(q);
+	auto rekey = [](int &x) { x = static_cast<int>((x * 7LL + 3) % 1000000007); };
+	auto keep = [](int x) { return x % 4 == 0; };
+	double ms[4];
+	std::vector<int> out;
+	ms[0] = TimeMs([&] {
+		while (!other.empty()) {
+			out.push_back(other.top());
+			other.pop();
+		}
+		for (int x : out) {
+			rekey(x);
+			other.push(x);
+		}
+	});
+	ms[1] = TimeMs([&] { q.rekey_all(rekey); });
+	ms[2] = TimeMs([&] {
+		out.clear();
+		while (!other.empty()) {
+			out.push_back(other.top());
+			other.pop();
+		}
+		for (int x : out) {
+			if (!keep(x)) {
+				other.push(x);
+			}
+		}
+	});
+	ms[3] = TimeMs([&] { q.erase_if(keep); });
+	std::cerr << (Drain(q) == Drain(other) ? "" : "FAIL ") << n << " elements (ms): rekey by pop and push " << ms[0] << ", rekey_all " << ms[1]
+	          << "; filter by pop and push " << ms[2] << ", erase_if " << ms[3] << std::endl;
+}
+
+int main(int argc, char const *argv[])
+{
+	seed = 1414213562373095ULL;
+	TestRekey();
+	TestEraseIf();
+	TestExceptions();
+	// timings only on request, e.g. rekey 1048576
+	if (argc > 1) {
+		Benchmark(std::strtoul(argv[1], nullptr, 10));
+	}
+	return 0;
+}
@@ -3,6 +3,10 @@
 
 #include <cstddef>
 #include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include "exceptions.hpp"
 
 namespace sjtu {
@@ -19,9 +23,37 @@ private:
         struct heapnode *ls;
         struct heapnode *rs;
         heapnode(const T &v) : val(v), ls(nullptr), rs(nullptr) {};
+        heapnode(T &&v) : val(std::move(v)), ls(nullptr), rs(nullptr) {};
+    };
+    /*
+     * nodes live in slabs the queue allocates itself: a slab is an array
+     * of slots whose first one holds the slab's size and the link to the
+     * next slab, a popped node's slot goes to a free list the next push
+     * takes it from. slabs start at kFirstSlab nodes and double up to
+     * kMaxSlab.
+     */
+    static constexpr size_t kFirstSlab = 16;
+    static constexpr size_t kMaxSlab = 4096;
+    union nodeslot;
+    struct slabheader {
+        nodeslot *next;
+        size_t count;
+    };
+    union nodeslot {
+        nodeslot *nextfree;
+        slabheader header;
+        alignas(heapnode) unsigned char node[sizeof(heapnode)];
     };
     heapnode *root_;
     size_t size_;
+    nodeslot *slabs_, *lastslab_;
+    nodeslot *free_, *lastfree_;
+    nodeslot *bump_, *bumpend_;
+    size_t capacity_;
+    size_t nextslab_;
+    // pushes and pops since the last compaction, and the trigger for an automatic one
+    size_t churn_;
+    size_t autocompact_;
     heapnode *merge(heapnode *x, heapnode *y) {
         if (!x) return y;
         if (!y) return x;
@@ -39,17 +71,143 @@ private:
             throw runtime_error();
         }
     }
-    void clear(heapnode *x) {
-        if (!x) return;
-        clear(x->ls), clear(x->rs);
-        delete x;
+    void initpool() {
+        slabs_ = lastslab_ = nullptr;
+        free_ = lastfree_ = nullptr;
+        bump_ = bumpend_ = nullptr;
+        capacity_ = 0;
+        nextslab_ = kFirstSlab;
+    }
+    // makes the count slots after block's header the current slab, the first used of them taken
+    void addslab(nodeslot *block, size_t count, size_t used) {
+        block->header.next = nullptr;
+        block->header.count = count + 1;
+        if (lastslab_) {
+            lastslab_->header.next = block;
+        } else {
+            slabs_ = block;
+        }
+        lastslab_ = block;
+        bump_ = block + 1 + used;
+        bumpend_ = block + 1 + count;
+        capacity_ += count;
+    }
+    void releaseslabs() {
+        std::allocator<nodeslot> alloc;
+        while (slabs_) {
+            nodeslot *next = slabs_->header.next;
+            alloc.deallocate(slabs_, slabs_->header.count);
+            slabs_ = next;
+        }
+        initpool();
+    }
+    heapnode *newnode(const T &v) {
+        nodeslot *slot;
+        if (free_) {
+            slot = free_;
+            free_ = slot->nextfree;
+        } else {
+            if (bump_ == bumpend_) {
+                addslab(std::allocator<nodeslot>().allocate(nextslab_ + 1), nextslab_, 0);
+                nextslab_ = nextslab_ * 2 < kMaxSlab ? nextslab_ * 2 : kMaxSlab;
+            }
+            slot = bump_++;
+        }
+        try {
+            return ::new (static_cast<void *>(slot->node)) heapnode(v);
+        } catch (...) {
+            freeslot(slot);
+            throw;
+        }
     }
-    heapnode *clonenode(heapnode *other) {
-        if (!other) return nullptr;
-        heapnode *rt = new heapnode(other->val);
-        rt->ls = clonenode(other->ls);
-        rt->rs = clonenode(other->rs);
-        return rt;
+    void freeslot(nodeslot *slot) {
+        slot->nextfree = free_;
+        if (!free_) lastfree_ = slot;
+        free_ = slot;
+    }
+    void deletenode(heapnode *x) {
+        x->~heapnode();
+        freeslot(reinterpret_cast<nodeslot *>(x));
+    }
+    /*
+     * destroys the values of the heap at x, without recursion or memory:
+     * right rotations turn the tree into a chain through rs on the way.
+     */
+    static void destroyvalues(heapnode *x) {
+        if (std::is_trivially_destructible<T>::value) return;
+        while (x) {
+            if (x->ls) {
+                heapnode *l = x->ls;
+                x->ls = l->rs;
+                l->rs = x;
+                x = l;
+            } else {
+                heapnode *next = x->rs;
+                x->~heapnode();
+                x = next;
+            }
+        }
+    }
+    /*
+     * builds a copy of the n nodes of the heap at root in one new slab of
+     * exactly n nodes, with the values moved instead when Move is set,
+     * and returns its root. the nodes are laid out depth first with the
+     * right child right after its parent: merge walks down the right
+     * children, so its path runs through adjacent nodes.
+     * if a copy throws, all that was built is destroyed and freed again.
+     */
+    template <bool Move>
+    heapnode *layout(heapnode *root, size_t n, nodeslot *&block) {
+        struct pending {
+            heapnode *from;
+            heapnode **link;
+        };
+        std::allocator<nodeslot> alloc;
+        std::allocator<pending> stackalloc;
+        block = alloc.allocate(n + 1);
+        pending *stack;
+        try {
+            stack = stackalloc.allocate(n);
+        } catch (...) {
+            alloc.deallocate(block, n + 1);
+            throw;
+        }
+        heapnode *result = nullptr;
+        size_t built = 0, depth = 0;
+        stack[depth++] = pending{root, &result};
+        try {
+            while (depth) {
+                pending p = stack[--depth];
+                heapnode *x;
+                if constexpr (Move) {
+                    x = ::new (static_cast<void *>(block[built + 1].node)) heapnode(std::move(p.from->val));
+                } else {
+                    x = ::new (static_cast<void *>(block[built + 1].node)) heapnode(p.from->val);
+                }
+                ++built;
+                *p.link = x;
+                if (p.from->ls) stack[depth++] = pending{p.from->ls, &x->ls};
+                if (p.from->rs) stack[depth++] = pending{p.from->rs, &x->rs};
+            }
+        } catch (...) {
+            for (size_t i = 1; i <= built; ++i) {
+                reinterpret_cast<heapnode *>(block[i].node)->~heapnode();
+            }
+            stackalloc.deallocate(stack, n);
+            alloc.deallocate(block, n + 1);
+            throw;
+        }
+        stackalloc.deallocate(stack, n);
+        return result;
+    }
+    void maybecompact() {
+        if (autocompact_ == 0 || size_ == 0 || churn_ / autocompact_ < size_) return;
+        try {
+            compact();
+        } catch (...) {
+            // out of memory: the heap is unchanged, try again after as many operations
+            churn_ = 0;
+        }
     }
 public:
     /**
@@ -58,6 +216,8 @@ public:
     priority_queue() {
         size_ = 0;
         root_ = nullptr;
+        initpool();
+        churn_ = autocompact_ = 0;
     }
 
     /**
@@ -65,15 +225,25 @@ public:
      * @param other the priority_queue to be copied
      */
     priority_queue(const priority_queue &other) {
-        root_ = clonenode(other.root_);
-        size_ = other.size_;
+        size_ = 0;
+        root_ = nullptr;
+        initpool();
+        churn_ = 0;
+        autocompact_ = other.autocompact_;
+        if (other.size_) {
+            nodeslot *block;
+            root_ = layout<false>(other.root_, other.size_, block);
+            addslab(block, other.size_, other.size_);
+            size_ = other.size_;
+        }
     }
 
     /**
      * @brief deconstructor
      */
     ~priority_queue() {
-        clear(root_);
+        destroyvalues(root_);
+        releaseslabs();
     }
 
     /**
@@ -85,9 +255,16 @@ public:
         if (this == &other) {
             return *this;
         }
-        clear(root_);
-        root_ = clonenode(other.root_);
+        // the copy is built first, so a throwing copy leaves this one as it was
+        nodeslot *block = nullptr;
+        heapnode *root = other.size_ ? layout<false>(other.root_, other.size_, block) : nullptr;
+        destroyvalues(root_);
+        releaseslabs();
+        if (block) addslab(block, other.size_, other.size_);
+        root_ = root;
         size_ = other.size_;
+        churn_ = 0;
+        autocompact_ = other.autocompact_;
         return *this;
     }
 
@@ -108,14 +285,16 @@ public:
      * @param e the element to be pushed
      */
     void push(const T &e) {
-        heapnode *newnode = new heapnode(e);
+        heapnode *node = newnode(e);
         try {
-            root_ = merge(root_, newnode);
+            root_ = merge(root_, node);
             ++size_;
         } catch(...) {
-            delete newnode;
+            deletenode(node);
             throw ;
         }
+        ++churn_;
+        maybecompact();
     }
 
     /**
@@ -128,8 +307,10 @@ public:
         }
         heapnode *tmp = root_;
         root_ = merge(root_->ls, root_->rs);
-        delete tmp;
+        deletenode(tmp);
         --size_;
+        ++churn_;
+        maybecompact();
     }
 
     /**
@@ -166,6 +347,242 @@ public:
         } catch (...) {
             throw ;
         }
+        adoptpool(other);
+    }
+
+    /**
+     * @brief move all elements into one contiguous block of memory and
+     * release the rest of the memory held for them.
+     * After long runs of pushes and pops the nodes are spread over all
+     * the memory the queue ever held, in no particular order, and every
+     * pop walks cold memory. compact() lays them out again in the order
+     * merge walks them. The complexity is O(n), the elements are moved
+     * if their move constructor is noexcept and copied otherwise.
+     * If a copy or the allocation throws, the queue is unchanged.
+     */
+    void compact() {
+        churn_ = 0;
+        if (size_ == 0) {
+            releaseslabs();
+            return;
+        }
+        nodeslot *block;
+        heapnode *root = layout<std::is_nothrow_move_constructible<T>::value>(root_, size_, block);
+        destroyvalues(root_);
+        releaseslabs();
+        addslab(block, size_, size_);
+        root_ = root;
+    }
+
+    /**
+     * @brief compact automatically whenever the pushes and pops since the
+     * last compaction reach factor times the size, or never if factor is
+     * 0, the default. Each compaction is O(n), which adds O(1 / factor)
+     * to every push and pop.
+     */
+    void set_auto_compact(size_t factor) {
+        autocompact_ = factor;
+    }
+
+    /**
+     * @brief the number of elements the memory held by the queue has room
+     * for, size() of them in use.
+     */
+    size_t capacity() const {
+        return capacity_;
+    }
+
+    /**
+     * @brief call fn on every element, which may change its priority in
+     * any way, then restore the heap order.
+     * The changed elements are copies laid out in one new block, which
+     * replaces the old nodes once the heap is rebuilt, so the queue ends
+     * up compacted too. The complexity is O(n).
+     * If fn, a copy or the `Compare` throws, the queue is unchanged.
+     * @param fn called as fn(T &) once for every element
+     */
+    template <class Fn>
+    void rekey_all(Fn fn) {
+        if (size_ == 0) return;
+        std::allocator<heapnode *> listalloc;
+        std::allocator<nodeslot> alloc;
+        heapnode **nodes = listalloc.allocate(size_);
+        nodeslot *block;
+        try {
+            block = alloc.allocate(size_ + 1);
+        } catch (...) {
+            listalloc.deallocate(nodes, size_);
+            throw;
+        }
+        size_t built = 0;
+        try {
+            collect(nodes);
+            while (built < size_) {
+                heapnode *x = ::new (static_cast<void *>(block[built + 1].node)) heapnode(nodes[built]->val);
+                nodes[built++] = x;
+                fn(x->val);
+            }
+            heapnode *root = meldall(nodes, size_);
+            destroyvalues(root_);
+            releaseslabs();
+            addslab(block, size_, size_);
+            root_ = root;
+            churn_ = 0;
+        } catch (...) {
+            for (size_t i = 0; i < built; ++i) {
+                reinterpret_cast<heapnode *>(block[i + 1].node)->~heapnode();
+            }
+            alloc.deallocate(block, size_ + 1);
+            listalloc.deallocate(nodes, size_);
+            throw;
+        }
+        listalloc.deallocate(nodes, size_);
+    }
+
+    /**
+     * @brief remove every element pred returns true for.
+     * The subtrees left over when the matching nodes are cut out are
+     * melded together again pairwise, which is O(n) in all.
+     * If pred or the `Compare` throws, the queue is unchanged.
+     * @param pred called as pred(const T &) once for every element
+     * @return the number of elements removed
+     */
+    template <class Pred>
+    size_t erase_if(Pred pred) {
+        if (size_ == 0) return 0;
+        const size_t n = size_;
+        // every node with its links as they were, children after parents
+        struct entry {
+            heapnode *node;
+            heapnode *ls, *rs;
+            size_t lsat, rsat;
+            bool erase;
+        };
+        std::allocator<entry> entryalloc;
+        std::allocator<heapnode *> listalloc;
+        entry *entries = entryalloc.allocate(n);
+        heapnode **roots;
+        try {
+            roots = listalloc.allocate(n);
+        } catch (...) {
+            entryalloc.deallocate(entries, n);
+            throw;
+        }
+        size_t count = 0, erased = 0;
+        entries[count++] = entry{root_, root_->ls, root_->rs, 0, 0, false};
+        for (size_t i = 0; i < count; ++i) {
+            entry &e = entries[i];
+            if (e.ls) {
+                e.lsat = count;
+                entries[count++] = entry{e.ls, e.ls->ls, e.ls->rs, 0, 0, false};
+            }
+            if (e.rs) {
+                e.rsat = count;
+                entries[count++] = entry{e.rs, e.rs->ls, e.rs->rs, 0, 0, false};
+            }
+        }
+        try {
+            for (size_t i = 0; i < count; ++i) {
+                entries[i].erase = pred(static_cast<const T &>(entries[i].node->val));
+                erased += entries[i].erase;
+            }
+        } catch (...) {
+            listalloc.deallocate(roots, n);
+            entryalloc.deallocate(entries, n);
+            throw;
+        }
+        if (erased == 0) {
+            listalloc.deallocate(roots, n);
+            entryalloc.deallocate(entries, n);
+            return 0;
+        }
+        // a kept node whose parent goes is the root of a kept subtree,
+        // a kept node loses the children that go
+        size_t pieces = 0;
+        if (!entries[0].erase) roots[pieces++] = root_;
+        for (size_t i = 0; i < count; ++i) {
+            entry &e = entries[i];
+            if (e.ls && entries[e.lsat].erase != e.erase) {
+                if (e.erase) {
+                    roots[pieces++] = e.ls;
+                } else {
+                    e.node->ls = nullptr;
+                }
+            }
+            if (e.rs && entries[e.rsat].erase != e.erase) {
+                if (e.erase) {
+                    roots[pieces++] = e.rs;
+                } else {
+                    e.node->rs = nullptr;
+                }
+            }
+        }
+        heapnode *root;
+        try {
+            root = meldall(roots, pieces);
+        } catch (...) {
+            for (size_t i = 0; i < count; ++i) {
+                entries[i].node->ls = entries[i].ls;
+                entries[i].node->rs = entries[i].rs;
+            }
+            listalloc.deallocate(roots, n);
+            entryalloc.deallocate(entries, n);
+            throw;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            if (entries[i].erase) deletenode(entries[i].node);
+        }
+        root_ = root;
+        size_ -= erased;
+        listalloc.deallocate(roots, n);
+        entryalloc.deallocate(entries, n);
+        return erased;
+    }
+
+private:
+    // the nodes of the heap into nodes, parents before children
+    void collect(heapnode **nodes) const {
+        size_t count = 0;
+        nodes[count++] = root_;
+        for (size_t i = 0; i < count; ++i) {
+            if (nodes[i]->ls) nodes[count++] = nodes[i]->ls;
+            if (nodes[i]->rs) nodes[count++] = nodes[i]->rs;
+        }
+    }
+    /*
+     * melds the k heaps at roots into one, in rounds that meld them in
+     * pairs. the heaps double in size while their number halves, so from
+     * k single nodes this is O(k) amortized work in all.
+     */
+    heapnode *meldall(heapnode **roots, size_t k) {
+        while (k > 1) {
+            size_t out = 0;
+            for (size_t i = 0; i + 1 < k; i += 2) {
+                roots[out++] = merge(roots[i], roots[i + 1]);
+            }
+            if (k % 2) roots[out++] = roots[k - 1];
+            k = out;
+        }
+        return k ? roots[0] : nullptr;
+    }
+    // takes over the slabs and free slots of other, whose nodes are now in this heap
+    void adoptpool(priority_queue &other) {
+        if (other.slabs_) {
+            if (lastslab_) {
+                lastslab_->header.next = other.slabs_;
+            } else {
+                slabs_ = other.slabs_;
+            }
+            lastslab_ = other.lastslab_;
+            // the rest of other's current slab is not used until the next compaction
+            capacity_ += other.capacity_ - static_cast<size_t>(other.bumpend_ - other.bump_);
+        }
+        if (other.free_) {
+            other.lastfree_->nextfree = free_;
+            if (!free_) lastfree_ = other.lastfree_;
+            free_ = other.free_;
+        }
+        other.initpool();
     }
 };
 
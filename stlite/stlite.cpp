@@ -0,0 +1,3 @@
+// the one translation unit that instantiates what stlite.hpp declares
+#define SJTU_STLITE_INSTANTIATE
+#include "stlite.hpp"
@@ -0,0 +1,34 @@
+#ifndef SJTU_STLITE_HPP
+#define SJTU_STLITE_HPP
+
+#include "class-bint.hpp"
+#include "priority_queue.hpp"
+#include "vector.hpp"
+
+/**
+ * priority_queue of the common element types is compiled once into the
+ * stlite library: a translation unit including this header uses those
+ * copies instead of instantiating and compiling them again, and links
+ * against stlite.
+ * vector is not listed: its members are all constexpr, hence inline, and
+ * an extern template does not keep them from being instantiated where
+ * they are used, so at -O2 it saved nothing.
+ */
+#ifdef SJTU_STLITE_INSTANTIATE
+#define SJTU_STLITE_TEMPLATE template
+#else
+#define SJTU_STLITE_TEMPLATE extern template
+#endif
+
+namespace sjtu {
+
+SJTU_STLITE_TEMPLATE class priority_queue<int>;
+SJTU_STLITE_TEMPLATE class priority_queue<long long>;
+SJTU_STLITE_TEMPLATE class priority_queue<double>;
+SJTU_STLITE_TEMPLATE class priority_queue<Util::Bint>;
+
+}  // namespace sjtu
+
+#undef SJTU_STLITE_TEMPLATE
+
+#endif
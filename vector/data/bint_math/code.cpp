@@ -0,0 +1,169 @@
+#include "class-bint.hpp"
+#include "vector.hpp"
+#include "test-utility.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+std::string RandomDigits(size_t n)
+{
+	std::string s(1, static_cast<char>('1' + rand64() % 9));
+	while (s.size() < n) {
+		s += static_cast<char>('0' + rand64() % 10);
+	}
+	return s;
+}
+
+std::string ToString(const Util::Bint &b)
+{
+	std::ostringstream os;
+	os << b;
+	return os.str();
+}
+
+// the digit count and the last digits of a number too long to print
+std::string Digest(const Util::Bint &b)
+{
+	std::string s = ToString(b);
+	return std::to_string(s.size()) + ":" + s.substr(s.size() > 12 ? s.size() - 12 : 0);
+}
+
+void TestSmall()
+{
+	std::cout << "Testing small numbers..." << std::endl;
+	std::cout << gcd(Util::Bint(12), Util::Bint(18)) << " " << gcd(Util::Bint(0), Util::Bint(-7)) << " "
+	          << gcd(Util::Bint(0), Util::Bint(0)) << " " << gcd(Util::Bint(-1071), Util::Bint(462)) << std::endl;
+	const int pairs[][2] = {{240, 46}, {46, 240}, {-240, 46}, {240, -46}, {0, 5}, {5, 0}, {7, 7}, {1, 1}};
+	for (const auto &p : pairs) {
+		Util::Bint x, y;
+		Util::Bint g = extended_gcd(Util::Bint(p[0]), Util::Bint(p[1]), x, y);
+		std::cout << g << " " << x << " " << y << " ";
+	}
+	std::cout << std::endl;
+	std::cout << inverse_mod(Util::Bint(3), Util::Bint(11)) << " " << inverse_mod(Util::Bint(-3), Util::Bint(11)) << " "
+	          << inverse_mod(Util::Bint(10), Util::Bint(1)) << " " << inverse_mod(Util::Bint(123456789), Util::Bint(1000000007))
+	          << std::endl;
+	const int bad[][2] = {{2, 4}, {3, 0}, {3, -11}};
+	for (const auto &p : bad) {
+		try {
+			inverse_mod(Util::Bint(p[0]), Util::Bint(p[1]));
+			std::cout << "no throw ";
+		} catch (const std::domain_error &) {
+			std::cout << "domain_error ";
+		}
+	}
+	try {
+		isqrt(Util::Bint(-4));
+	} catch (const std::domain_error &) {
+		std::cout << "domain_error ";
+	}
+	try {
+		iroot(Util::Bint(8), 0);
+	} catch (const std::domain_error &) {
+		std::cout << "domain_error";
+	}
+	std::cout << std::endl;
+	std::cout << isqrt(Util::Bint(0)) << " " << isqrt(Util::Bint(1)) << " " << isqrt(Util::Bint(99)) << " "
+	          << isqrt(Util::Bint(100)) << " " << iroot(Util::Bint(std::string("1000000000000000000000000000000")), 3) << " "
+	          << iroot(Util::Bint(std::string("999999999999999999999999999999")), 3) << " " << iroot(Util::Bint(12345), 1)
+	          << " " << iroot(Util::Bint(std::string("18446744073709551616")), 64) << std::endl;
+	int squares = 0;
+	for (int i = -10; i < 100000; ++i) {
+		squares += is_perfect_square(Util::Bint(i));
+	}
+	std::cout << squares << std::endl;
+}
+
+void TestRandom()
+{
+	std::cout << "Testing random numbers..." << std::endl;
+	int ok = 0;
+	for (int i = 0; i < 300; ++i) {
+		Util::Bint x(RandomDigits(1 + rand64() % 80)), y(RandomDigits(1 + rand64() % 80)), z(RandomDigits(1 + rand64() % 80));
+		Util::Bint xx = x * x;
+		ok += isqrt(xx) == x;
+		ok += is_perfect_square(xx);
+		// x^2 * 10 lies strictly between two squares
+		ok += !is_perfect_square(xx * Util::Bint(10));
+		ok += iroot(xx * x, 3) == x;
+		ok += iroot(xx * xx * x, 5) == x;
+		ok += gcd(x * y, x * z) == x * gcd(y, z);
+		Util::Bint u, v;
+		ok += extended_gcd(x * y, x * z, u, v) == x * gcd(y, z);
+	}
+	std::cout << ok << std::endl;
+	// cofactors and inverses of numbers past a few machine words
+	for (int i = 0; i < 4; ++i) {
+		Util::Bint a(RandomDigits(40 + i * 15)), b(RandomDigits(30 + i * 15)), x, y;
+		Util::Bint g = extended_gcd(a, b, x, y);
+		std::cout << a << " " << b << " " << g << " " << x << " " << y << std::endl;
+	}
+	Util::Bint p(std::string("170141183460469231731687303715884105727"));
+	Util::Bint a(RandomDigits(60));
+	std::cout << a << " " << inverse_mod(a, p) << " " << isqrt(a) << " " << iroot(a, 7) << std::endl;
+}
+
+// gcds, square roots and square tests of numbers with about digits digits,
+// as a line of digests, with the time of each step appended to timings
+std::string RunLarge(size_t digits, std::string &timings)
+{
+	Util::Bint common(RandomDigits(200));
+	Util::Bint a = Util::Bint(RandomDigits(digits)) * common;
+	Util::Bint b = Util::Bint(RandomDigits(digits - 50)) * common;
+	Util::Bint g, x, y, s;
+	bool same = false, exact = false;
+	int filtered = 0;
+	double gcd_ms = TimeMs([&] { g = gcd(a, b); });
+	double ext_ms = TimeMs([&] { same = extended_gcd(a, b, x, y) == g; });
+	double sqrt_ms = TimeMs([&] { s = isqrt(a); });
+	Util::Bint root(RandomDigits(digits / 2));
+	Util::Bint square = root * root;
+	double square_ms = TimeMs([&] { exact = is_perfect_square(square) && isqrt(square) == root; });
+	sjtu::vector<Util::Bint> multiples;
+	for (int i = 1; i <= 100; ++i) {
+		multiples.push_back(square * Util::Bint(i));
+	}
+	double filter_ms = TimeMs([&] {
+		for (const Util::Bint &m : multiples) {
+			// all but the square multiples fail the residue filters without a root
+			filtered += is_perfect_square(m);
+		}
+	});
+	timings = "gcd " + std::to_string(gcd_ms) + ", extended gcd " + std::to_string(ext_ms) + ", isqrt " +
+	          std::to_string(sqrt_ms) + ", is_perfect_square " + std::to_string(square_ms) + ", 100 multiples " +
+	          std::to_string(filter_ms);
+	return std::to_string(digits) + " " + Digest(g) + " " + std::to_string(same) + " " + Digest(x) + " " + Digest(y) +
+	       " " + Digest(s) + " " + std::to_string(exact) + " " + std::to_string(filtered);
+}
+
+void TestLarge()
+{
+	std::cout << "Testing large numbers..." << std::endl;
+	std::string timings;
+	std::cout << RunLarge(1000, timings) << std::endl;
+}
+
+// pass the largest number of digits, e.g. 100000, run from 1000 up by factors of ten
+void Benchmark(size_t max_digits)
+{
+	for (size_t digits = 1000; digits <= max_digits; digits *= 10) {
+		std::string timings;
+		std::string result = RunLarge(digits, timings);
+		std::cerr << result << std::endl << digits << " digits (ms): " << timings << std::endl;
+	}
+}
+
+int main(int argc, char const *argv[])
+{
+	seed = 1414213562373095ULL;
+	TestSmall();
+	TestRandom();
+	TestLarge();
+	if (argc > 1) {
+		Benchmark(std::strtoul(argv[1], nullptr, 10));
+	}
+	return 0;
+}
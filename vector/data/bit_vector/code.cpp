@@ -0,0 +1,174 @@
+#include "bit_vector.hpp"
+#include "test-utility.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+bool Same(const sjtu::bit_vector &a, const std::vector<bool> &b)
+{
+	if (a.size() != b.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < a.size(); ++i) {
+		if (a[i] != b[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void TestBasic()
+{
+	std::cout << "Testing basic operations..." << std::endl;
+	sjtu::bit_vector a;
+	std::vector<bool> b;
+	for (int i = 0; i < 1000; ++i) {
+		bool x = rand64() % 3 == 0;
+		a.push_back(x);
+		b.push_back(x);
+	}
+	for (int i = 0; i < 300; ++i) {
+		a.pop_back();
+		b.pop_back();
+	}
+	for (int i = 0; i < 100; ++i) {
+		size_t pos = rand64() % a.size();
+		a[pos] = !a[pos];
+		b[pos] = !b[pos];
+	}
+	a.resize(777, true);
+	b.resize(777, true);
+	a.resize(1500);
+	b.resize(1500);
+	std::cout << Same(a, b) << " " << a.size() << " " << a.front() << " " << a.back() << std::endl;
+	sjtu::bit_vector c = a;
+	c.flip();
+	c.flip();
+	std::cout << (c == a) << std::endl;
+	try {
+		a.at(1500) = true;
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "OK" << std::endl;
+	}
+}
+
+void TestCountAndFind()
+{
+	std::cout << "Testing count and find..." << std::endl;
+	sjtu::bit_vector a(100000);
+	size_t expected = 0;
+	for (size_t i = 0; i < a.size(); i += 1 + rand64() % 700) {
+		a.set(i);
+		++expected;
+	}
+	size_t found = 0, last = 0;
+	bool ordered = true;
+	for (size_t i = a.find_first(); i != a.size(); i = a.find_next(i)) {
+		if (found && i <= last) {
+			ordered = false;
+		}
+		last = i;
+		++found;
+	}
+	std::cout << (a.count() == expected) << " " << (found == expected) << " " << ordered << std::endl;
+	sjtu::bit_vector empty(130);
+	std::cout << empty.find_first() << " " << empty.count() << std::endl;
+	empty.assign_all(true);
+	std::cout << empty.count() << " " << empty.find_next(128) << " " << empty.find_next(129) << std::endl;
+}
+
+void TestBulk()
+{
+	std::cout << "Testing bulk operations..." << std::endl;
+	const size_t n = 10007;
+	sjtu::bit_vector a(n), b(n);
+	std::vector<bool> x(n), y(n);
+	for (size_t i = 0; i < n; ++i) {
+		x[i] = rand64() & 1;
+		y[i] = rand64() & 1;
+		a.set(i, x[i]);
+		b.set(i, y[i]);
+	}
+	std::vector<bool> r(n);
+	bool ok = true;
+	for (size_t i = 0; i < n; ++i) r[i] = x[i] && y[i];
+	ok = ok && Same(a & b, r);
+	for (size_t i = 0; i < n; ++i) r[i] = x[i] || y[i];
+	ok = ok && Same(a | b, r);
+	for (size_t i = 0; i < n; ++i) r[i] = x[i] != y[i];
+	ok = ok && Same(a ^ b, r);
+	for (size_t i = 0; i < n; ++i) r[i] = x[i] && !y[i];
+	sjtu::bit_vector d = a;
+	ok = ok && Same(d.and_not(b), r);
+	std::cout << ok << std::endl;
+	try {
+		a &= sjtu::bit_vector(n + 1);
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::runtime_error &) {
+		std::cout << "OK" << std::endl;
+	}
+}
+
+void TestRankSelect()
+{
+	std::cout << "Testing rank and select..." << std::endl;
+	sjtu::bit_vector a;
+	for (int i = 0; i < 5000; ++i) {
+		a.push_back(rand64() % 5 == 0);
+	}
+	sjtu::rank_select rs(a);
+	bool ok = true;
+	size_t ones = 0;
+	for (size_t i = 0; i <= a.size(); ++i) {
+		if (rs.rank1(i) != ones) {
+			ok = false;
+		}
+		if (i < a.size() && a[i]) {
+			if (rs.select1(ones) != i) {
+				ok = false;
+			}
+			++ones;
+		}
+	}
+	std::cout << ok << " " << (rs.rank0(a.size()) == a.size() - ones) << std::endl;
+	try {
+		rs.select1(ones);
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "OK" << std::endl;
+	}
+}
+
+// pass the number of bits, e.g. 100000000
+void Benchmark(size_t n)
+{
+	sjtu::bit_vector a(n), b(n);
+	for (size_t i = 0; i < n; i += 3) {
+		a.set(i);
+	}
+	for (size_t i = 0; i < n; i += 5) {
+		b.set(i);
+	}
+	size_t cnt = 0;
+	double ms = TimeMs([&] {
+		a &= b;
+		cnt = a.count();
+	});
+	std::cerr << "AND + count over " << n << " bits (ms): " << ms << ", " << cnt << " bits set, "
+	          << a.word_count() * 8 << " bytes" << std::endl;
+}
+
+int main(int argc, char const *argv[])
+{
+	seed = 3141592653589793ULL;
+	TestBasic();
+	TestCountAndFind();
+	TestBulk();
+	TestRankSelect();
+	if (argc > 1) {
+		Benchmark(std::strtoul(argv[1], nullptr, 10));
+	}
+	return 0;
+}
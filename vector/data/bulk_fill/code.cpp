@@ -0,0 +1,101 @@
+#include "vector.hpp"
+#include "test-utility.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+struct Record {
+	int id;
+	double value;
+};
+
+void TestResize()
+{
+	std::cout << "Testing resize_uninitialized..." << std::endl;
+	sjtu::vector<int> v;
+	v.push_back(7);
+	v.resize_uninitialized(5);
+	for (size_t i = 1; i < v.size(); ++i) {
+		v[i] = i * 11;
+	}
+	for (int x : v) {
+		std::cout << x << " ";
+	}
+	std::cout << v.size() << std::endl;
+	v.resize_uninitialized(2);
+	std::cout << v.size() << " " << v.back() << std::endl;
+}
+
+void TestAppendWith()
+{
+	std::cout << "Testing append_with..." << std::endl;
+	const char *path = "/tmp/sjtu_bulk_fill_records.bin";
+	FILE *out = std::fopen(path, "wb");
+	for (int i = 0; i < 1000; ++i) {
+		Record r{i, i * 0.5};
+		std::fwrite(&r, sizeof(r), 1, out);
+	}
+	std::fclose(out);
+
+	sjtu::vector<Record> records;
+	FILE *in = std::fopen(path, "rb");
+	size_t got;
+	do {
+		got = records.append_with(384, [&](Record *p, size_t n) { return std::fread(p, sizeof(Record), n, in); });
+	} while (got != 0);
+	std::fclose(in);
+	std::remove(path);
+	std::cout << records.size() << " " << records[999].id << " " << records[999].value << std::endl;
+
+	sjtu::vector<int> v;
+	v.push_back(-1);
+	v.append_with(3, [](int *p, size_t n) {
+		for (size_t i = 0; i < n; ++i) {
+			p[i] = i;
+		}
+	});
+	for (int x : v) {
+		std::cout << x << " ";
+	}
+	std::cout << std::endl;
+	try {
+		v.append_with(2, [](int *, size_t n) { return n + 1; });
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::runtime_error &) {
+		std::cout << "OK " << v.size() << std::endl;
+	}
+}
+
+// pass the number of ints to load, e.g. 20000000
+void Benchmark(size_t n)
+{
+	int *source = new int[n];
+	for (size_t i = 0; i < n; ++i) {
+		source[i] = i ^ 0x5a5a;
+	}
+	sjtu::vector<int> a, b;
+	double push_ms = TimeMs([&] {
+		for (size_t i = 0; i < n; ++i) {
+			a.push_back(source[i]);
+		}
+	});
+	double append_ms = TimeMs([&] {
+		b.append_with(n, [&](int *p, size_t k) { std::memcpy(p, source, k * sizeof(int)); });
+	});
+	bool same = a.size() == b.size() && std::memcmp(a.data(), b.data(), n * sizeof(int)) == 0;
+	std::cerr << (same ? "" : "FAIL ") << "load " << n << " ints (ms): push_back " << push_ms << " append_with "
+	          << append_ms << std::endl;
+	delete[] source;
+}
+
+int main(int argc, char const *argv[])
+{
+	TestResize();
+	TestAppendWith();
+	if (argc > 1) {
+		Benchmark(std::strtoul(argv[1], nullptr, 10));
+	}
+	return 0;
+}
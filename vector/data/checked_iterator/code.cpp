@@ -0,0 +1,89 @@
+#define SJTU_CHECKED_ITERATORS 1
+#include "vector.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+template <typename F>
+void ExpectInvalid(const char *what, F f)
+{
+	try {
+		f();
+		std::cout << what << ": FAIL" << std::endl;
+	} catch (sjtu::invalid_iterator &) {
+		std::cout << what << ": OK" << std::endl;
+	}
+}
+
+void TestStale()
+{
+	std::cout << "Testing stale iterators..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 4; ++i) {
+		v.push_back(i);
+	}
+	sjtu::vector<int>::iterator it = v.begin() + 1;
+	std::cout << *it << " " << it[2] << " " << (v.end() - it) << std::endl;
+	v.push_back(4);  // 4 -> 8, reallocates
+	ExpectInvalid("after reallocation", [&] { return *it; });
+	it = v.begin() + 2;
+	v.push_back(5);  // fits, iterators stay valid
+	std::cout << *it << std::endl;
+	v.insert(0, 100);
+	ExpectInvalid("after insert", [&] { return it + 1; });
+	it = v.begin();
+	v.erase(v.begin() + 3);
+	ExpectInvalid("after erase", [&] { ++it; });
+	sjtu::vector<int>::const_iterator cit = v.cbegin();
+	v.clear();
+	ExpectInvalid("after clear", [&] { return *cit; });
+	v.push_back(7);
+	it = v.end();
+	ExpectInvalid("dereferencing end", [&] { return *it; });
+	sjtu::vector<int>::iterator last = v.begin();
+	v.pop_back();
+	ExpectInvalid("element removed by pop_back", [&] { return *last; });
+	v.reserve(100);
+	ExpectInvalid("after reserve", [&] { return last == v.begin(); });
+}
+
+void TestCrossContainer()
+{
+	std::cout << "Testing iterators of two vectors..." << std::endl;
+	sjtu::vector<std::string> a, b;
+	a.push_back("a");
+	b.push_back("b");
+	std::cout << (a.begin() == b.begin() ? "YES" : "NO") << std::endl;
+	ExpectInvalid("distance", [&] { return a.end() - b.begin(); });
+	ExpectInvalid("ordering", [&] { return a.begin() < b.end(); });
+	ExpectInvalid("insert with a foreign iterator", [&] { a.insert(b.begin(), "x"); });
+	ExpectInvalid("default constructed", [&] { return *sjtu::vector<std::string>::iterator(); });
+	sjtu::vector<std::string>::iterator none, other;
+	std::cout << (none == other) << " " << (none != other) << " " << (none < other) << " " << (none - other)
+	          << " " << (none == a.begin()) << std::endl;
+	a.insert(a.end(), "z");
+	a.erase(a.begin());
+	std::cout << a.size() << " " << a.begin()->size() << " " << a[0] << std::endl;
+}
+
+void TestAlgorithms()
+{
+	std::cout << "Testing with std algorithms..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back((i * 7) % 10);
+	}
+	std::sort(v.begin(), v.end());
+	const sjtu::vector<int> &cv = v;
+	std::cout << std::count(cv.begin(), cv.end(), 3) << " " << *std::max_element(cv.begin(), cv.end()) << " "
+	          << (std::lower_bound(v.begin(), v.end(), 6) - v.begin()) << std::endl;
+}
+
+int main()
+{
+	TestStale();
+	TestCrossContainer();
+	TestAlgorithms();
+	return 0;
+}
@@ -0,0 +1,564 @@
+#include "class-bint.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace Util {
+
+namespace {
+
+using sjtu::detail::add_with_carry;
+using sjtu::detail::div_wide;
+using sjtu::detail::mul_add;
+using sjtu::detail::sub_with_borrow;
+
+/*
+ * the algorithms below work on magnitudes in 64-bit limbs, least
+ * significant first and without leading zero limbs (zero is empty). a
+ * Bint is converted into one once, in O(n^2) word operations, which is
+ * repaid many times by every division or Lehmer step that then runs on
+ * five times fewer limbs, each worth 64 bits instead of four digits.
+ * the arithmetic writes into a result the caller passes in, so a loop
+ * that keeps its temporaries allocates only until they are large enough.
+ */
+using Nat = std::vector<unsigned long long>;
+
+void Trim(Nat &a) {
+    while (!a.empty() && a.back() == 0) {
+        a.pop_back();
+    }
+}
+
+int Compare(const Nat &a, const Nat &b) {
+    if (a.size() != b.size()) {
+        return a.size() < b.size() ? -1 : 1;
+    }
+    for (size_t i = a.size(); i-- > 0;) {
+        if (a[i] != b[i]) {
+            return a[i] < b[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+size_t BitLength(const Nat &a) {
+    return a.empty() ? 0 : (a.size() - 1) * 64 + std::bit_width(a.back());
+}
+
+// r = a + b, r is neither a nor b
+void Add(Nat &r, const Nat &a, const Nat &b) {
+    const Nat &l = a.size() >= b.size() ? a : b;
+    const Nat &s = a.size() >= b.size() ? b : a;
+    r.resize(l.size() + 1);
+    unsigned long long carry = 0;
+    for (size_t i = 0; i < l.size(); ++i) {
+        r[i] = add_with_carry(l[i], i < s.size() ? s[i] : 0, carry);
+    }
+    r[l.size()] = carry;
+    Trim(r);
+}
+
+// a -= b, a >= b
+void SubInPlace(Nat &a, const Nat &b) {
+    unsigned long long borrow = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (i >= b.size() && borrow == 0) {
+            break;
+        }
+        a[i] = sub_with_borrow(a[i], i < b.size() ? b[i] : 0, borrow);
+    }
+    Trim(a);
+}
+
+// a = a * m + c
+void MulAddSmall(Nat &a, unsigned long long m, unsigned long long c) {
+    for (unsigned long long &limb : a) {
+        limb = mul_add(limb, m, c, 0, c);
+    }
+    if (c != 0) {
+        a.push_back(c);
+    }
+    Trim(a);
+}
+
+// r = a * b, r is neither a nor b
+void Mul(Nat &r, const Nat &a, const Nat &b) {
+    if (a.empty() || b.empty()) {
+        r.clear();
+        return;
+    }
+    r.assign(a.size() + b.size(), 0);
+    for (size_t i = 0; i < a.size(); ++i) {
+        unsigned long long carry = 0;
+        for (size_t j = 0; j < b.size(); ++j) {
+            r[i + j] = mul_add(a[i], b[j], r[i + j], carry, carry);
+        }
+        r[i + b.size()] = carry;
+    }
+    Trim(r);
+}
+
+// divides a by d in place and returns the remainder
+unsigned long long DivSmall(Nat &a, unsigned long long d) {
+    unsigned long long rem = 0;
+    for (size_t i = a.size(); i-- > 0;) {
+        a[i] = div_wide(rem, a[i], d, rem);
+    }
+    Trim(a);
+    return rem;
+}
+
+Nat ShiftLeft(const Nat &a, size_t s) {
+    if (a.empty()) {
+        return Nat();
+    }
+    size_t limbs = s / 64, bits = s % 64;
+    Nat r(a.size() + limbs + 1);
+    for (size_t i = 0; i < a.size(); ++i) {
+        r[i + limbs] |= a[i] << bits;
+        if (bits != 0) {
+            r[i + limbs + 1] = a[i] >> (64 - bits);
+        }
+    }
+    Trim(r);
+    return r;
+}
+
+Nat ShiftRight(const Nat &a, size_t s) {
+    size_t limbs = s / 64, bits = s % 64;
+    if (limbs >= a.size()) {
+        return Nat();
+    }
+    Nat r(a.size() - limbs);
+    for (size_t i = 0; i < r.size(); ++i) {
+        r[i] = a[i + limbs] >> bits;
+        if (bits != 0 && i + limbs + 1 < a.size()) {
+            r[i] |= a[i + limbs + 1] << (64 - bits);
+        }
+    }
+    Trim(r);
+    return r;
+}
+
+/*
+ * q = u / v and r = u % v for v != 0 (Knuth, TAOCP 4.3.1, algorithm D):
+ * v is shifted until its top bit is set, so the quotient digit estimated
+ * from the top two limbs of the remainder is at most two too large.
+ * either output may be null.
+ */
+void DivMod(const Nat &u, const Nat &v, Nat *q, Nat *r) {
+    if (Compare(u, v) < 0) {
+        if (q != nullptr) {
+            q->clear();
+        }
+        if (r != nullptr) {
+            *r = u;
+        }
+        return;
+    }
+    if (v.size() == 1) {
+        Nat quotient = u;
+        unsigned long long rem = DivSmall(quotient, v[0]);
+        if (q != nullptr) {
+            *q = std::move(quotient);
+        }
+        if (r != nullptr) {
+            r->assign(rem != 0 ? 1 : 0, rem);
+        }
+        return;
+    }
+    size_t n = v.size(), m = u.size() - n;
+    size_t s = std::countl_zero(v.back());
+    Nat vn = ShiftLeft(v, s);
+    Nat un = ShiftLeft(u, s);
+    un.resize(u.size() + 1);
+    Nat quotient(m + 1);
+    for (size_t j = m + 1; j-- > 0;) {
+        unsigned long long qhat;
+        if (un[j + n] >= vn[n - 1]) {
+            qhat = ~0ULL;
+        } else {
+            unsigned long long rhat;
+            qhat = div_wide(un[j + n], un[j + n - 1], vn[n - 1], rhat);
+            // qhat * vn[n - 2] > rhat * 2^64 + un[j + n - 2] means qhat is too large
+            while (true) {
+                unsigned long long hi;
+                unsigned long long lo = mul_add(qhat, vn[n - 2], 0, 0, hi);
+                if (hi < rhat || (hi == rhat && lo <= un[j + n - 2])) {
+                    break;
+                }
+                --qhat;
+                unsigned long long before = rhat;
+                rhat += vn[n - 1];
+                if (rhat < before) {
+                    break;
+                }
+            }
+        }
+        unsigned long long carry = 0, borrow = 0;
+        for (size_t i = 0; i < n; ++i) {
+            unsigned long long p = mul_add(qhat, vn[i], carry, 0, carry);
+            un[i + j] = sub_with_borrow(un[i + j], p, borrow);
+        }
+        un[j + n] = sub_with_borrow(un[j + n], carry, borrow);
+        if (borrow != 0) {
+            // the remainder went negative: add v back until it wraps around
+            unsigned long long c;
+            do {
+                --qhat;
+                c = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    un[i + j] = add_with_carry(un[i + j], vn[i], c);
+                }
+                un[j + n] = add_with_carry(un[j + n], 0, c);
+            } while (c == 0);
+        }
+        quotient[j] = qhat;
+    }
+    if (q != nullptr) {
+        Trim(quotient);
+        *q = std::move(quotient);
+    }
+    if (r != nullptr) {
+        un.resize(n);
+        Trim(un);
+        *r = ShiftRight(un, s);
+    }
+}
+
+// a magnitude with a sign, for the cofactors of the extended gcd
+struct SignedNat {
+    Nat mag;
+    bool minus = false;
+};
+
+// r = a + b, r is neither a nor b
+void SignedAdd(SignedNat &r, const SignedNat &a, const SignedNat &b) {
+    if (a.minus == b.minus) {
+        Add(r.mag, a.mag, b.mag);
+        r.minus = a.minus;
+        return;
+    }
+    int c = Compare(a.mag, b.mag);
+    const SignedNat &larger = c > 0 ? a : b;
+    r.mag.assign(larger.mag.begin(), larger.mag.end());
+    r.minus = c != 0 && larger.minus;
+    SubInPlace(r.mag, c > 0 ? b.mag : a.mag);
+}
+
+// r = x * p for a signed word p, r is not x
+void MulSigned(SignedNat &r, const SignedNat &x, long long p) {
+    r.mag.assign(x.mag.begin(), x.mag.end());
+    unsigned long long m = p < 0 ? 0ULL - static_cast<unsigned long long>(p) : static_cast<unsigned long long>(p);
+    MulAddSmall(r.mag, m, 0);
+    r.minus = !r.mag.empty() && (x.minus != (p < 0));
+}
+
+/*
+ * r = p * x + q * y for words p and q of opposite signs (either may be
+ * zero) with a result known to be >= 0 and not longer than x or y, in one
+ * pass. r is neither x nor y.
+ */
+void LinearCombination(Nat &r, const Nat &x, long long p, const Nat &y, long long q) {
+    const Nat *plus = &x, *minus = &y;
+    unsigned long long mp = static_cast<unsigned long long>(p), mq = 0ULL - static_cast<unsigned long long>(q);
+    if (q > 0) {
+        plus = &y;
+        minus = &x;
+        mp = static_cast<unsigned long long>(q);
+        mq = 0ULL - static_cast<unsigned long long>(p);
+    }
+    size_t len = std::max(x.size(), y.size());
+    r.resize(len);
+    unsigned long long cp = 0, cm = 0, borrow = 0;
+    for (size_t i = 0; i < len; ++i) {
+        unsigned long long a = mul_add(mp, i < plus->size() ? (*plus)[i] : 0, cp, 0, cp);
+        unsigned long long b = mul_add(mq, i < minus->size() ? (*minus)[i] : 0, cm, 0, cm);
+        r[i] = sub_with_borrow(a, b, borrow);
+    }
+    Trim(r);
+}
+
+/*
+ * one Lehmer step on a >= b of the same length, at least two limbs: runs
+ * Euclid on the top 61 bits of both for as long as the quotients are
+ * certainly those of the full numbers (Knuth, TAOCP 4.5.2, algorithm L)
+ * and returns the matrix (A B; C D) the steps multiply (a, b) by. B == 0
+ * means not a single step could be simulated.
+ */
+void LehmerMatrix(const Nat &a, const Nat &b, long long &A, long long &B, long long &C, long long &D) {
+    size_t shift = BitLength(a) - 61;
+    size_t limb = shift / 64, bits = shift % 64;
+    auto top = [limb, bits](const Nat &x) {
+        unsigned long long lo = limb < x.size() ? x[limb] : 0;
+        unsigned long long hi = limb + 1 < x.size() ? x[limb + 1] : 0;
+        return static_cast<long long>(bits == 0 ? lo : (lo >> bits) | (hi << (64 - bits)));
+    };
+    long long x = top(a), y = top(b);
+    A = 1, B = 0, C = 0, D = 1;
+    while (y + C != 0 && y + D != 0) {
+        long long q = (x + A) / (y + C);
+        if (q != (x + B) / (y + D)) {
+            break;
+        }
+        long long t = A - q * C;
+        A = C;
+        C = t;
+        t = B - q * D;
+        B = D;
+        D = t;
+        t = x - q * y;
+        x = y;
+        y = t;
+    }
+}
+
+// the temporaries of LehmerGcd, reused from one step to the next
+struct LehmerScratch {
+    Nat na, nb, q, r;
+    SignedNat p0, p1, n0, n1;
+};
+
+// (s0, s1) = (s1, s0 - q * s1), the cofactors following a division step
+void CofactorStep(SignedNat &s0, SignedNat &s1, const Nat &q, LehmerScratch &t) {
+    Mul(t.p0.mag, q, s1.mag);
+    t.p0.minus = !t.p0.mag.empty() && !s1.minus;
+    SignedAdd(t.n0, s0, t.p0);
+    std::swap(s0, s1);
+    std::swap(s1, t.n0);
+}
+
+/*
+ * gcd(a, b) by Lehmer's algorithm: while b is longer than a word, a
+ * matrix simulated on the leading bits advances both numbers by many
+ * Euclid steps in one linear combination, and a division is only done
+ * when the lengths differ or the simulation stalls.
+ * with u given, the cofactor of a is tracked too: gcd == u * a (mod b).
+ */
+Nat LehmerGcd(Nat a, Nat b, SignedNat *u = nullptr) {
+    LehmerScratch t;
+    SignedNat s0, s1;
+    s0.mag = Nat{1};
+    if (Compare(a, b) < 0) {
+        std::swap(a, b);
+        std::swap(s0, s1);
+    }
+    while (b.size() > 1) {
+        long long A = 1, B = 0, C = 0, D = 1;
+        if (a.size() == b.size()) {
+            LehmerMatrix(a, b, A, B, C, D);
+        }
+        if (B == 0) {
+            DivMod(a, b, &t.q, &t.r);
+            a.swap(b);
+            b.swap(t.r);
+            if (u != nullptr) {
+                CofactorStep(s0, s1, t.q, t);
+            }
+            continue;
+        }
+        LinearCombination(t.na, a, A, b, B);
+        LinearCombination(t.nb, a, C, b, D);
+        a.swap(t.na);
+        b.swap(t.nb);
+        if (u != nullptr) {
+            MulSigned(t.p0, s0, A);
+            MulSigned(t.p1, s1, B);
+            SignedAdd(t.n0, t.p0, t.p1);
+            MulSigned(t.p0, s0, C);
+            MulSigned(t.p1, s1, D);
+            SignedAdd(t.n1, t.p0, t.p1);
+            std::swap(s0, t.n0);
+            std::swap(s1, t.n1);
+        }
+    }
+    // the tail in machine words
+    if (!b.empty()) {
+        t.q = a;
+        unsigned long long x = b[0], y = DivSmall(t.q, x);
+        if (u != nullptr) {
+            CofactorStep(s0, s1, t.q, t);
+        }
+        while (y != 0) {
+            unsigned long long qw = x / y, r = x % y;
+            x = y;
+            y = r;
+            if (u != nullptr) {
+                t.q.assign(1, qw);
+                CofactorStep(s0, s1, t.q, t);
+            }
+        }
+        a = Nat{x};
+    }
+    if (u != nullptr) {
+        *u = std::move(s0);
+    }
+    return a;
+}
+
+// floor(a^(1/k)) by Newton's method, k >= 2
+Nat RootNat(const Nat &a, unsigned k) {
+    size_t bits = BitLength(a);
+    if (bits == 0) {
+        return Nat();
+    }
+    Nat x;
+    if (bits <= 2 * static_cast<size_t>(k) + 64) {
+        // 2^ceil(bits / k) is above the root
+        x = ShiftLeft(Nat{1}, (bits + k - 1) / k);
+    } else {
+        // the root r of the top half, scaled back, is above the root and
+        // already right in about half of its bits: (r + 1)^k > a >> (k m)
+        // gives ((r + 1) 2^m)^k > a
+        size_t m = bits / (2 * k);
+        Nat r = RootNat(ShiftRight(a, m * k), k);
+        MulAddSmall(r, 1, 1);
+        x = ShiftLeft(r, m);
+    }
+    // started above the root, the iteration decreases until it reaches
+    // floor(a^(1/k)) and then stops decreasing
+    Nat power, next, q, t;
+    while (true) {
+        power = x;
+        for (unsigned i = 2; i < k; ++i) {
+            Mul(t, power, x);
+            power.swap(t);
+        }
+        DivMod(a, power, &q, nullptr);
+        t = x;
+        MulAddSmall(t, k - 1, 0);
+        Add(next, q, t);
+        DivSmall(next, k);
+        if (Compare(next, x) >= 0) {
+            return x;
+        }
+        x.swap(next);
+    }
+}
+
+/*
+ * squares modulo 64, 63, 65 and 11: a number that is not a square
+ * modulo one of them is not a square at all, which rules out all but
+ * about 6 in 1000 numbers.
+ */
+struct SquareTables {
+    bool mod64[64] = {}, mod63[63] = {}, mod65[65] = {}, mod11[11] = {};
+    SquareTables() {
+        for (int i = 0; i < 64; ++i) {
+            mod64[i * i % 64] = true;
+            mod63[i * i % 63] = true;
+            mod65[i * i % 65] = true;
+            mod11[i * i % 11] = true;
+        }
+    }
+};
+
+}  // namespace
+
+Bint gcd(const Bint &a, const Bint &b) {
+    Nat g = LehmerGcd(a._Magnitude(), b._Magnitude());
+    Bint r;
+    r._AssignLimbs(g.data(), g.size());
+    return r;
+}
+
+Bint extended_gcd(const Bint &a, const Bint &b, Bint &x, Bint &y) {
+    Nat ma = a._Magnitude(), mb = b._Magnitude();
+    SignedNat u;
+    Nat g = LehmerGcd(ma, mb, &u);
+    // g == u |a| + v |b|, v = (g - u |a|) / |b| exactly
+    SignedNat v;
+    if (!mb.empty()) {
+        SignedNat ua, rest;
+        Mul(ua.mag, u.mag, ma);
+        ua.minus = !ua.mag.empty() && !u.minus;
+        SignedAdd(rest, SignedNat{g, false}, ua);
+        DivMod(rest.mag, mb, &v.mag, nullptr);
+        v.minus = rest.minus && !v.mag.empty();
+    }
+    bool negative_a = a.isMinus && (a.length > 1 || a.data[0] != 0);
+    bool negative_b = b.isMinus && (b.length > 1 || b.data[0] != 0);
+    Bint r;
+    r._AssignLimbs(g.data(), g.size());
+    x._AssignLimbs(u.mag.data(), u.mag.size());
+    x.isMinus = !u.mag.empty() && (u.minus != negative_a);
+    y._AssignLimbs(v.mag.data(), v.mag.size());
+    y.isMinus = !v.mag.empty() && (v.minus != negative_b);
+    return r;
+}
+
+Bint inverse_mod(const Bint &a, const Bint &m) {
+    Nat mm = m._Magnitude();
+    if (mm.empty() || m.isMinus) {
+        throw std::domain_error("inverse_mod needs a positive modulus");
+    }
+    Nat ma;
+    DivMod(a._Magnitude(), mm, nullptr, &ma);
+    SignedNat u;
+    Nat g = LehmerGcd(ma, mm, &u);
+    if (Compare(g, Nat{1}) != 0 && Compare(mm, Nat{1}) != 0) {
+        throw std::domain_error("inverse_mod of a number not coprime to the modulus");
+    }
+    // u |a| == 1 (mod m), the inverse of a is u or -u by the sign of a
+    bool negate = u.minus != (a.isMinus && (a.length > 1 || a.data[0] != 0));
+    Nat r;
+    DivMod(u.mag, mm, nullptr, &r);
+    if (negate && !r.empty()) {
+        Nat t = mm;
+        SubInPlace(t, r);
+        r = std::move(t);
+    }
+    Bint result;
+    result._AssignLimbs(r.data(), r.size());
+    return result;
+}
+
+Bint isqrt(const Bint &n) {
+    return iroot(n, 2);
+}
+
+Bint iroot(const Bint &n, unsigned k) {
+    if (k == 0) {
+        throw std::domain_error("iroot of degree 0");
+    }
+    if (n.isMinus && (n.length > 1 || n.data[0] != 0)) {
+        throw std::domain_error("iroot of a negative number");
+    }
+    if (k == 1) {
+        return n;
+    }
+    Nat r = RootNat(n._Magnitude(), k);
+    Bint result;
+    result._AssignLimbs(r.data(), r.size());
+    return result;
+}
+
+bool is_perfect_square(const Bint &n) {
+    if (n.isMinus && (n.length > 1 || n.data[0] != 0)) {
+        return false;
+    }
+    static const SquareTables tables;
+    // 10^8 is a multiple of 64, only the two lowest limbs matter
+    int low = n.data[0] + (n.length > 1 ? n.data[1] : 0) * 10000;
+    if (!tables.mod64[low % 64]) {
+        return false;
+    }
+    // 45045 = 63 * 65 * 11, straight from the base 10^4 limbs
+    long long r = 0;
+    for (size_t i = n.length; i-- > 0;) {
+        r = (r * 10000 + n.data[i]) % 45045;
+    }
+    if (!tables.mod63[r % 63] || !tables.mod65[r % 65] || !tables.mod11[r % 11]) {
+        return false;
+    }
+    Nat m = n._Magnitude();
+    Nat s = RootNat(m, 2), square;
+    Mul(square, s, s);
+    return Compare(square, m) == 0;
+}
+
+}  // namespace Util
@@ -0,0 +1,435 @@
+#ifndef DIAMOND_MATRIX_LINALG_HPP
+#define DIAMOND_MATRIX_LINALG_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "class-matrix.hpp"
+#include "gemm.hpp"
+
+namespace Diamond {
+
+namespace detail {
+
+/*
+ * the factorizations copy the matrix into one row-major buffer and work
+ * there: a row of Matrix is its own std::vector, so rows neither swap nor
+ * pack as cheaply. the right-looking loops factor kFactorBlock columns at
+ * a time and hand the trailing update, nearly all of the n^3 work, to
+ * sjtu::detail::gemm, which splits it across threads.
+ */
+constexpr size_t kFactorBlock = 128;
+// the triangular solves work kSolveBlock rows at a time directly and
+// leave the rest of each block's work to gemm
+constexpr size_t kSolveBlock = 32;
+// the recursion on an LU panel stops at this many columns
+constexpr size_t kPanelLeaf = 8;
+
+template <typename _Td>
+std::vector<_Td> Flatten(const Matrix<_Td> &a) {
+    std::vector<_Td> flat(a.RowSize() * a.ColSize());
+    for (size_t i = 0; i < a.RowSize(); ++i) {
+        const _Td *row = a[i].data();
+        std::copy(row, row + a.ColSize(), flat.data() + i * a.ColSize());
+    }
+    return flat;
+}
+
+template <typename _Td>
+Matrix<_Td> Unflatten(const _Td *p, size_t rows, size_t cols) {
+    Matrix<_Td> a(rows, cols);
+    for (size_t i = 0; i < rows; ++i) {
+        std::copy(p + i * cols, p + (i + 1) * cols, a[i].data());
+    }
+    return a;
+}
+
+/*
+ * solves T X = B in place of the n x r matrix B for the lower triangular
+ * T at t, with ones on the diagonal when unit is set.
+ */
+template <typename _Td>
+void ForwardSolve(size_t n, size_t r, const _Td *t, size_t ldt, bool unit, _Td *b, size_t ldb) {
+    for (size_t k0 = 0; k0 < n; k0 += kSolveBlock) {
+        size_t kb = std::min(kSolveBlock, n - k0);
+        for (size_t i = k0; i < k0 + kb; ++i) {
+            _Td *row = b + i * ldb;
+            for (size_t p = k0; p < i; ++p) {
+                const _Td l = t[i * ldt + p];
+                const _Td *src = b + p * ldb;
+                for (size_t j = 0; j < r; ++j) {
+                    row[j] -= l * src[j];
+                }
+            }
+            if (!unit) {
+                const _Td d = t[i * ldt + i];
+                for (size_t j = 0; j < r; ++j) {
+                    row[j] /= d;
+                }
+            }
+        }
+        sjtu::detail::gemm(n - k0 - kb, r, kb, t + (k0 + kb) * ldt + k0, ldt, false, b + k0 * ldb, ldb, false,
+                           b + (k0 + kb) * ldb, ldb);
+    }
+}
+
+/*
+ * solves op(T) X = B in place of the n x r matrix B for an upper
+ * triangular op(T): T itself, or with trans the transpose of the lower
+ * triangular T, as L^T of a Cholesky factor.
+ */
+template <typename _Td>
+void BackwardSolve(size_t n, size_t r, const _Td *t, size_t ldt, bool trans, bool unit, _Td *b, size_t ldb) {
+    auto at = [t, ldt, trans](size_t i, size_t j) { return trans ? t[j * ldt + i] : t[i * ldt + j]; };
+    for (size_t end = n; end > 0;) {
+        size_t k0 = end > kSolveBlock ? end - kSolveBlock : 0;
+        for (size_t i = end; i-- > k0;) {
+            _Td *row = b + i * ldb;
+            for (size_t p = i + 1; p < end; ++p) {
+                const _Td u = at(i, p);
+                const _Td *src = b + p * ldb;
+                for (size_t j = 0; j < r; ++j) {
+                    row[j] -= u * src[j];
+                }
+            }
+            if (!unit) {
+                const _Td d = at(i, i);
+                for (size_t j = 0; j < r; ++j) {
+                    row[j] /= d;
+                }
+            }
+        }
+        // rows above the block: op(T)[0, k0) x [k0, end) times the solved rows
+        sjtu::detail::gemm(k0, r, end - k0, trans ? t + k0 * ldt : t + k0, ldt, trans, b + k0 * ldb, ldb, false, b,
+                           ldb);
+        end = k0;
+    }
+}
+
+/*
+ * LU with partial pivoting of the columns [c0, c0 + w) of the n x n
+ * matrix at a, rows c0 and below, by recursion on halves of the columns
+ * (Toledo): each half is factored, then the right one is updated by a
+ * triangular solve and a gemm instead of one column at a time. rows are
+ * swapped whole, so the columns outside the panel follow the pivots too.
+ */
+template <typename _Td>
+void FactorPanel(size_t n, _Td *a, size_t c0, size_t w, std::vector<size_t> &perm, bool &odd, bool &singular) {
+    if (w <= kPanelLeaf) {
+        for (size_t j = c0; j < c0 + w; ++j) {
+            size_t pivot = j;
+            for (size_t i = j + 1; i < n; ++i) {
+                if (std::abs(a[i * n + j]) > std::abs(a[pivot * n + j])) {
+                    pivot = i;
+                }
+            }
+            if (pivot != j) {
+                std::swap_ranges(a + j * n, a + (j + 1) * n, a + pivot * n);
+                std::swap(perm[j], perm[pivot]);
+                odd = !odd;
+            }
+            const _Td d = a[j * n + j];
+            if (d == _Td(0)) {
+                // nothing to eliminate with, the column is zero below j already
+                singular = true;
+                continue;
+            }
+            const _Td *pivot_row = a + j * n;
+            for (size_t i = j + 1; i < n; ++i) {
+                _Td *row = a + i * n;
+                const _Td l = row[j] /= d;
+                for (size_t c = j + 1; c < c0 + w; ++c) {
+                    row[c] -= l * pivot_row[c];
+                }
+            }
+        }
+        return;
+    }
+    size_t h = w / 2;
+    FactorPanel(n, a, c0, h, perm, odd, singular);
+    _Td *a12 = a + c0 * n + c0 + h;
+    ForwardSolve(h, w - h, a + c0 * n + c0, n, true, a12, n);
+    sjtu::detail::gemm(n - c0 - h, w - h, h, a + (c0 + h) * n + c0, n, false, a12, n, false, a12 + h * n, n);
+    FactorPanel(n, a, c0 + h, w - h, perm, odd, singular);
+}
+
+}  // namespace detail
+
+/**
+ * P A = L U of a square matrix, L unit lower triangular and U upper
+ * triangular, by a blocked right-looking factorization with partial
+ * pivoting. a singular matrix factors too, but cannot be solved with.
+ * _Td is a floating point type.
+ */
+template <typename _Td>
+class LUDecomposition {
+    static_assert(std::is_floating_point_v<_Td>, "LU needs a floating point element type");
+
+    size_t n = 0;
+    std::vector<_Td> lu;
+    std::vector<size_t> perm;
+    bool odd = false;
+    bool singular = false;
+
+    void CheckSolvable(size_t rows) const {
+        if (rows != n) {
+            throw std::invalid_argument("different matrics\'s sizes");
+        }
+        if (singular) {
+            throw std::domain_error("singular matrix");
+        }
+    }
+    void SolveInPlace(_Td *b, size_t r) const {
+        detail::ForwardSolve(n, r, lu.data(), n, true, b, r);
+        detail::BackwardSolve(n, r, lu.data(), n, false, false, b, r);
+    }
+
+   public:
+    /**
+     * throw std::invalid_argument if a is not square
+     */
+    explicit LUDecomposition(const Matrix<_Td> &a) : n(a.RowSize()), lu(detail::Flatten(a)), perm(n) {
+        if (a.RowSize() != a.ColSize()) {
+            throw std::invalid_argument("The row size and column size are different.");
+        }
+        for (size_t i = 0; i < n; ++i) {
+            perm[i] = i;
+        }
+        _Td *p = lu.data();
+        for (size_t k0 = 0; k0 < n; k0 += detail::kFactorBlock) {
+            size_t kb = std::min(detail::kFactorBlock, n - k0);
+            size_t rest = n - k0 - kb;
+            detail::FactorPanel(n, p, k0, kb, perm, odd, singular);
+            // U12 = L11^-1 A12, then A22 -= L21 U12
+            detail::ForwardSolve(kb, rest, p + k0 * n + k0, n, true, p + k0 * n + k0 + kb, n);
+            sjtu::detail::gemm(rest, rest, kb, p + (k0 + kb) * n + k0, n, false, p + k0 * n + k0 + kb, n, false,
+                               p + (k0 + kb) * n + k0 + kb, n);
+        }
+    }
+
+    size_t Size() const {
+        return n;
+    }
+    bool IsSingular() const {
+        return singular;
+    }
+    /**
+     * row i of P A is row Permutation()[i] of A.
+     */
+    const std::vector<size_t> &Permutation() const {
+        return perm;
+    }
+    Matrix<_Td> L() const {
+        Matrix<_Td> l(n, n, 0);
+        for (size_t i = 0; i < n; ++i) {
+            std::copy(lu.data() + i * n, lu.data() + i * n + i, l[i].data());
+            l[i][i] = 1;
+        }
+        return l;
+    }
+    Matrix<_Td> U() const {
+        Matrix<_Td> u(n, n, 0);
+        for (size_t i = 0; i < n; ++i) {
+            std::copy(lu.data() + i * n + i, lu.data() + (i + 1) * n, u[i].data() + i);
+        }
+        return u;
+    }
+    _Td Determinant() const {
+        if (singular) {
+            return 0;
+        }
+        _Td det = odd ? -1 : 1;
+        for (size_t i = 0; i < n; ++i) {
+            det *= lu[i * n + i];
+        }
+        return det;
+    }
+
+    /**
+     * the X with A X = B.
+     * throw std::invalid_argument if B does not have Size() rows,
+     * std::domain_error if A is singular
+     */
+    Matrix<_Td> Solve(const Matrix<_Td> &b) const {
+        CheckSolvable(b.RowSize());
+        size_t r = b.ColSize();
+        std::vector<_Td> x(n * r);
+        for (size_t i = 0; i < n; ++i) {
+            const _Td *row = b[perm[i]].data();
+            std::copy(row, row + r, x.data() + i * r);
+        }
+        SolveInPlace(x.data(), r);
+        return detail::Unflatten(x.data(), n, r);
+    }
+    std::vector<_Td> Solve(const std::vector<_Td> &b) const {
+        CheckSolvable(b.size());
+        std::vector<_Td> x(n);
+        for (size_t i = 0; i < n; ++i) {
+            x[i] = b[perm[i]];
+        }
+        SolveInPlace(x.data(), 1);
+        return x;
+    }
+    /**
+     * throw std::domain_error if A is singular
+     */
+    Matrix<_Td> Inverse() const {
+        CheckSolvable(n);
+        std::vector<_Td> x(n * n, 0);
+        for (size_t i = 0; i < n; ++i) {
+            x[i * n + perm[i]] = 1;
+        }
+        SolveInPlace(x.data(), n);
+        return detail::Unflatten(x.data(), n, n);
+    }
+};
+
+/**
+ * A = L L^T of a symmetric positive definite matrix, L lower triangular,
+ * by a blocked right-looking factorization. only the lower triangle of
+ * A is read. _Td is a floating point type.
+ */
+template <typename _Td>
+class CholeskyDecomposition {
+    static_assert(std::is_floating_point_v<_Td>, "Cholesky needs a floating point element type");
+
+    size_t n = 0;
+    std::vector<_Td> l;
+
+    void SolveInPlace(_Td *b, size_t r) const {
+        detail::ForwardSolve(n, r, l.data(), n, false, b, r);
+        detail::BackwardSolve(n, r, l.data(), n, true, false, b, r);
+    }
+
+   public:
+    /**
+     * throw std::invalid_argument if a is not square,
+     * std::domain_error if it is not positive definite
+     */
+    explicit CholeskyDecomposition(const Matrix<_Td> &a) : n(a.RowSize()), l(detail::Flatten(a)) {
+        if (a.RowSize() != a.ColSize()) {
+            throw std::invalid_argument("The row size and column size are different.");
+        }
+        _Td *p = l.data();
+        std::vector<_Td> panel;
+        for (size_t k0 = 0; k0 < n; k0 += detail::kFactorBlock) {
+            size_t kb = std::min(detail::kFactorBlock, n - k0);
+            size_t rest = n - k0 - kb;
+            // L11 from A11, whose earlier blocks are already subtracted
+            for (size_t j = k0; j < k0 + kb; ++j) {
+                _Td *row_j = p + j * n;
+                _Td d = row_j[j];
+                for (size_t q = k0; q < j; ++q) {
+                    d -= row_j[q] * row_j[q];
+                }
+                if (!(d > 0)) {
+                    throw std::domain_error("matrix not positive definite");
+                }
+                d = std::sqrt(d);
+                row_j[j] = d;
+                for (size_t i = j + 1; i < k0 + kb; ++i) {
+                    _Td *row_i = p + i * n;
+                    _Td s = row_i[j];
+                    for (size_t q = k0; q < j; ++q) {
+                        s -= row_i[q] * row_j[q];
+                    }
+                    row_i[j] = s / d;
+                }
+            }
+            if (rest == 0) {
+                break;
+            }
+            // L21 = A21 L11^-T, solved as L11 L21^T = A21^T on a transposed copy
+            panel.assign(kb * rest, 0);
+            for (size_t i = 0; i < rest; ++i) {
+                for (size_t j = 0; j < kb; ++j) {
+                    panel[j * rest + i] = p[(k0 + kb + i) * n + k0 + j];
+                }
+            }
+            detail::ForwardSolve(kb, rest, p + k0 * n + k0, n, false, panel.data(), rest);
+            for (size_t i = 0; i < rest; ++i) {
+                for (size_t j = 0; j < kb; ++j) {
+                    p[(k0 + kb + i) * n + k0 + j] = panel[j * rest + i];
+                }
+            }
+            // A22 -= L21 L21^T, one block column at a time and only on
+            // and below the diagonal
+            for (size_t j0 = k0 + kb; j0 < n; j0 += detail::kFactorBlock) {
+                size_t jb = std::min(detail::kFactorBlock, n - j0);
+                sjtu::detail::gemm(n - j0, jb, kb, p + j0 * n + k0, n, false, p + j0 * n + k0, n, true,
+                                   p + j0 * n + j0, n);
+            }
+        }
+    }
+
+    size_t Size() const {
+        return n;
+    }
+    Matrix<_Td> L() const {
+        Matrix<_Td> res(n, n, 0);
+        for (size_t i = 0; i < n; ++i) {
+            std::copy(l.data() + i * n, l.data() + i * n + i + 1, res[i].data());
+        }
+        return res;
+    }
+    _Td Determinant() const {
+        _Td det = 1;
+        for (size_t i = 0; i < n; ++i) {
+            det *= l[i * n + i] * l[i * n + i];
+        }
+        return det;
+    }
+    /**
+     * the X with A X = B.
+     * throw std::invalid_argument if B does not have Size() rows
+     */
+    Matrix<_Td> Solve(const Matrix<_Td> &b) const {
+        if (b.RowSize() != n) {
+            throw std::invalid_argument("different matrics\'s sizes");
+        }
+        std::vector<_Td> x = detail::Flatten(b);
+        SolveInPlace(x.data(), b.ColSize());
+        return detail::Unflatten(x.data(), n, b.ColSize());
+    }
+    std::vector<_Td> Solve(const std::vector<_Td> &b) const {
+        if (b.size() != n) {
+            throw std::invalid_argument("different matrics\'s sizes");
+        }
+        std::vector<_Td> x = b;
+        SolveInPlace(x.data(), 1);
+        return x;
+    }
+    Matrix<_Td> Inverse() const {
+        std::vector<_Td> x(n * n, 0);
+        for (size_t i = 0; i < n; ++i) {
+            x[i * n + i] = 1;
+        }
+        SolveInPlace(x.data(), n);
+        return detail::Unflatten(x.data(), n, n);
+    }
+};
+
+/**
+ * the X with A X = B, through LUDecomposition.
+ */
+template <typename _Td>
+Matrix<_Td> Solve(const Matrix<_Td> &a, const Matrix<_Td> &b) {
+    return LUDecomposition<_Td>(a).Solve(b);
+}
+
+template <typename _Td>
+Matrix<_Td> Inverse(const Matrix<_Td> &a) {
+    return LUDecomposition<_Td>(a).Inverse();
+}
+
+template <typename _Td>
+_Td Determinant(const Matrix<_Td> &a) {
+    return LUDecomposition<_Td>(a).Determinant();
+}
+
+}  // namespace Diamond
+#endif
@@ -0,0 +1,36 @@
+#ifndef DIAMOND_MATRIX_OUTPUT_HPP
+#define DIAMOND_MATRIX_OUTPUT_HPP
+
+#include <type_traits>
+
+#include "class-matrix.hpp"
+#include "fast_output.hpp"
+
+namespace Diamond {
+
+/**
+ * the text operator<< writes to a stream, written through an output_writer
+ * instead: arithmetic elements right-aligned in 15 columns, floating point
+ * ones with 8 decimals. other element types follow a single space.
+ */
+template <typename _Td>
+sjtu::output_writer &operator<<(sjtu::output_writer &out, const Matrix<_Td> &mat) {
+    out.put('\n');
+    for (size_t i = 0; i < mat.RowSize(); ++i) {
+        for (size_t j = 0; j < mat.ColSize(); ++j) {
+            if constexpr (std::is_floating_point_v<_Td>) {
+                out.write_fixed(mat[i][j], 8, 15);
+            } else if constexpr (std::is_integral_v<_Td>) {
+                out.write_int(mat[i][j], 15);
+            } else {
+                out << ' ' << mat[i][j];
+            }
+        }
+        out.put('\n');
+    }
+    return out;
+}
+
+}  // namespace Diamond
+
+#endif
@@ -23,6 +23,12 @@ class Matrix {
         _Td &operator[](const size_t &pos) {
             return row[pos];
         }
+        _Td *data() const {
+            return row.data();
+        }
+        size_t size() const {
+            return row.size();
+        }
     };
     class ConstRowProxy {
         const std::vector<_Td> &row;
@@ -33,6 +39,12 @@ class Matrix {
         const _Td &operator[](const size_t &pos) const {
             return row[pos];
         }
+        const _Td *data() const {
+            return row.data();
+        }
+        size_t size() const {
+            return row.size();
+        }
     };
 
    public:
@@ -0,0 +1,130 @@
+#include "compressed_vector.hpp"
+#include "vector.hpp"
+#include "test-utility.hpp"
+
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+
+bool SameAs(const sjtu::compressed_int_vector &c, const sjtu::vector<long long> &v)
+{
+	if (c.size() != v.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < v.size(); i += 1 + rand64() % 7) {
+		if (c[i] != v[i]) {
+			return false;
+		}
+	}
+	long long *out = new long long[v.size() + 1];
+	c.decode(out);
+	bool same = true;
+	for (size_t i = 0; i < v.size(); ++i) {
+		same = same && out[i] == v[i];
+	}
+	delete[] out;
+	size_t i = 0;
+	c.for_each([&](long long x) { same = same && x == v[i++]; });
+	i = 0;
+	for (long long x : c) {
+		same = same && x == v[i++];
+	}
+	// reading only some values, so a delta block is summed across the gaps
+	i = 0;
+	for (auto it = c.begin(); it != c.end(); ++it, ++i) {
+		if (rand64() % 5 == 0) {
+			same = same && *it == v[i];
+		}
+	}
+	return same;
+}
+
+void TestEncodings()
+{
+	std::cout << "Testing frame of reference and delta..." << std::endl;
+	sjtu::vector<long long> counters;
+	for (int i = 0; i < 100000; ++i) {
+		counters.push_back(1000000 + rand64() % 5000);
+	}
+	sjtu::compressed_int_vector a(counters);
+	std::cout << SameAs(a, counters) << " " << counters.size() * sizeof(long long) / a.memory_usage() << std::endl;
+
+	sjtu::vector<long long> ids;
+	long long id = -123456789;
+	for (int i = 0; i < 100000; ++i) {
+		id += rand64() % 300;
+		ids.push_back(id);
+	}
+	sjtu::compressed_int_vector b(ids, sjtu::int_encoding::delta);
+	std::cout << SameAs(b, ids) << " " << ids.size() * sizeof(long long) / b.memory_usage() << std::endl;
+
+	sjtu::vector<long long> wild;
+	for (int i = 0; i < 1000; ++i) {
+		wild.push_back(i % 3 == 0 ? LLONG_MIN : i % 3 == 1 ? LLONG_MAX : static_cast<long long>(rand64()));
+	}
+	for (int i = 0; i < 300; ++i) {
+		wild.push_back(42);
+	}
+	sjtu::compressed_int_vector c(wild), d(wild, sjtu::int_encoding::delta);
+	std::cout << SameAs(c, wild) << " " << SameAs(d, wild) << std::endl;
+}
+
+void TestBasic()
+{
+	std::cout << "Testing push_back and access..." << std::endl;
+	sjtu::compressed_int_vector c;
+	std::cout << c.empty() << " ";
+	for (int i = 0; i < 300; ++i) {
+		c.push_back(i * i);
+	}
+	std::cout << c.size() << " " << c[0] << " " << c[127] << " " << c[128] << " " << c[299] << std::endl;
+	try {
+		c.at(300);
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "OK" << std::endl;
+	}
+	sjtu::compressed_int_vector copy = c;
+	c.clear();
+	std::cout << c.size() << " " << copy[200] << std::endl;
+}
+
+// pass the number of values, e.g. 4194304
+void Benchmark(size_t n)
+{
+	sjtu::vector<long long> ids;
+	long long id = 0;
+	for (size_t i = 0; i < n; ++i) {
+		id += 1 + rand64() % 1000;
+		ids.push_back(id);
+	}
+	sjtu::compressed_int_vector forv(ids), delta(ids, sjtu::int_encoding::delta);
+	long long *out = new long long[n + 1];
+	const int kRounds = 20;
+	double forv_ms = TimeMs([&] {
+		for (int r = 0; r < kRounds; ++r) {
+			forv.decode(out);
+		}
+	});
+	double delta_ms = TimeMs([&] {
+		for (int r = 0; r < kRounds; ++r) {
+			delta.decode(out);
+		}
+	});
+	double bytes = 1.0 * kRounds * n * sizeof(long long);
+	std::cerr << (n == 0 || out[n - 1] == id ? "" : "FAIL ") << "decode (GB/s of output): frame_of_reference "
+	          << bytes / forv_ms / 1e6 << " delta " << bytes / delta_ms / 1e6 << ", bytes per value "
+	          << 1.0 * forv.memory_usage() / n << " and " << 1.0 * delta.memory_usage() / n << std::endl;
+	delete[] out;
+}
+
+int main(int argc, char const *argv[])
+{
+	seed = 5772156649015328ULL;
+	TestEncodings();
+	TestBasic();
+	if (argc > 1) {
+		Benchmark(std::strtoul(argv[1], nullptr, 10));
+	}
+	return 0;
+}
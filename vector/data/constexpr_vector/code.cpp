@@ -0,0 +1,124 @@
+#include "vector.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <ranges>
+#include <string>
+
+constexpr sjtu::vector<unsigned> Crc32Table()
+{
+	sjtu::vector<unsigned> table;
+	for (unsigned i = 0; i < 256; ++i) {
+		unsigned c = i;
+		for (int k = 0; k < 8; ++k) {
+			c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+		}
+		table.push_back(c);
+	}
+	return table;
+}
+
+constexpr sjtu::vector<unsigned long long> Pow10Table()
+{
+	sjtu::vector<unsigned long long> table;
+	for (unsigned long long p = 1;; p *= 10) {
+		table.push_back(p);
+		if (p > ~0ULL / 10) {
+			break;
+		}
+	}
+	return table;
+}
+
+constexpr auto kCrcTable = sjtu::to_static_array<Crc32Table>();
+constexpr auto kPow10 = sjtu::to_static_array<Pow10Table>();
+static_assert(kCrcTable.size() == 256 && kCrcTable[1] == 0x77073096u && kCrcTable[255] == 0x2D02EF8Du);
+static_assert(kPow10.size() == 20 && kPow10[19] == 10000000000000000000ULL);
+
+constexpr auto kPrimes = sjtu::to_static_array<[] {
+	sjtu::vector<int> primes;
+	for (int n = 2; primes.size() < 10; ++n) {
+		bool prime = true;
+		for (int p : primes) {
+			prime = prime && n % p != 0;
+		}
+		if (prime) {
+			primes.push_back(n);
+		}
+	}
+	return primes;
+}>();
+static_assert(kPrimes[9] == 29);
+
+unsigned Crc32(const std::string &s)
+{
+	unsigned c = ~0u;
+	for (unsigned char ch : s) {
+		c = kCrcTable[(c ^ ch) & 0xFF] ^ (c >> 8);
+	}
+	return ~c;
+}
+
+// the container operations themselves, evaluated once by the compiler and
+// once at run time
+constexpr long long Exercise()
+{
+	sjtu::vector<int> v(sjtu::from_range, std::views::iota(0, 20));
+	v.insert(0, 100);
+	v.erase(5);
+	v.insert(v.begin() + 3, -7);
+	v.erase(v.end() - 1);
+	std::sort(v.begin(), v.end());
+	sjtu::vector<int> w = v;
+	w.pop_back();
+	v = w;
+	sjtu::vector<int> big;
+	big.reserve(64);
+	big.append_range(v);
+	big = v;
+	big.resize_uninitialized(25);
+	for (size_t i = v.size(); i < big.size(); ++i) {
+		big[i] = static_cast<int>(i);
+	}
+	long long sum = 0;
+	for (int x : big) {
+		sum = sum * 3 + x;
+	}
+	return sum + static_cast<long long>(big.size() * 1000 + v.front() + v.back());
+}
+static_assert(Exercise() == Exercise());
+constexpr long long kExercise = Exercise();
+
+constexpr size_t StringLengths()
+{
+	sjtu::vector<std::string> words;
+	words.push_back("compile");
+	words.push_back("time");
+	words.push_back("and a string too long for the small buffer");
+	words.insert(1, "at");
+	sjtu::vector<std::string> copy = words;
+	copy.erase(0);
+	size_t total = 0;
+	for (const std::string &s : copy) {
+		total = total * 10 + s.size();
+	}
+	return total;
+}
+static_assert(StringLengths() == 282);
+
+int main()
+{
+	std::cout << std::hex << kCrcTable[1] << " " << kCrcTable[128] << " " << Crc32("123456789") << std::dec
+	          << std::endl;
+	sjtu::vector<unsigned> runtime = Crc32Table();
+	std::cout << std::equal(runtime.begin(), runtime.end(), kCrcTable.begin()) << std::endl;
+	std::cout << kPow10.size() << " " << kPow10[0] << " " << kPow10[12] << std::endl;
+	for (int p : kPrimes) {
+		std::cout << p << " ";
+	}
+	std::cout << std::endl;
+	long long at_runtime = Exercise();
+	std::cout << kExercise << " " << (at_runtime == kExercise) << std::endl;
+	std::cout << StringLengths() << std::endl;
+	return 0;
+}
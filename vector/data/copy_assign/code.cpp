@@ -0,0 +1,122 @@
+#include "bulk_copy.hpp"
+#include "vector.hpp"
+#include "test-utility.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+struct Counted {
+	static int alive;
+	static int copies;
+	int value;
+	Counted(int v) : value(v) { ++alive; }
+	Counted(const Counted &o) : value(o.value) { ++alive; ++copies; }
+	Counted &operator=(const Counted &o) {
+		value = o.value;
+		++copies;
+		return *this;
+	}
+	~Counted() { --alive; }
+};
+int Counted::alive = 0;
+int Counted::copies = 0;
+
+void TestReuse()
+{
+	std::cout << "Testing assignment into existing capacity..." << std::endl;
+	sjtu::vector<int> a, b;
+	for (int i = 0; i < 100; ++i) {
+		a.push_back(i);
+	}
+	for (int i = 0; i < 10; ++i) {
+		b.push_back(-i);
+	}
+	a = b;
+	const int *before = a.data();
+	std::cout << a.size() << " " << a.capacity() << " " << a[9] << std::endl;
+	for (int i = 0; i < 50; ++i) {
+		b.push_back(i);
+	}
+	a = b;
+	std::cout << a.size() << " " << (a.data() == before) << " " << a[59] << std::endl;
+	sjtu::vector<int> c = a;
+	std::cout << c.size() << " " << c.capacity() << " " << c[10] << std::endl;
+
+	sjtu::vector<Counted> x, y;
+	for (int i = 0; i < 8; ++i) {
+		x.push_back(Counted(i));
+	}
+	for (int i = 0; i < 5; ++i) {
+		y.push_back(Counted(i * 10));
+	}
+	Counted::copies = 0;
+	x = y;
+	std::cout << Counted::alive << " " << Counted::copies << " " << x.size() << " " << x[4].value << std::endl;
+	y.push_back(Counted(50));
+	y.push_back(Counted(60));
+	Counted::copies = 0;
+	x = y;
+	std::cout << Counted::alive << " " << Counted::copies << " " << x.size() << " " << x.back().value << std::endl;
+
+	sjtu::vector<std::string> s, t;
+	s.push_back("one");
+	t.push_back("two");
+	t.push_back("three");
+	s = t;
+	t[0] = "changed";
+	sjtu::vector<std::string> u = s;
+	s = s;
+	std::cout << s[0] << " " << s[1] << " " << u.size() << " " << u[1] << std::endl;
+}
+
+// big holds n values, copied by a plain copy and by assign_parallel, which
+// splits it across threads past kBulkCopyThreshold
+void CopyBulk(size_t n, double &construct_ms, double &parallel_ms, bool &same)
+{
+	sjtu::vector<long long> big;
+	big.resize_uninitialized(n);
+	for (size_t i = 0; i < n; ++i) {
+		big[i] = i * 2654435761ULL;
+	}
+	sjtu::vector<long long> copy, parallel;
+	construct_ms = TimeMs([&] {
+		sjtu::vector<long long> fresh = big;
+		copy.swap(fresh);
+	});
+	parallel.push_back(-1);
+	parallel_ms = TimeMs([&] { sjtu::assign_parallel(parallel, big); });
+	same = copy.size() == n && std::memcmp(copy.data(), big.data(), n * sizeof(long long)) == 0 &&
+	       parallel.size() == n && std::memcmp(parallel.data(), big.data(), n * sizeof(long long)) == 0 &&
+	       parallel.capacity() == n;
+}
+
+void TestBulk()
+{
+	std::cout << "Testing large copies..." << std::endl;
+	double construct_ms, parallel_ms;
+	bool same;
+	CopyBulk(sjtu::detail::kBulkCopyThreshold / sizeof(long long) + 1000, construct_ms, parallel_ms, same);
+	std::cout << same << std::endl;
+}
+
+// pass the number of MiB to copy, e.g. 96
+void Benchmark(size_t mib)
+{
+	double construct_ms, parallel_ms;
+	bool same;
+	CopyBulk((mib << 20) / sizeof(long long), construct_ms, parallel_ms, same);
+	std::cerr << (same ? "" : "FAIL ") << "copy " << mib << " MiB (ms): construct " << construct_ms
+	          << " assign_parallel " << parallel_ms << std::endl;
+}
+
+int main(int argc, char const *argv[])
+{
+	TestReuse();
+	TestBulk();
+	if (argc > 1) {
+		Benchmark(std::strtoul(argv[1], nullptr, 10));
+	}
+	return 0;
+}
@@ -0,0 +1,130 @@
+#include "devector.hpp"
+#include "vector.hpp"
+#include "test-utility.hpp"
+
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <string>
+
+void TestBasic()
+{
+	std::cout << "Testing push and pop at both ends..." << std::endl;
+	sjtu::devector<std::string> d;
+	d.push_back("c");
+	d.push_front("b");
+	d.push_front("a");
+	d.push_back("d");
+	d.emplace_back(2, 'e');
+	for (const std::string &s : d) {
+		std::cout << s << " ";
+	}
+	std::cout << d.size() << " " << d.front() << " " << d.back() << std::endl;
+	d.insert(1, "x");
+	d.insert(5, "y");
+	d.erase(0);
+	for (size_t i = 0; i < d.size(); ++i) {
+		std::cout << d.data()[i] << " ";
+	}
+	std::cout << std::endl;
+	d.push_front(d.back());
+	d.push_back(d.front());
+	sjtu::devector<std::string> c = d;
+	d.pop_front();
+	d.pop_back();
+	std::cout << d.front() << " " << d.back() << " " << c.front() << " " << c.back() << " " << (c.end() - c.begin()) << std::endl;
+	try {
+		d.at(d.size());
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "OK" << std::endl;
+	}
+	d.clear();
+	try {
+		d.pop_front();
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "OK" << std::endl;
+	}
+}
+
+void TestRandom()
+{
+	std::cout << "Testing random operations..." << std::endl;
+	sjtu::devector<long long, sjtu::devector_balanced_policy> d;
+	std::deque<long long> ref;
+	bool same = true;
+	for (int step = 0; step < 200000 && same; ++step) {
+		unsigned long long op = rand64() % 8;
+		long long v = rand64() % 1000000;
+		if (op < 2) {
+			d.push_back(v);
+			ref.push_back(v);
+		} else if (op < 4) {
+			d.push_front(v);
+			ref.push_front(v);
+		} else if (op == 4 && !ref.empty()) {
+			d.pop_back();
+			ref.pop_back();
+		} else if (op == 5 && !ref.empty()) {
+			d.pop_front();
+			ref.pop_front();
+		} else if (op == 6 && ref.size() < 2000) {
+			size_t pos = rand64() % (ref.size() + 1);
+			d.insert(pos, v);
+			ref.insert(ref.begin() + pos, v);
+		} else if (op == 7 && !ref.empty()) {
+			size_t pos = rand64() % ref.size();
+			d.erase(pos);
+			ref.erase(ref.begin() + pos);
+		}
+		same = d.size() == ref.size() && (ref.empty() || (d.front() == ref.front() && d.back() == ref.back()));
+	}
+	for (size_t i = 0; same && i < ref.size(); ++i) {
+		same = d[i] == ref[i];
+	}
+	std::cout << same << std::endl;
+
+	sjtu::devector<int> q;
+	for (int i = 0; i < 100; ++i) {
+		q.push_back(i);
+	}
+	for (int i = 100; i < 1000000; ++i) {
+		q.push_back(i);
+		q.pop_front();
+	}
+	std::cout << q.front() << " " << q.back() << " " << q.capacity() << std::endl;
+	q.reserve_front(500);
+	q.reserve(300);
+	std::cout << (q.front_free_capacity() >= 400) << " " << (q.back_free_capacity() >= 200) << " " << q.front() << std::endl;
+}
+
+// pass the number of ints to prepend, e.g. 50000
+void Benchmark(size_t n)
+{
+	sjtu::vector<int> v;
+	sjtu::devector<int> d;
+	double vector_ms = TimeMs([&] {
+		for (size_t i = 0; i < n; ++i) {
+			v.insert(0, static_cast<int>(i));
+		}
+	});
+	double devector_ms = TimeMs([&] {
+		for (size_t i = 0; i < n; ++i) {
+			d.push_front(static_cast<int>(i));
+		}
+	});
+	std::cerr << (n == 0 || (v[0] == d[0] && v[n - 1] == d[n - 1]) ? "" : "FAIL ") << "prepend " << n
+	          << " ints (ms): vector " << vector_ms << " devector " << devector_ms << std::endl;
+}
+
+int main(int argc, char const *argv[])
+{
+	seed = 1414213562373095ULL;
+	TestBasic();
+	TestRandom();
+	if (argc > 1) {
+		Benchmark(std::strtoul(argv[1], nullptr, 10));
+	}
+	return 0;
+}
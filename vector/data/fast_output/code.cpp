@@ -0,0 +1,184 @@
+#include "fast_output.hpp"
+#include "vector.hpp"
+
+#include "class-bint.hpp"
+#include "class-matrix-output.hpp"
+#include "test-utility.hpp"
+
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+// runs write_all with a writer on a temporary file and returns what it wrote
+template <typename F>
+std::string Capture(F write_all, size_t buffer_size = sjtu::output_writer::kDefaultBufferSize)
+{
+	FILE *f = tmpfile();
+	{
+		sjtu::output_writer out(fileno(f), buffer_size);
+		write_all(out);
+	}
+	std::string text;
+	rewind(f);
+	char chunk[4096];
+	size_t n;
+	while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) {
+		text.append(chunk, n);
+	}
+	fclose(f);
+	return text;
+}
+
+void TestIntegers()
+{
+	std::cout << "Testing integers..." << std::endl;
+	{
+		sjtu::output_writer out;
+		out << 0 << ' ' << -1 << ' ' << LLONG_MIN << ' ' << ULLONG_MAX << ' ' << static_cast<short>(-300) << ' '
+		    << 99u << ' ' << true << '\n';
+		out << '[';
+		out.write_int(42, 6).write_int(-7, 3).write_int(123456, 2) << "]\n";
+	}
+	std::string expected;
+	char buf[64];
+	for (int i = 0; i < 100000; ++i) {
+		long long x = static_cast<long long>(rand64()) >> (rand64() % 64);
+		snprintf(buf, sizeof(buf), "%lld\n", x);
+		expected += buf;
+	}
+	seed = 20240917;
+	// a tiny buffer flushes all the time
+	for (size_t buffer_size : {size_t(1), size_t(100), sjtu::output_writer::kDefaultBufferSize}) {
+		std::string text = Capture(
+		    [](sjtu::output_writer &out) {
+			    for (int i = 0; i < 100000; ++i) {
+				    out << (static_cast<long long>(rand64()) >> (rand64() % 64)) << '\n';
+			    }
+		    },
+		    buffer_size);
+		seed = 20240917;
+		std::cout << (text == expected ? "match" : "MISMATCH") << std::endl;
+	}
+}
+
+void TestDoubles()
+{
+	std::cout << "Testing doubles..." << std::endl;
+	{
+		sjtu::output_writer out;
+		out << 0.1 << ' ' << 1.0 << ' ' << -2.5 << ' ' << 1e300 << ' ' << 5e-324 << ' ' << 0.1f << '\n';
+		out.write_fixed(3.14159265358979, 8, 15).write_fixed(-0.5, 2) << '\n';
+	}
+	sjtu::vector<double> values;
+	for (int i = 0; i < 20000; ++i) {
+		unsigned long long bits = rand64();
+		double x;
+		memcpy(&x, &bits, sizeof(x));
+		if (x == x && x - x == 0) {  // finite
+			values.push_back(x);
+		}
+	}
+	std::string text = Capture([&](sjtu::output_writer &out) {
+		for (double x : values) {
+			out << x << '\n';
+		}
+	});
+	int wrong = 0;
+	const char *p = text.c_str();
+	for (double x : values) {
+		char *end;
+		wrong += strtod(p, &end) != x;
+		p = end + 1;
+	}
+	std::cout << "round trip failures: " << wrong << std::endl;
+}
+
+void TestAdapters()
+{
+	std::cout << "Testing adapters..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = -3; i <= 3; ++i) {
+		v.push_back(i * 1000);
+	}
+	Diamond::Matrix<double> m(3, 4);
+	for (size_t i = 0; i < 3; ++i) {
+		for (size_t j = 0; j < 4; ++j) {
+			m[i][j] = (static_cast<double>(i) - 1.3) * (j + 0.7) * 1234.5678;
+		}
+	}
+	Diamond::Matrix<int> mi(2, 3, -17);
+	std::ostringstream expected_matrix;
+	expected_matrix << m << mi;
+	std::string text = Capture([&](sjtu::output_writer &out) { out << m << mi; });
+	std::cout << (text == expected_matrix.str() ? "matrix match" : "matrix MISMATCH") << std::endl;
+	// too long for the fixed buffer, and digits a double does not have
+	Diamond::Matrix<double> huge(2, 2, 1e300);
+	huge[1][1] = -1.7976931348623157e308;
+	Diamond::Matrix<long double> precise(2, 2, 1.0L / 3);
+	precise[0][1] = 1e1000L;
+	expected_matrix.str("");
+	expected_matrix << huge << precise;
+	text = Capture([&](sjtu::output_writer &out) { out << huge << precise; });
+	std::cout << (text == expected_matrix.str() ? "matrix match" : "matrix MISMATCH") << std::endl;
+
+	Util::Bint big(1);
+	for (int i = 0; i < 40; ++i) {
+		big = big * Util::Bint(1000003);
+	}
+	std::ostringstream expected_bint;
+	expected_bint << big << " " << Util::Bint(-10002) << " " << Util::Bint(0);
+	text = Capture([&](sjtu::output_writer &out) { out << big << ' ' << Util::Bint(-10002) << ' ' << Util::Bint(0); });
+	std::cout << (text == expected_bint.str() ? "bint match" : "bint MISMATCH") << std::endl;
+
+	sjtu::output_writer out;
+	out << v << '\n' << Util::Bint(123456789) << '\n';
+	Diamond::Matrix<Util::Bint> mb(2, 2, Util::Bint(100020003));
+	out << mb;
+	// larger than the buffer: written straight through
+	std::string line(100000, '#');
+	out << std::string_view(line).substr(0, 10) << ' ' << line.size() << '\n';
+	out.flush();
+	std::cout << Capture([&](sjtu::output_writer &w) { w << line; }, 1024).size() << std::endl;
+}
+
+// pass the number of integers to write, e.g. 2000000
+void Benchmark(size_t n)
+{
+	sjtu::vector<long long> values;
+	for (size_t i = 0; i < n; ++i) {
+		values.push_back(static_cast<long long>(rand64() % 2000000000) - 1000000000);
+	}
+	FILE *null = fopen("/dev/null", "w");
+	double fprintf_ms = TimeMs([&] {
+		for (long long x : values) {
+			fprintf(null, "%lld\n", x);
+		}
+		fflush(null);
+	});
+	double writer_ms = TimeMs([&] {
+		sjtu::output_writer out(fileno(null));
+		for (long long x : values) {
+			out << x << '\n';
+		}
+	});
+	fclose(null);
+	std::cerr << n << " integers (ms): fprintf " << fprintf_ms << " output_writer " << writer_ms << std::endl;
+}
+
+int main(int argc, char const *argv[])
+{
+	seed = 20240917;
+	TestIntegers();
+	TestDoubles();
+	TestAdapters();
+	if (argc > 1) {
+		Benchmark(std::strtoul(argv[1], nullptr, 10));
+	}
+	return 0;
+}
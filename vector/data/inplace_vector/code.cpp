@@ -0,0 +1,131 @@
+#include "inplace_vector.hpp"
+#include "vector.hpp"
+#include "test-utility.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable_v<sjtu::inplace_vector<int, 8>>);
+static_assert(!std::is_trivially_copyable_v<sjtu::inplace_vector<std::string, 8>>);
+static_assert(sizeof(sjtu::inplace_vector<char, 16>) <= 16 + sizeof(size_t));
+
+constexpr int SquareSum(int n)
+{
+	sjtu::inplace_vector<int, 16> v;
+	for (int i = 1; i <= n; ++i) {
+		v.push_back(i * i);
+	}
+	v.insert(0, 100);
+	v.erase(v.begin());
+	sjtu::inplace_vector<int, 16> w = v;
+	int s = 0;
+	for (int x : w) {
+		s += x;
+	}
+	return s;
+}
+static_assert(SquareSum(4) == 30);
+
+void TestBasic()
+{
+	std::cout << "Testing trivial elements..." << std::endl;
+	sjtu::inplace_vector<int, 4> v;
+	for (int i = 0; i < 5; ++i) {
+		int *p = v.try_push_back(i * 10);
+		std::cout << (p ? *p : -1) << " ";
+	}
+	std::cout << v.size() << " " << v.capacity() << std::endl;
+	try {
+		v.push_back(50);
+		std::cout << "FAIL" << std::endl;
+	} catch (std::bad_alloc &) {
+		std::cout << "OK" << std::endl;
+	}
+	v.erase(1);
+	v.insert(v.begin() + 1, 15);
+	sjtu::inplace_vector<int, 4> w;
+	std::memcpy(static_cast<void *>(&w), &v, sizeof(v));
+	v.pop_back();
+	for (int x : w) {
+		std::cout << x << " ";
+	}
+	std::cout << v.back() << " " << w.back() << std::endl;
+	try {
+		v.at(3);
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "OK" << std::endl;
+	}
+	constexpr int kSum = SquareSum(3);
+	std::cout << kSum << std::endl;
+}
+
+void TestStrings()
+{
+	std::cout << "Testing non-trivial elements..." << std::endl;
+	sjtu::inplace_vector<std::string, 3> v;
+	v.push_back("one");
+	v.emplace_back(3, 'z');
+	v.insert(0, "zero");
+	std::cout << (v.try_emplace_back("four") == nullptr) << std::endl;
+	sjtu::inplace_vector<std::string, 3> c = v;
+	sjtu::inplace_vector<std::string, 3> m = std::move(c);
+	v.erase(v.begin() + 1);
+	v[0].append("!");
+	for (const std::string &s : v) {
+		std::cout << s << " ";
+	}
+	for (const std::string &s : m) {
+		std::cout << s << " ";
+	}
+	std::cout << std::endl;
+	m = v;
+	std::cout << m.size() << " " << m.front() << std::endl;
+	m.clear();
+	try {
+		m.pop_back();
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "OK" << std::endl;
+	}
+}
+
+// pass the number of rounds, e.g. 1000000
+void Benchmark(int rounds)
+{
+	// the push/pop churn of vector/data/six, bounded to 16 live items
+	long long s1 = 0, s2 = 0;
+	double vector_ms = TimeMs([&] {
+		for (int round = 0; round < rounds; ++round) {
+			sjtu::vector<int> v;
+			for (int i = 0; i < 16; ++i) {
+				v.push_back(round + i);
+			}
+			s1 += v[round % 16];
+		}
+	});
+	double inplace_ms = TimeMs([&] {
+		for (int round = 0; round < rounds; ++round) {
+			sjtu::inplace_vector<int, 16> v;
+			for (int i = 0; i < 16; ++i) {
+				v.push_back(round + i);
+			}
+			s2 += v[round % 16];
+		}
+	});
+	std::cerr << (s1 == s2 ? "" : "FAIL ") << "fill 16 items, " << rounds << " rounds (ms): vector " << vector_ms
+	          << " inplace_vector " << inplace_ms << std::endl;
+}
+
+int main(int argc, char const *argv[])
+{
+	TestBasic();
+	TestStrings();
+	if (argc > 1) {
+		Benchmark(std::atoi(argv[1]));
+	}
+	return 0;
+}
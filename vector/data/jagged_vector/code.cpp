@@ -0,0 +1,149 @@
+#include "jagged_vector.hpp"
+#include "vector.hpp"
+#include "test-utility.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+template <typename Row>
+void PrintRow(const Row &r)
+{
+	std::cout << "[";
+	for (size_t i = 0; i < r.size(); ++i) {
+		std::cout << (i ? " " : "") << r[i];
+	}
+	std::cout << "]";
+}
+
+void TestBasic()
+{
+	std::cout << "Testing append_row and builder..." << std::endl;
+	sjtu::jagged_vector<int> j;
+	int a[] = {1, 2, 3};
+	j.append_row(a, 3);
+	j.append_row();
+	j.append_row(std::vector<int>{4, 5});
+	std::cout << j.size() << " " << j.total_size() << " " << j.row_size(1) << std::endl;
+	for (sjtu::span<int> r : j) {
+		PrintRow(r);
+	}
+	std::cout << std::endl;
+	j[2][0] = 40;
+	for (size_t x : j.offsets()) {
+		std::cout << x << " ";
+	}
+	std::cout << j.values()[3] << std::endl;
+	try {
+		j.row(3);
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "OK" << std::endl;
+	}
+	j.pop_row();
+	std::cout << j.size() << " " << j.total_size() << std::endl;
+
+	sjtu::jagged_vector<std::string>::builder b;
+	b.push_back("x");
+	b.push_back("y");
+	b.finish_row();
+	b.finish_row();
+	b.push_back("z");
+	std::cout << b.open_row_size() << std::endl;
+	sjtu::jagged_vector<std::string> s = b.build();
+	sjtu::jagged_vector<std::string> t = s;
+	t[0][1].append("w");
+	const sjtu::jagged_vector<std::string> &cs = s;
+	for (sjtu::span<const std::string> r : cs) {
+		PrintRow(r);
+	}
+	std::cout << std::endl;
+	for (sjtu::span<std::string> r : t) {
+		PrintRow(r);
+	}
+	std::cout << std::endl;
+	std::cout << b.build().size() << std::endl;
+	// a row of the same object as the source, across reallocations
+	for (int i = 0; i < 4; ++i) {
+		s.append_row(s[0]);
+		s.append_row(cs[2].data(), cs[2].size());
+	}
+	std::cout << s.size() << " " << s.total_size() << " ";
+	PrintRow(s[9]);
+	PrintRow(s[10]);
+	std::cout << std::endl;
+}
+
+void TestNested()
+{
+	std::cout << "Testing conversion from nested vectors..." << std::endl;
+	sjtu::vector<std::vector<int>> nested;
+	for (int i = 0; i < 2000; ++i) {
+		std::vector<int> r(rand64() % 20);
+		for (int &x : r) {
+			x = rand64() % 1000;
+		}
+		nested.push_back(r);
+	}
+	sjtu::jagged_vector<int> j = sjtu::jagged_vector<int>::from_nested(nested);
+	bool same = j.size() == nested.size();
+	long long total = 0;
+	for (size_t i = 0; same && i < nested.size(); ++i) {
+		sjtu::span<const int> r = static_cast<const sjtu::jagged_vector<int> &>(j)[i];
+		same = r.size() == nested[i].size();
+		for (size_t k = 0; same && k < r.size(); ++k) {
+			same = r[k] == nested[i][k];
+			total += r[k];
+		}
+	}
+	sjtu::jagged_vector<int> copy;
+	copy = j;
+	j.clear();
+	std::cout << same << " " << total << " " << copy.size() << " " << j.size() << std::endl;
+}
+
+// pass the number of rows, e.g. 200000
+void Benchmark(size_t rows)
+{
+	sjtu::vector<std::vector<int>> nested;
+	for (size_t i = 0; i < rows; ++i) {
+		std::vector<int> r(rand64() % 16);
+		for (int &x : r) {
+			x = rand64() % 1000;
+		}
+		nested.push_back(r);
+	}
+	sjtu::jagged_vector<int> j = sjtu::jagged_vector<int>::from_nested(nested);
+
+	long long s1 = 0, s2 = 0;
+	double nested_ms = TimeMs([&] {
+		sjtu::vector<std::vector<int>> nested_copy = nested;
+		for (size_t i = 0; i < rows; ++i) {
+			for (int x : nested_copy[i]) {
+				s1 += x;
+			}
+		}
+	});
+	double jagged_ms = TimeMs([&] {
+		sjtu::jagged_vector<int> jagged_copy = j;
+		for (sjtu::span<int> r : jagged_copy) {
+			for (int x : r) {
+				s2 += x;
+			}
+		}
+	});
+	std::cerr << (s1 == s2 ? "" : "FAIL ") << "copy + row sums (ms): nested " << nested_ms << " jagged " << jagged_ms
+	          << std::endl;
+}
+
+int main(int argc, char const *argv[])
+{
+	seed = 1618033988749894ULL;
+	TestBasic();
+	TestNested();
+	if (argc > 1) {
+		Benchmark(std::strtoul(argv[1], nullptr, 10));
+	}
+	return 0;
+}
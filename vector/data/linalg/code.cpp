@@ -0,0 +1,215 @@
+#include "class-matrix-linalg.hpp"
+#include "test-utility.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+// uniform in [-1, 1)
+double RandomUnit()
+{
+	return static_cast<double>(rand64() >> 11) / (1ULL << 52) - 1;
+}
+
+Diamond::Matrix<double> RandomMatrix(size_t rows, size_t cols)
+{
+	Diamond::Matrix<double> a(rows, cols);
+	for (size_t i = 0; i < rows; ++i) {
+		for (size_t j = 0; j < cols; ++j) {
+			a[i][j] = RandomUnit();
+		}
+	}
+	return a;
+}
+
+// B B^T + n I, symmetric positive definite and well conditioned
+Diamond::Matrix<double> RandomSpd(size_t n)
+{
+	Diamond::Matrix<double> b = RandomMatrix(n, n);
+	Diamond::Matrix<double> a(n, n, 0);
+	for (size_t i = 0; i < n; ++i) {
+		for (size_t j = 0; j <= i; ++j) {
+			double s = i == j ? static_cast<double>(n) : 0;
+			for (size_t k = 0; k < n; ++k) {
+				s += b[i][k] * b[j][k];
+			}
+			a[i][j] = a[j][i] = s;
+		}
+	}
+	return a;
+}
+
+// max |A X - B| relative to max |B|
+double Residual(const Diamond::Matrix<double> &a, const Diamond::Matrix<double> &x, const Diamond::Matrix<double> &b)
+{
+	double worst = 0, scale = 0;
+	for (size_t i = 0; i < a.RowSize(); ++i) {
+		for (size_t j = 0; j < x.ColSize(); ++j) {
+			double s = -b[i][j];
+			for (size_t k = 0; k < a.ColSize(); ++k) {
+				s += a[i][k] * x[k][j];
+			}
+			worst = std::max(worst, std::fabs(s));
+			scale = std::max(scale, std::fabs(b[i][j]));
+		}
+	}
+	return worst / scale;
+}
+
+double Residual(const Diamond::Matrix<double> &a, const std::vector<double> &x, const std::vector<double> &b)
+{
+	double worst = 0, scale = 0;
+	for (size_t i = 0; i < a.RowSize(); ++i) {
+		double s = -b[i];
+		for (size_t k = 0; k < a.ColSize(); ++k) {
+			s += a[i][k] * x[k];
+		}
+		worst = std::max(worst, std::fabs(s));
+		scale = std::max(scale, std::fabs(b[i]));
+	}
+	return worst / scale;
+}
+
+std::vector<double> RandomVector(size_t n)
+{
+	std::vector<double> v(n);
+	for (double &x : v) {
+		x = RandomUnit();
+	}
+	return v;
+}
+
+void TestSmall()
+{
+	std::cout << "Testing small systems..." << std::endl;
+	Diamond::Matrix<double> a(3, 3);
+	const double values[3][3] = {{0, 2, 1}, {1, 1, 1}, {2, 1, 3}};
+	for (size_t i = 0; i < 3; ++i) {
+		for (size_t j = 0; j < 3; ++j) {
+			a[i][j] = values[i][j];
+		}
+	}
+	Diamond::LUDecomposition<double> lu(a);
+	std::cout << std::llround(lu.Determinant()) << " " << std::llround(Diamond::Determinant(a)) << " " << lu.IsSingular();
+	for (size_t p : lu.Permutation()) {
+		std::cout << " " << p;
+	}
+	std::cout << std::endl;
+	// P A == L U
+	Diamond::Matrix<double> pa(3, 3);
+	for (size_t i = 0; i < 3; ++i) {
+		for (size_t j = 0; j < 3; ++j) {
+			pa[i][j] = a[lu.Permutation()[i]][j];
+		}
+	}
+	std::cout << (Residual(lu.L(), lu.U(), pa) < 1e-15) << " " << lu.L() << lu.U();
+	std::vector<double> x = lu.Solve(std::vector<double>{3, 3, 6});
+	std::cout << std::llround(x[0]) << " " << std::llround(x[1]) << " " << std::llround(x[2]) << std::endl;
+	std::cout << (Residual(a, Diamond::Inverse(a), Diamond::I<double>(3)) < 1e-15) << std::endl;
+
+	// float runs on the portable gemm kernel
+	Diamond::Matrix<float> af(3, 3);
+	for (size_t i = 0; i < 3; ++i) {
+		for (size_t j = 0; j < 3; ++j) {
+			af[i][j] = static_cast<float>(values[i][j]);
+		}
+	}
+	std::vector<float> xf = Diamond::LUDecomposition<float>(af).Solve(std::vector<float>{3, 3, 6});
+	std::cout << std::lround(Diamond::Determinant(af)) << " " << std::lround(xf[0]) << " " << std::lround(xf[1]) << " "
+	          << std::lround(xf[2]) << std::endl;
+
+	Diamond::Matrix<double> s(2, 2);
+	s[0][0] = 4, s[0][1] = 2, s[1][0] = 2, s[1][1] = 5;
+	Diamond::CholeskyDecomposition<double> chol(s);
+	std::cout << chol.L() << std::llround(chol.Determinant()) << std::endl;
+
+	Diamond::Matrix<double> singular(3, 3, 1);
+	Diamond::LUDecomposition<double> slu(singular);
+	std::cout << slu.IsSingular() << " " << slu.Determinant() << std::endl;
+	try {
+		slu.Solve(std::vector<double>{1, 1, 1});
+	} catch (const std::domain_error &) {
+		std::cout << "domain_error ";
+	}
+	try {
+		Diamond::CholeskyDecomposition<double> bad(a);
+	} catch (const std::domain_error &) {
+		std::cout << "domain_error ";
+	}
+	try {
+		Diamond::LUDecomposition<double> bad(Diamond::Matrix<double>(2, 3));
+	} catch (const std::invalid_argument &) {
+		std::cout << "invalid_argument ";
+	}
+	try {
+		lu.Solve(Diamond::Matrix<double>(2, 1));
+	} catch (const std::invalid_argument &) {
+		std::cout << "invalid_argument";
+	}
+	std::cout << std::endl;
+	Diamond::LUDecomposition<double> empty((Diamond::Matrix<double>()));
+	std::cout << empty.Size() << " " << empty.Determinant() << std::endl;
+}
+
+void TestRandom()
+{
+	std::cout << "Testing random systems..." << std::endl;
+	// sizes around the block and panel boundaries
+	const size_t sizes[] = {1, 2, 7, 8, 9, 31, 33, 100, 127, 128, 129, 255, 300};
+	for (size_t n : sizes) {
+		Diamond::Matrix<double> a = RandomMatrix(n, n);
+		Diamond::Matrix<double> b = RandomMatrix(n, 5);
+		Diamond::LUDecomposition<double> lu(a);
+		std::vector<double> v = RandomVector(n);
+		Diamond::Matrix<double> spd = RandomSpd(n);
+		Diamond::CholeskyDecomposition<double> chol(spd);
+		Diamond::Matrix<double> l = chol.L();
+		bool ok = Residual(a, lu.Solve(b), b) < 1e-10 && Residual(a, lu.Solve(v), v) < 1e-10 &&
+		          Residual(a, lu.Inverse(), Diamond::I<double>(n)) < 1e-10 &&
+		          Residual(spd, chol.Solve(b), b) < 1e-12 && Residual(spd, chol.Solve(v), v) < 1e-12 &&
+		          Residual(l, Diamond::Transpose(l), spd) < 1e-14 &&
+		          Residual(spd, chol.Inverse(), Diamond::I<double>(n)) < 1e-12 &&
+		          // the determinants overflow a double further on
+		          (n > 200 || std::fabs(chol.Determinant() / Diamond::Determinant(spd) - 1) < 1e-9);
+		std::cout << n << (ok ? " OK" : " FAIL") << std::endl;
+	}
+}
+
+// pass the largest size to run, e.g. 8192, run from 256 up by doubling
+void Benchmark(size_t max_n)
+{
+	for (size_t n = 256; n <= max_n; n *= 2) {
+		Diamond::Matrix<double> a = RandomMatrix(n, n);
+		for (size_t i = 0; i < n; ++i) {
+			// diagonally dominant, so it is positive definite after symmetrizing
+			a[i][i] += static_cast<double>(n);
+			for (size_t j = 0; j < i; ++j) {
+				a[j][i] = a[i][j];
+			}
+		}
+		std::vector<double> v = RandomVector(n);
+		std::optional<Diamond::LUDecomposition<double>> lu;
+		std::optional<Diamond::CholeskyDecomposition<double>> chol;
+		double lu_ms = TimeMs([&] { lu.emplace(a); });
+		double chol_ms = TimeMs([&] { chol.emplace(a); });
+		double dn = static_cast<double>(n);
+		bool ok = Residual(a, lu->Solve(v), v) < 1e-9 && Residual(a, chol->Solve(v), v) < 1e-9;
+		std::cerr << (ok ? "" : "FAIL ") << n << ": LU " << 2 * dn * dn * dn / 3 / lu_ms / 1e6 << " GFLOP/s ("
+		          << lu_ms << " ms), Cholesky " << dn * dn * dn / 3 / chol_ms / 1e6 << " GFLOP/s (" << chol_ms
+		          << " ms)" << std::endl;
+	}
+}
+
+int main(int argc, char const *argv[])
+{
+	seed = 1732050807568877ULL;
+	TestSmall();
+	TestRandom();
+	if (argc > 1) {
+		Benchmark(std::strtoul(argv[1], nullptr, 10));
+	}
+	return 0;
+}
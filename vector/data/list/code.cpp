@@ -0,0 +1,408 @@
+#include "intrusive_list.hpp"
+#include "list.hpp"
+#include "test-utility.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <list>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template <typename List>
+void Print(const List &l)
+{
+	for (const auto &x : l) {
+		std::cout << x << " ";
+	}
+	std::cout << "(" << l.size() << ")" << std::endl;
+}
+
+void TestBasic()
+{
+	std::cout << "Testing insert and erase..." << std::endl;
+	sjtu::list<std::string> l;
+	l.push_back("c");
+	l.push_front("b");
+	l.emplace_front(1, 'a');
+	l.emplace_back(2, 'd');
+	Print(l);
+	auto it = l.begin();
+	++it;
+	it = l.insert(it, "x");
+	l.insert(l.end(), std::string(30, 'z'));
+	Print(l);
+	it = l.erase(it);
+	std::cout << *it << " " << it->size() << " " << l.front() << " " << l.back().size() << std::endl;
+	l.pop_front();
+	l.pop_back();
+	Print(l);
+	sjtu::list<std::string> copy(l);
+	l.clear();
+	l.push_back("y");
+	Print(l);
+	Print(copy);
+	copy = l;
+	Print(copy);
+	sjtu::list<std::string> moved(std::move(copy));
+	std::cout << copy.empty() << " " << moved.front() << std::endl;
+	try {
+		copy.pop_back();
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "OK" << std::endl;
+	}
+	try {
+		moved.erase(moved.end());
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::invalid_iterator &) {
+		std::cout << "OK" << std::endl;
+	}
+	sjtu::list<int> a, b;
+	for (int i = 0; i < 5; ++i) {
+		a.push_back(i);
+		b.push_back(i * 10);
+	}
+	a.swap(b);
+	Print(a);
+	Print(b);
+	b = std::move(a);
+	Print(b);
+	b.reverse();
+	Print(b);
+	std::cout << b.remove_if([](int x) { return x % 20 == 0; }) << std::endl;
+	Print(b);
+}
+
+void TestSplice()
+{
+	std::cout << "Testing splice..." << std::endl;
+	sjtu::list<int> a, b;
+	for (int i = 0; i < 6; ++i) {
+		a.push_back(i);
+		b.push_back(100 + i);
+	}
+	auto kept = b.begin();
+	++kept;
+	int *address = &*kept;
+	// a and b have pools of their own, the element is moved into a new node
+	a.splice(a.begin(), b, kept);
+	std::cout << (&a.front() == address) << " ";
+	Print(a);
+	auto first = b.begin();
+	++first;
+	auto last = first;
+	++last;
+	++last;
+	a.splice(a.end(), b, first, last);
+	Print(a);
+	Print(b);
+	// within one list
+	auto mid = a.begin();
+	for (int i = 0; i < 4; ++i) {
+		++mid;
+	}
+	a.splice(a.begin(), a, mid, a.end());
+	Print(a);
+	a.splice(a.end(), b);
+	Print(a);
+	std::cout << b.empty() << " " << (b.pool().capacity() == 0) << std::endl;
+	// a list's own pool cannot be shared: its slabs follow the list's nodes
+	static_assert(!std::is_constructible_v<sjtu::list<int>, decltype(a.pool())>);
+	static_assert(std::is_constructible_v<sjtu::list<int>, sjtu::list_pool<int> &>);
+	b.push_back(7);
+	Print(b);
+
+	sjtu::list_pool<std::string> pool;
+	{
+		sjtu::list<std::string> x(pool), y(pool), z;
+		for (int i = 0; i < 4; ++i) {
+			x.push_back(std::string(20, 'a' + i));
+			y.push_back(std::to_string(i));
+			z.push_back("z" + std::to_string(i));
+		}
+		std::string *s = &*++x.begin();
+		y.splice(y.begin(), x, ++x.begin());
+		std::cout << (&y.front() == s) << " ";
+		Print(y);
+		// partial splice between pools moves the elements
+		y.splice(y.end(), z, z.begin(), ++ ++z.begin());
+		Print(y);
+		Print(z);
+		x.splice(x.begin(), z);
+		Print(x);
+		std::cout << (&x.pool() == &pool) << " " << (pool.capacity() >= 32) << std::endl;
+		sjtu::list<std::string> w(pool);
+		w.push_back("w");
+		z.push_back("zz");
+		z.splice(z.end(), w);
+		Print(z);
+		z.merge(x, [](const std::string &p, const std::string &q) { return p.size() < q.size(); });
+		Print(z);
+		std::cout << x.empty() << std::endl;
+	}
+}
+
+struct Item {
+	int key;
+	int order;
+	bool operator<(const Item &rhs) const { return key < rhs.key; }
+};
+
+void TestSort()
+{
+	std::cout << "Testing sort and merge..." << std::endl;
+	bool ok = true;
+	for (int round = 0; round < 50; ++round) {
+		int n = rand64() % 2000;
+		sjtu::list<Item> l;
+		std::vector<Item> ref;
+		std::vector<const Item *> addresses;
+		for (int i = 0; i < n; ++i) {
+			Item x{static_cast<int>(rand64() % 100), i};
+			l.push_back(x);
+			ref.push_back(x);
+		}
+		for (const Item &x : l) {
+			addresses.push_back(&x);
+		}
+		l.sort();
+		std::stable_sort(ref.begin(), ref.end());
+		size_t i = 0;
+		for (const Item &x : l) {
+			if (x.key != ref[i].key || x.order != ref[i].order || &x != addresses[x.order]) {
+				ok = false;
+			}
+			++i;
+		}
+		auto back = l.end();
+		for (int j = n - 1; j >= 0; --j) {
+			--back;
+			if (back->order != ref[j].order) {
+				ok = false;
+			}
+		}
+		if (i != static_cast<size_t>(n) || l.size() != static_cast<size_t>(n)) {
+			ok = false;
+		}
+		sjtu::list<Item> other;
+		std::vector<Item> ref2;
+		for (int j = 0; j < n / 2; ++j) {
+			Item x{static_cast<int>(rand64() % 100), n + j};
+			other.push_back(x);
+			ref2.push_back(x);
+		}
+		other.sort();
+		std::stable_sort(ref2.begin(), ref2.end());
+		std::vector<Item> merged;
+		std::merge(ref.begin(), ref.end(), ref2.begin(), ref2.end(), std::back_inserter(merged));
+		l.merge(other);
+		i = 0;
+		for (const Item &x : l) {
+			if (x.order != merged[i].order) {
+				ok = false;
+			}
+			++i;
+		}
+		if (i != merged.size() || !other.empty()) {
+			ok = false;
+		}
+	}
+	std::cout << (ok ? "OK" : "FAIL") << std::endl;
+
+	sjtu::list<int> l;
+	for (int i = 0; i < 1000; ++i) {
+		l.push_back(rand64() % 1000);
+	}
+	long long sum = 0;
+	for (int x : l) {
+		sum += x;
+	}
+	int calls = 0;
+	try {
+		l.sort([&calls](int x, int y) {
+			if (++calls == 3000) {
+				throw sjtu::runtime_error();
+			}
+			return x < y;
+		});
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::runtime_error &) {
+		long long after = 0;
+		size_t count = 0;
+		for (int x : l) {
+			after += x;
+			++count;
+		}
+		size_t backwards = 0;
+		for (auto it = l.end(); it != l.begin(); --it) {
+			++backwards;
+		}
+		std::cout << (after == sum) << " " << count << " " << backwards << " " << l.size() << std::endl;
+	}
+	l.sort([](int x, int y) { return x > y; });
+	std::cout << std::is_sorted(l.begin(), l.end(), [](int x, int y) { return x > y; }) << std::endl;
+}
+
+struct lru_tag { };
+struct free_tag { };
+
+struct Entry : sjtu::intrusive_list_hook<lru_tag>, sjtu::intrusive_list_hook<free_tag> {
+	int key = -1;
+	long long value = 0;
+};
+
+void TestIntrusive()
+{
+	std::cout << "Testing intrusive list..." << std::endl;
+	std::vector<Entry> storage(4);
+	sjtu::intrusive_list<Entry, lru_tag> lru;
+	sjtu::intrusive_list<Entry, free_tag> free_list;
+	for (Entry &e : storage) {
+		free_list.push_back(e);
+	}
+	std::cout << free_list.size() << " " << lru.empty() << " " << storage[0].sjtu::intrusive_list_hook<free_tag>::is_linked() << std::endl;
+	try {
+		free_list.push_back(storage[1]);
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::invalid_iterator &) {
+		std::cout << "OK" << std::endl;
+	}
+	Entry copy = storage[0];
+	std::cout << copy.sjtu::intrusive_list_hook<free_tag>::is_linked() << std::endl;
+
+	// a four-entry LRU cache against a reference built on std::list
+	const int kCapacity = 4;
+	std::list<std::pair<int, long long>> ref;
+	long long hits = 0, ref_hits = 0;
+	bool ok = true;
+	for (int op = 0; op < 100000; ++op) {
+		int key = rand64() % 7;
+		Entry *found = nullptr;
+		for (Entry &e : lru) {
+			if (e.key == key) {
+				found = &e;
+				break;
+			}
+		}
+		if (found != nullptr) {
+			lru.move_to_front(*found);
+			++hits;
+		} else {
+			Entry &e = free_list.empty() ? lru.pop_back() : free_list.pop_front();
+			e.key = key;
+			e.value = op;
+			lru.push_front(e);
+		}
+		auto r = std::find_if(ref.begin(), ref.end(), [key](const std::pair<int, long long> &p) { return p.first == key; });
+		if (r != ref.end()) {
+			ref.splice(ref.begin(), ref, r);
+			++ref_hits;
+		} else {
+			if (static_cast<int>(ref.size()) == kCapacity) {
+				ref.pop_back();
+			}
+			ref.emplace_front(key, op);
+		}
+		if (op % 1000 == 0) {
+			// evict one entry back to the free list
+			Entry &victim = lru.back();
+			lru.erase(victim);
+			free_list.push_back(victim);
+			ref.pop_back();
+		}
+	}
+	auto r = ref.begin();
+	for (const Entry &e : lru) {
+		if (r == ref.end() || e.key != r->first || e.value != r->second) {
+			ok = false;
+		} else {
+			++r;
+		}
+	}
+	std::cout << (ok && r == ref.end() && hits == ref_hits) << " " << hits << " " << lru.size() + free_list.size() << std::endl;
+	sjtu::intrusive_list<Entry, lru_tag> other(std::move(lru));
+	std::cout << lru.size() << " " << other.size() << std::endl;
+	other.move_to_back(other.front());
+	other.erase(other.begin());
+	lru.splice(lru.end(), other);
+	std::cout << lru.size() << " " << other.size() << std::endl;
+	lru.clear();
+	free_list.clear();
+	bool unlinked = true;
+	for (const Entry &e : storage) {
+		if (e.sjtu::intrusive_list_hook<lru_tag>::is_linked() || e.sjtu::intrusive_list_hook<free_tag>::is_linked()) {
+			unlinked = false;
+		}
+	}
+	std::cout << unlinked << std::endl;
+}
+
+/**
+ * an insert/erase-heavy trace: elements are inserted next to and erased
+ * at random positions remembered by iterator.
+ */
+template <typename List>
+long long RunTrace(int ops)
+{
+	List l;
+	std::vector<typename List::iterator> its;
+	unsigned long long s = 161803398874989ULL;
+	auto next = [&s]() {
+		s ^= s << 13;
+		s ^= s >> 7;
+		s ^= s << 17;
+		return s;
+	};
+	for (int op = 0; op < ops; ++op) {
+		unsigned long long r = next();
+		if (its.empty() || r % 8 < 5) {
+			typename List::iterator pos = its.empty() ? l.end() : its[r % its.size()];
+			its.push_back(l.insert(pos, static_cast<long long>(op)));
+		} else {
+			size_t i = r % its.size();
+			l.erase(its[i]);
+			its[i] = its.back();
+			its.pop_back();
+		}
+	}
+	// unsigned, so the checksum wraps instead of overflowing
+	unsigned long long checksum = 0, k = 0;
+	for (long long x : l) {
+		checksum = checksum * 31 + static_cast<unsigned long long>(x) + (++k);
+	}
+	return static_cast<long long>(checksum ^ l.size());
+}
+
+void TestTrace()
+{
+	std::cout << "Testing an insert/erase trace..." << std::endl;
+	const int kOps = 200000;
+	std::cout << (RunTrace<sjtu::list<long long>>(kOps) == RunTrace<std::list<long long>>(kOps)) << std::endl;
+}
+
+// pass the length of the trace, e.g. 3000000
+void Benchmark(int ops)
+{
+	long long expected = 0, got = 0;
+	double std_ms = TimeMs([&] { expected = RunTrace<std::list<long long>>(ops); });
+	double sjtu_ms = TimeMs([&] { got = RunTrace<sjtu::list<long long>>(ops); });
+	std::cerr << (got == expected ? "" : "FAIL ") << "trace of " << ops << " ops (ms): std::list " << std_ms
+	          << " sjtu::list " << sjtu_ms << std::endl;
+}
+
+int main(int argc, char const *argv[])
+{
+	seed = 1732050807568877ULL;
+	TestBasic();
+	TestSplice();
+	TestSort();
+	TestIntrusive();
+	TestTrace();
+	if (argc > 1) {
+		Benchmark(std::atoi(argv[1]));
+	}
+	return 0;
+}
@@ -0,0 +1,295 @@
+#include "range_query.hpp"
+#include "vector.hpp"
+#include "test-utility.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+template <typename T>
+void Print(const sjtu::vector<T> &v)
+{
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v[i] << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestFenwick()
+{
+	std::cout << "Testing fenwick_tree..." << std::endl;
+	sjtu::vector<long long> v;
+	for (int i = 1; i <= 10; ++i) {
+		v.push_back(i);
+	}
+	sjtu::fenwick_tree<long long> f(v);
+	std::cout << f.size() << " " << f.prefix_sum(0) << " " << f.prefix_sum(10) << " " << f.sum(2, 5) << " " << f.get(6) << std::endl;
+	f.add(3, 100);
+	f.set(0, -5);
+	Print(f.values());
+	std::cout << f.lower_bound(1) << " " << f.lower_bound(100) << " " << f.lower_bound(200) << " " << f.lower_bound(0) << std::endl;
+	sjtu::vector<sjtu::index_range> ranges;
+	ranges.push_back(sjtu::index_range{0, 10});
+	ranges.push_back(sjtu::index_range{4, 4});
+	ranges.push_back(sjtu::index_range{3, 4});
+	Print(f.sum(ranges));
+	try {
+		f.sum(5, 11);
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "OK" << std::endl;
+	}
+
+	bool ok = true;
+	const int kN = 1000;
+	std::vector<long long> ref(kN);
+	sjtu::fenwick_tree<long long> g(kN);
+	for (int op = 0; op < 100000; ++op) {
+		size_t i = rand64() % kN;
+		if (op % 3 == 0) {
+			long long d = rand64() % 1000;
+			g.add(i, d);
+			ref[i] += d;
+		} else if (op % 1000 == 1) {
+			sjtu::vector<long long> deltas;
+			for (int j = 0; j < kN; ++j) {
+				long long d = rand64() % 10;
+				deltas.push_back(d);
+				ref[j] += d;
+			}
+			g.add(deltas);
+		} else {
+			size_t j = rand64() % (kN + 1);
+			size_t l = std::min(i, j), r = std::max(i, j);
+			if (g.sum(l, r) != std::accumulate(ref.begin() + l, ref.begin() + r, 0LL)) {
+				ok = false;
+			}
+		}
+	}
+	long long total = std::accumulate(ref.begin(), ref.end(), 0LL);
+	for (int q = 0; q < 1000; ++q) {
+		long long target = rand64() % (total + 10);
+		size_t n = g.lower_bound(target);
+		long long prefix = 0;
+		size_t expected = 0;
+		while (expected <= static_cast<size_t>(kN) && prefix < target) {
+			if (expected < static_cast<size_t>(kN)) {
+				prefix += ref[expected];
+			}
+			++expected;
+		}
+		if (n != expected) {
+			ok = false;
+		}
+	}
+	std::cout << (ok ? "OK" : "FAIL") << std::endl;
+}
+
+void TestSparseTable()
+{
+	std::cout << "Testing sparse_table..." << std::endl;
+	sjtu::vector<int> v;
+	int data[] = {5, 2, 8, 6, 3, 7, 1, 9, 4};
+	for (int x : data) {
+		v.push_back(x);
+	}
+	sjtu::sparse_table<int> mn(v);
+	sjtu::sparse_table<int, sjtu::range_max<int>> mx(v);
+	std::cout << mn.query(0, 9) << " " << mn.query(2, 6) << " " << mx.query(0, 9) << " " << mx.query(2, 6) << " " << mn.query(4, 5) << std::endl;
+	auto gcd = [](int a, int b) { return std::gcd(a, b); };
+	sjtu::vector<int> w;
+	int wdata[] = {12, 18, 24, 9, 27, 81};
+	for (int x : wdata) {
+		w.push_back(x);
+	}
+	sjtu::sparse_table<int, decltype(gcd)> g(w, gcd);
+	std::cout << g.query(0, 3) << " " << g.query(3, 6) << " " << g.query(0, 6) << std::endl;
+	try {
+		mn.query(3, 3);
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "OK" << std::endl;
+	}
+	sjtu::sparse_table<int> empty((sjtu::vector<int>()));
+	std::cout << empty.size() << std::endl;
+
+	bool ok = true;
+	for (int round = 0; round < 20; ++round) {
+		size_t n = 1 + rand64() % 700;
+		sjtu::vector<long long> values;
+		for (size_t i = 0; i < n; ++i) {
+			values.push_back(static_cast<long long>(rand64() % 2000) - 1000);
+		}
+		sjtu::sparse_table<long long> t(values);
+		sjtu::vector<sjtu::index_range> ranges;
+		for (int q = 0; q < 500; ++q) {
+			size_t l = rand64() % n;
+			size_t r = l + 1 + rand64() % (n - l);
+			ranges.push_back(sjtu::index_range{l, r});
+		}
+		sjtu::vector<long long> answers = t.query(ranges);
+		for (size_t q = 0; q < ranges.size(); ++q) {
+			long long expected = *std::min_element(values.data() + ranges[q].begin, values.data() + ranges[q].end);
+			if (answers[q] != expected) {
+				ok = false;
+			}
+		}
+	}
+	std::cout << (ok ? "OK" : "FAIL") << std::endl;
+}
+
+using SumTree = sjtu::segment_tree<sjtu::range_add_sum<long long>>;
+using MinTree = sjtu::segment_tree<sjtu::range_add_min<long long, LLONG_MAX>>;
+using MaxTree = sjtu::segment_tree<sjtu::range_add_max<long long, LLONG_MIN>>;
+
+void TestSegmentTree()
+{
+	std::cout << "Testing segment_tree..." << std::endl;
+	sjtu::vector<long long> v;
+	for (int i = 0; i < 7; ++i) {
+		v.push_back(i * i);
+	}
+	SumTree s(v);
+	MinTree mn(v);
+	std::cout << s.all() << " " << s.query(1, 4) << " " << mn.query(2, 7) << std::endl;
+	s.apply(2, 5, 10);
+	mn.apply(0, 3, 100);
+	std::cout << s.all() << " " << s.query(4, 7) << " " << s.get(2) << " " << mn.query(0, 7) << " " << mn.get(1) << std::endl;
+	s.set(3, -1);
+	Print(s.values());
+	Print(mn.values());
+	SumTree zeros(5);
+	zeros.apply(0, 5, 3);
+	std::cout << zeros.all() << " " << zeros.query(2, 2) << std::endl;
+	try {
+		s.apply(3, 8, 1);
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "OK" << std::endl;
+	}
+
+	bool ok = true;
+	for (int round = 0; round < 20; ++round) {
+		size_t n = 1 + rand64() % 300;
+		std::vector<long long> ref(n);
+		sjtu::vector<long long> values;
+		for (size_t i = 0; i < n; ++i) {
+			ref[i] = static_cast<long long>(rand64() % 2000) - 1000;
+			values.push_back(ref[i]);
+		}
+		SumTree sum(values);
+		MinTree lo(values);
+		MaxTree hi(values);
+		for (int op = 0; op < 2000; ++op) {
+			size_t l = rand64() % n;
+			size_t r = l + 1 + rand64() % (n - l);
+			int kind = rand64() % 4;
+			if (kind == 0) {
+				long long d = static_cast<long long>(rand64() % 200) - 100;
+				sum.apply(l, r, d);
+				lo.apply(l, r, d);
+				hi.apply(l, r, d);
+				for (size_t i = l; i < r; ++i) {
+					ref[i] += d;
+				}
+			} else if (kind == 1) {
+				long long x = static_cast<long long>(rand64() % 2000) - 1000;
+				sum.set(l, x);
+				lo.set(l, x);
+				hi.set(l, x);
+				ref[l] = x;
+			} else {
+				long long expected_sum = std::accumulate(ref.begin() + l, ref.begin() + r, 0LL);
+				long long expected_min = *std::min_element(ref.begin() + l, ref.begin() + r);
+				long long expected_max = *std::max_element(ref.begin() + l, ref.begin() + r);
+				if (sum.query(l, r) != expected_sum || lo.query(l, r) != expected_min || hi.query(l, r) != expected_max ||
+				    sum.get(l) != ref[l]) {
+					ok = false;
+				}
+			}
+		}
+		if (sum.all() != std::accumulate(ref.begin(), ref.end(), 0LL)) {
+			ok = false;
+		}
+		sjtu::vector<long long> back = lo.values();
+		for (size_t i = 0; i < n; ++i) {
+			if (back[i] != ref[i]) {
+				ok = false;
+			}
+		}
+	}
+	std::cout << (ok ? "OK" : "FAIL") << std::endl;
+}
+
+struct QueryRun {
+	long long scan = 0, fast = 0;
+	double scan_ms = 0, fast_ms = 0;
+};
+
+// queries sum and min over random ranges of n values, by scanning and with the trees
+QueryRun RunQueries(size_t n, size_t queries)
+{
+	sjtu::vector<long long> values;
+	for (size_t i = 0; i < n; ++i) {
+		values.push_back(rand64() % 1000000);
+	}
+	sjtu::vector<sjtu::index_range> ranges;
+	for (size_t q = 0; q < queries; ++q) {
+		size_t l = rand64() % n;
+		size_t r = l + 1 + rand64() % (n - l);
+		ranges.push_back(sjtu::index_range{l, r});
+	}
+	QueryRun run;
+	run.scan_ms = TimeMs([&] {
+		for (size_t q = 0; q < queries; ++q) {
+			long long s = 0, m = LLONG_MAX;
+			for (size_t i = ranges[q].begin; i < ranges[q].end; ++i) {
+				s += values[i];
+				m = std::min(m, values[i]);
+			}
+			run.scan += s ^ m;
+		}
+	});
+	run.fast_ms = TimeMs([&] {
+		sjtu::fenwick_tree<long long> f(values);
+		sjtu::sparse_table<long long> t(values);
+		sjtu::vector<long long> sums = f.sum(ranges);
+		sjtu::vector<long long> mins = t.query(ranges);
+		for (size_t q = 0; q < queries; ++q) {
+			run.fast += sums[q] ^ mins[q];
+		}
+	});
+	return run;
+}
+
+void TestScanning()
+{
+	std::cout << "Testing range queries against scanning..." << std::endl;
+	QueryRun run = RunQueries(20000, 2000);
+	std::cout << (run.scan == run.fast) << std::endl;
+}
+
+// pass the number of values, e.g. 200000
+void Benchmark(size_t n)
+{
+	const size_t kQueries = 2000;
+	QueryRun run = RunQueries(n, kQueries);
+	std::cerr << (run.scan == run.fast ? "" : "FAIL ") << kQueries << " sum+min queries over " << n
+	          << " values (ms): scanning " << run.scan_ms << " build+query " << run.fast_ms << std::endl;
+}
+
+int main(int argc, char const *argv[])
+{
+	seed = 2236067977499789ULL;
+	TestFenwick();
+	TestSparseTable();
+	TestSegmentTree();
+	TestScanning();
+	if (argc > 1) {
+		Benchmark(std::strtoul(argv[1], nullptr, 10));
+	}
+	return 0;
+}
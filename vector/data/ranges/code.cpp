@@ -0,0 +1,178 @@
+#include "compressed_vector.hpp"
+#include "devector.hpp"
+#include "inplace_vector.hpp"
+#include "jagged_vector.hpp"
+#include "span.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <new>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static_assert(std::ranges::contiguous_range<sjtu::vector<int>>);
+static_assert(std::ranges::contiguous_range<const sjtu::vector<int>>);
+static_assert(std::ranges::sized_range<sjtu::vector<std::string>>);
+static_assert(std::ranges::contiguous_range<sjtu::devector<int>>);
+static_assert(std::ranges::sized_range<sjtu::devector<int>>);
+static_assert(std::ranges::contiguous_range<sjtu::inplace_vector<int, 8>>);
+static_assert(std::ranges::sized_range<sjtu::inplace_vector<std::string, 8>>);
+static_assert(std::ranges::contiguous_range<sjtu::span<int>>);
+static_assert(std::ranges::view<sjtu::span<const int>>);
+static_assert(std::ranges::random_access_range<sjtu::strided_span<double>>);
+static_assert(std::ranges::sized_range<sjtu::strided_span<double>>);
+static_assert(std::ranges::random_access_range<sjtu::jagged_vector<int>>);
+static_assert(std::ranges::random_access_range<const sjtu::jagged_vector<int>>);
+static_assert(std::ranges::forward_range<sjtu::compressed_int_vector>);
+
+template <typename R>
+void Print(const R &r)
+{
+	for (const auto &x : r) {
+		std::cout << x << " ";
+	}
+	std::cout << std::endl;
+}
+
+void TestConcepts()
+{
+	std::cout << "Testing range algorithms..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back((i * 7) % 10);
+	}
+	std::ranges::sort(v);
+	Print(v);
+	std::cout << std::ranges::count_if(v, [](int x) { return x % 3 == 0; }) << " "
+	          << *std::ranges::max_element(v) << " " << std::ranges::size(v) << " "
+	          << (std::ranges::data(v) == v.data()) << std::endl;
+	Print(v | std::views::reverse | std::views::take(3));
+	sjtu::span<int> s(v);
+	Print(s.subspan(2, 3) | std::views::transform([](int x) { return x * x; }));
+
+	double grid[12];
+	for (int i = 0; i < 12; ++i) {
+		grid[i] = i;
+	}
+	sjtu::strided_span<double> col = sjtu::strided_span<double>::column(sjtu::span<double>(grid), 4, 1);
+	std::ranges::reverse(col);
+	Print(col);
+
+	sjtu::jagged_vector<int> j;
+	std::vector<int> r0 = {3, 1, 2};
+	j.append_row(r0);
+	j.append_row(std::views::iota(0, 5));
+	j.append_row(std::views::iota(0, 20) | std::views::filter([](int x) { return x % 7 == 0; }));
+	auto sizes = j | std::views::transform([](sjtu::span<int> r) { return r.size(); });
+	Print(sizes);
+	std::cout << (std::ranges::find_if(j, [](sjtu::span<int> r) { return r.size() == 5; }) - j.begin())
+	          << std::endl;
+
+	sjtu::compressed_int_vector c;
+	for (int i = 0; i < 300; ++i) {
+		c.push_back(i * 3);
+	}
+	std::cout << std::ranges::count_if(c, [](long long x) { return x % 2 == 0; }) << " "
+	          << *std::ranges::find_if(c, [](long long x) { return x > 500; }) << std::endl;
+}
+
+void TestFromRange()
+{
+	std::cout << "Testing from_range..." << std::endl;
+	sjtu::vector<int> a(sjtu::from_range, std::views::iota(0, 1000));
+	std::cout << a.size() << " " << a.capacity() << " " << a[999] << std::endl;
+
+	// forward but not sized: counted first, then filled into one allocation
+	auto odd_squares = std::views::iota(0, 100) | std::views::filter([](int x) { return x % 2; }) |
+	                   std::views::transform([](int x) { return x * x; });
+	sjtu::vector<long long> b(sjtu::from_range, odd_squares);
+	std::cout << b.size() << " " << b.capacity() << " " << b[0] << " " << b[49] << std::endl;
+
+	sjtu::vector<std::string> words(sjtu::from_range, std::views::iota(1, 6) | std::views::transform([](int x) {
+		                                return std::string(x, 'a' + x);
+	                                }));
+	Print(words);
+
+	// single pass: grows as it goes
+	std::istringstream in("5 4 3 2 1 0");
+	sjtu::vector<int> c(sjtu::from_range, std::views::istream<int>(in));
+	Print(c);
+
+	std::vector<int> src = {1, 2, 3, 4};
+	sjtu::devector<int> d(sjtu::from_range, src);
+	d.push_front(0);
+	Print(d);
+	sjtu::inplace_vector<int, 4> iv(sjtu::from_range, src | std::views::reverse);
+	Print(iv);
+	try {
+		sjtu::inplace_vector<int, 3> small(sjtu::from_range, src);
+		std::cout << "FAIL" << std::endl;
+	} catch (std::bad_alloc &) {
+		std::cout << "too long for inplace_vector" << std::endl;
+	}
+
+	// a throwing element leaves nothing behind, the leak check sees it
+	auto failing = std::views::iota(0, 10) | std::views::transform([](int x) {
+		               if (x == 7) {
+			               throw sjtu::runtime_error();
+		               }
+		               return std::string(30, 'a' + x);
+	               });
+	int thrown = 0;
+	try {
+		sjtu::vector<std::string> v(sjtu::from_range, failing);
+	} catch (sjtu::runtime_error &) {
+		++thrown;
+	}
+	try {
+		sjtu::devector<std::string> dv(sjtu::from_range, failing);
+	} catch (sjtu::runtime_error &) {
+		++thrown;
+	}
+	try {
+		sjtu::inplace_vector<std::string, 10> ivs(sjtu::from_range, failing);
+	} catch (sjtu::runtime_error &) {
+		++thrown;
+	}
+	std::cout << thrown << std::endl;
+}
+
+void TestAppendRange()
+{
+	std::cout << "Testing append_range..." << std::endl;
+	sjtu::vector<int> v(sjtu::from_range, std::views::iota(0, 4));
+	v.append_range(std::views::iota(10, 14));
+	std::vector<int> more = {7, 8, 9};
+	v.append_range(more);
+	v.append_range(sjtu::span<const int>(more).first(1));
+	Print(v);
+	std::cout << v.capacity() << std::endl;
+
+	sjtu::devector<std::string> d;
+	d.push_back("x");
+	d.append_range(std::views::iota(0, 3) | std::views::transform([](int x) { return std::to_string(x); }));
+	Print(d);
+
+	sjtu::inplace_vector<int, 6> iv;
+	iv.append_range(std::views::iota(0, 4));
+	try {
+		iv.append_range(std::views::iota(0, 4));
+	} catch (std::bad_alloc &) {
+		std::cout << "kept " << iv.size() << std::endl;
+	}
+
+	auto nested = sjtu::jagged_vector<int>::from_nested(
+	    std::views::iota(1, 5) | std::views::transform([](int n) { return std::views::iota(0, n); }));
+	std::cout << nested.size() << " " << nested.total_size() << " " << nested[3][3] << std::endl;
+}
+
+int main()
+{
+	TestConcepts();
+	TestFromRange();
+	TestAppendRange();
+	return 0;
+}
@@ -0,0 +1,171 @@
+#include "vector.hpp"
+#include "simd_algorithm.hpp"
+#include "test-utility.hpp"
+
+#include <cstdlib>
+#include <iostream>
+
+template <typename T>
+bool CheckAll(const sjtu::vector<T> &v, const sjtu::vector<T> &needles)
+{
+	for (size_t k = 0; k < needles.size(); ++k) {
+		T x = needles[k];
+		size_t idx = v.size(), cnt = 0;
+		for (size_t i = 0; i < v.size(); ++i) {
+			if (v[i] == x) {
+				idx = idx == v.size() ? i : idx;
+				++cnt;
+			}
+		}
+		if (sjtu::find(v, x) != idx || sjtu::count(v, x) != cnt) {
+			return false;
+		}
+		sjtu::vector<T> one;
+		one.push_back(x);
+		if (sjtu::contains_any(v, one) != (cnt > 0)) {
+			return false;
+		}
+	}
+	if (!v.empty()) {
+		T mn = v[0], mx = v[0];
+		for (size_t i = 0; i < v.size(); ++i) {
+			mn = v[i] < mn ? v[i] : mn;
+			mx = mx < v[i] ? v[i] : mx;
+		}
+		sjtu::pair<T, T> res = sjtu::minmax(v);
+		if (res.first != mn || res.second != mx) {
+			return false;
+		}
+	}
+	sjtu::vector<T> w = v;
+	if (!sjtu::equal(v, w)) {
+		return false;
+	}
+	if (!w.empty()) {
+		w[w.size() - 1] = w[w.size() - 1] + 1;
+		if (sjtu::equal(v, w)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void TestInt()
+{
+	std::cout << "Testing int kernels..." << std::endl;
+	for (size_t n : {0, 1, 7, 8, 31, 32, 33, 1000, 100003}) {
+		sjtu::vector<int> v;
+		long long s = 0;
+		for (size_t i = 0; i < n; ++i) {
+			int x = (int)(rand64() % 2000) - 1000;
+			v.push_back(x);
+			s += x;
+		}
+		sjtu::vector<int> needles;
+		needles.push_back(0);
+		needles.push_back(999);
+		needles.push_back(-1000);
+		needles.push_back(5000);
+		if (!CheckAll(v, needles) || sjtu::sum(v) != s) {
+			std::cout << "FAIL at n = " << n << std::endl;
+			return;
+		}
+	}
+	sjtu::vector<int> big;
+	for (int i = 0; i < 1000; ++i) {
+		big.push_back(2000000000);
+	}
+	std::cout << sjtu::sum(big) << std::endl;
+	sjtu::vector<int> none;
+	none.push_back(-5);
+	none.push_back(7);
+	std::cout << sjtu::contains_any(big, none) << std::endl;
+	none.push_back(2000000000);
+	std::cout << sjtu::contains_any(big, none) << std::endl;
+	std::cout << "OK" << std::endl;
+}
+
+void TestDouble()
+{
+	std::cout << "Testing double kernels..." << std::endl;
+	for (size_t n : {0, 1, 3, 4, 15, 16, 17, 1000, 100003}) {
+		sjtu::vector<double> v;
+		for (size_t i = 0; i < n; ++i) {
+			v.push_back(((int)(rand64() % 2000) - 1000) / 4.0);
+		}
+		sjtu::vector<double> needles;
+		needles.push_back(0.25);
+		needles.push_back(-250.0);
+		needles.push_back(0.1);
+		if (!CheckAll(v, needles)) {
+			std::cout << "FAIL at n = " << n << std::endl;
+			return;
+		}
+	}
+	sjtu::vector<double> v;
+	for (int i = 1; i <= 1000; ++i) {
+		v.push_back(i * 0.5);
+	}
+	std::cout << sjtu::sum(v) << std::endl;
+	sjtu::vector<double> z, nz;
+	z.push_back(0.0);
+	nz.push_back(-0.0);
+	std::cout << sjtu::equal(z, nz) << std::endl;
+	std::cout << "OK" << std::endl;
+}
+
+void TestOther()
+{
+	std::cout << "Testing scalar fallback..." << std::endl;
+	sjtu::vector<long long> v;
+	for (long long i = 0; i < 100; ++i) {
+		v.push_back(i * i);
+	}
+	sjtu::pair<long long, long long> res = sjtu::minmax(v);
+	std::cout << sjtu::find(v, 49LL) << " " << sjtu::count(v, 49LL) << " " << res.first << " " << res.second << " " << sjtu::sum(v) << std::endl;
+	try {
+		sjtu::minmax(sjtu::vector<int>());
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "OK" << std::endl;
+	}
+}
+
+// pass the number of elements, e.g. 10000000
+void Benchmark(size_t n)
+{
+	sjtu::vector<int> v;
+	for (size_t i = 0; i < n; ++i) {
+		v.push_back(static_cast<int>(i));
+	}
+	volatile long long sink = 0;
+	std::cerr << "find (ms): operator[] " << TimeMs([&] {
+		for (size_t i = 0; i < v.size(); ++i) {
+			if (v[i] == -1) {
+				sink = i;
+				break;
+			}
+		}
+	});
+	std::cerr << " simd " << TimeMs([&] { sink = sjtu::find(v, -1); }) << std::endl;
+	std::cerr << "sum (ms): operator[] " << TimeMs([&] {
+		long long s = 0;
+		for (size_t i = 0; i < v.size(); ++i) {
+			s += v[i];
+		}
+		sink = s;
+	});
+	std::cerr << " simd " << TimeMs([&] { sink = sjtu::sum(v); }) << std::endl;
+}
+
+int main(int argc, char const *argv[])
+{
+	seed = 1926081719260817ULL;
+	TestInt();
+	TestDouble();
+	TestOther();
+	if (argc > 1) {
+		Benchmark(std::strtoul(argv[1], nullptr, 10));
+	}
+	return 0;
+}
@@ -0,0 +1,87 @@
+#include "slot_map.hpp"
+#include "test-utility.hpp"
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+void TestBasic()
+{
+	std::cout << "Testing insert and erase..." << std::endl;
+	sjtu::slot_map<std::string> m;
+	sjtu::slot_map<std::string>::handle a = m.insert("alpha");
+	sjtu::slot_map<std::string>::handle b = m.insert("beta");
+	sjtu::slot_map<std::string>::handle c = m.insert("gamma");
+	m.erase(a);
+	std::cout << m.size() << " " << m[b] << " " << m[c] << " " << m.contains(a) << std::endl;
+	std::cout << m.index_of(c) << " " << (m.handle_at(0) == c) << std::endl;
+	sjtu::slot_map<std::string>::handle d = m.insert("delta");
+	std::cout << (d != a) << " " << (static_cast<unsigned>(d) == static_cast<unsigned>(a)) << std::endl;
+	try {
+		m.at(a);
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::invalid_iterator &) {
+		std::cout << "OK" << std::endl;
+	}
+	std::cout << (m.find(a) == nullptr) << " " << *m.find(d) << " " << m.contains(sjtu::slot_map<std::string>::kNullHandle) << std::endl;
+	for (const std::string &s : m) {
+		std::cout << s << " ";
+	}
+	std::cout << std::endl;
+	m.clear();
+	std::cout << m.size() << " " << m.contains(b) << " " << m.contains(d) << std::endl;
+	sjtu::slot_map<std::string>::handle e = m.insert("epsilon");
+	std::cout << m[e] << " " << m.size() << std::endl;
+}
+
+void TestRandom()
+{
+	std::cout << "Testing random operations..." << std::endl;
+	sjtu::slot_map<long long> m;
+	m.reserve(1000);
+	std::map<unsigned long long, long long> ref;
+	std::vector<unsigned long long> dead;
+	bool ok = true;
+	for (int op = 0; op < 200000; ++op) {
+		int kind = rand64() % 3;
+		if (kind < 2 || ref.empty()) {
+			long long v = rand64() % 1000000;
+			ref[m.insert(v)] = v;
+		} else {
+			auto it = ref.lower_bound(rand64());
+			if (it == ref.end()) {
+				it = ref.begin();
+			}
+			m.erase(it->first);
+			dead.push_back(it->first);
+			ref.erase(it);
+		}
+	}
+	for (auto &kv : ref) {
+		if (!m.contains(kv.first) || m[kv.first] != kv.second) {
+			ok = false;
+		}
+	}
+	for (unsigned long long h : dead) {
+		if (m.contains(h)) {
+			ok = false;
+		}
+	}
+	long long sum = 0, expected = 0;
+	for (long long v : m) {
+		sum += v;
+	}
+	for (auto &kv : ref) {
+		expected += kv.second;
+	}
+	std::cout << ok << " " << (m.size() == ref.size()) << " " << (sum == expected) << std::endl;
+}
+
+int main()
+{
+	seed = 2718281828459045ULL;
+	TestBasic();
+	TestRandom();
+	return 0;
+}
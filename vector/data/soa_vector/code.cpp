@@ -0,0 +1,109 @@
+#include "vector.hpp"
+#include "soa_vector.hpp"
+#include "test-utility.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+struct Particle {
+	double x, y, z;
+	double vx, vy, vz;
+	int id;
+	char tag[20];
+};
+
+void TestBasic()
+{
+	std::cout << "Testing rows and columns..." << std::endl;
+	sjtu::soa_vector<int, double, std::string> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(std::make_tuple(i, i * 0.5, std::to_string(i)));
+	}
+	v.emplace_back(10, 5.0, "ten");
+	for (auto [id, w, name] : v) {
+		w *= 2;
+		name += "!";
+	}
+	sjtu::span<int> ids = v.column<0>();
+	for (int &id : ids) {
+		id *= 10;
+	}
+	for (size_t i = 0; i < v.size(); ++i) {
+		std::cout << v.get<0>(i) << " " << v.get<1>(i) << " " << std::get<2>(v[i]) << std::endl;
+	}
+	v.pop_back();
+	std::cout << v.size() << " " << v.column<2>().size() << std::endl;
+}
+
+void TestCopy()
+{
+	std::cout << "Testing copy..." << std::endl;
+	sjtu::soa_vector<std::string, long long> a;
+	for (int i = 0; i < 100; ++i) {
+		a.emplace_back(std::string(i % 7, 'a'), (long long)i * i);
+	}
+	sjtu::soa_vector<std::string, long long> b = a;
+	a.clear();
+	a.emplace_back("x", 1LL);
+	const sjtu::soa_vector<std::string, long long> &c = b;
+	long long sum = 0;
+	size_t len = 0;
+	for (sjtu::soa_vector<std::string, long long>::const_iterator it = c.cbegin(); it != c.cend(); ++it) {
+		len += std::get<0>(*it).size();
+		sum += std::get<1>(*it);
+	}
+	std::cout << b.size() << " " << len << " " << sum << " " << a.size() << std::endl;
+	b = a;
+	std::cout << b.size() << " " << b.get<0>(0) << std::endl;
+	try {
+		b.get<1>(1);
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "OK" << std::endl;
+	}
+}
+
+// pass the number of particles, e.g. 2000000
+void Benchmark(size_t n)
+{
+	sjtu::vector<Particle> aos;
+	sjtu::soa_vector<double, double, double, double, double, double, int> soa;
+	soa.reserve(n);
+	for (size_t i = 0; i < n; ++i) {
+		Particle p{};
+		p.x = static_cast<double>(i);
+		p.vx = 1.0;
+		p.id = static_cast<int>(i);
+		aos.push_back(p);
+		soa.emplace_back(p.x, p.y, p.z, p.vx, p.vy, p.vz, p.id);
+	}
+	double aos_ms = TimeMs([&] {
+		Particle *pa = aos.data();
+		for (int round = 0; round < 10; ++round) {
+			for (size_t i = 0; i < n; ++i) {
+				pa[i].x += pa[i].vx;
+			}
+		}
+	});
+	double soa_ms = TimeMs([&] {
+		double *x = soa.column<0>().data();
+		const double *vx = soa.column<3>().data();
+		for (int round = 0; round < 10; ++round) {
+			for (size_t i = 0; i < n; ++i) {
+				x[i] += vx[i];
+			}
+		}
+	});
+	std::cerr << "x += vx, 10 rounds (ms): AoS " << aos_ms << " SoA " << soa_ms << std::endl;
+}
+
+int main(int argc, char const *argv[])
+{
+	TestBasic();
+	TestCopy();
+	if (argc > 1) {
+		Benchmark(std::strtoul(argv[1], nullptr, 10));
+	}
+	return 0;
+}
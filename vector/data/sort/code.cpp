@@ -0,0 +1,235 @@
+#include "vector.hpp"
+#include "sort.hpp"
+#include "test-utility.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+template <typename T>
+bool same(const sjtu::vector<T> &a, const std::vector<T> &b)
+{
+	if (a.size() != b.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < a.size(); ++i) {
+		if (a[i] != b[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <typename T>
+void fill(sjtu::vector<T> &a, std::vector<T> &b, size_t n, int pattern)
+{
+	a.clear();
+	b.clear();
+	for (size_t i = 0; i < n; ++i) {
+		long long x;
+		switch (pattern) {
+		case 0: x = (long long)(rand64() % 2000000007ULL) - 1000000000LL; break;
+		case 1: x = i; break;
+		case 2: x = n - i; break;
+		case 3: x = rand64() % 4; break;
+		default: x = (i % 100 == 0) ? (long long)(rand64() % 1000) : i; break;
+		}
+		a.push_back(T(x));
+		b.push_back(T(x));
+	}
+}
+
+const char *kPatterns[] = {"random", "sorted", "reversed", "few-unique", "nearly-sorted"};
+
+void TestSort()
+{
+	std::cout << "Testing pdqsort..." << std::endl;
+	sjtu::vector<int> a;
+	std::vector<int> b;
+	for (int pattern = 0; pattern < 5; ++pattern) {
+		for (size_t n : {0, 1, 2, 23, 24, 129, 1000, 100000}) {
+			fill(a, b, n, pattern);
+			sjtu::sort(a, std::less<int>());
+			std::sort(b.begin(), b.end());
+			if (!same(a, b)) {
+				std::cout << "FAIL on " << kPatterns[pattern] << " " << n << std::endl;
+				return;
+			}
+		}
+	}
+	sjtu::vector<std::string> s;
+	for (int i = 0; i < 1000; ++i) {
+		s.push_back(std::to_string(rand64() % 500));
+	}
+	sjtu::sort(s, [](const std::string &x, const std::string &y) { return x.size() != y.size() ? x.size() > y.size() : x < y; });
+	for (size_t i = 1; i < s.size(); ++i) {
+		if (s[i].size() > s[i - 1].size() || (s[i].size() == s[i - 1].size() && s[i] < s[i - 1])) {
+			std::cout << "FAIL on strings" << std::endl;
+			return;
+		}
+	}
+	std::cout << "OK" << std::endl;
+}
+
+struct Record {
+	int key;
+	int order;
+};
+
+void TestStableSort()
+{
+	std::cout << "Testing stable sort..." << std::endl;
+	sjtu::vector<Record> a;
+	for (int i = 0; i < 50000; ++i) {
+		a.push_back(Record{int(rand64() % 100), i});
+	}
+	sjtu::vector<Record> b = a;
+	sjtu::stable_sort(a, [](const Record &x, const Record &y) { return x.key < y.key; });
+	sjtu::radix_sort(b, [](const Record &r) { return r.key; });
+	for (size_t i = 1; i < a.size(); ++i) {
+		if (a[i].key < a[i - 1].key || (a[i].key == a[i - 1].key && a[i].order < a[i - 1].order)) {
+			std::cout << "FAIL on stable_sort" << std::endl;
+			return;
+		}
+		if (a[i].key != b[i].key || a[i].order != b[i].order) {
+			std::cout << "FAIL on keyed radix_sort" << std::endl;
+			return;
+		}
+	}
+	std::cout << "OK" << std::endl;
+}
+
+void TestRadixSort()
+{
+	std::cout << "Testing radix sort..." << std::endl;
+	sjtu::vector<long long> a;
+	std::vector<long long> b;
+	for (int pattern = 0; pattern < 5; ++pattern) {
+		fill(a, b, 100000, pattern);
+		sjtu::radix_sort(a);
+		std::sort(b.begin(), b.end());
+		if (!same(a, b)) {
+			std::cout << "FAIL on " << kPatterns[pattern] << std::endl;
+			return;
+		}
+	}
+	sjtu::vector<double> d;
+	std::vector<double> e;
+	for (int i = 0; i < 100000; ++i) {
+		double x = ((long long)(rand64() % 2000001) - 1000000) / 7.0;
+		d.push_back(x);
+		e.push_back(x);
+	}
+	sjtu::sort(d);
+	std::sort(e.begin(), e.end());
+	if (!same(d, e)) {
+		std::cout << "FAIL on double" << std::endl;
+		return;
+	}
+	// long double keys are not radix sorted, short or long vectors alike
+	for (size_t n : {10, 100000}) {
+		sjtu::vector<long double> l;
+		std::vector<long double> m;
+		for (size_t i = 0; i < n; ++i) {
+			long double x = ((long long)(rand64() % 2000001) - 1000000) / 3.0L;
+			l.push_back(x);
+			m.push_back(x);
+		}
+		sjtu::sort(l);
+		std::sort(m.begin(), m.end());
+		if (!same(l, m)) {
+			std::cout << "FAIL on long double" << std::endl;
+			return;
+		}
+	}
+	sjtu::vector<unsigned short> u;
+	for (int i = 0; i < 10000; ++i) {
+		u.push_back(rand64() % 65536);
+	}
+	sjtu::radix_sort(u);
+	for (size_t i = 1; i < u.size(); ++i) {
+		if (u[i] < u[i - 1]) {
+			std::cout << "FAIL on unsigned short" << std::endl;
+			return;
+		}
+	}
+	std::cout << "OK" << std::endl;
+}
+
+void TestSelection()
+{
+	std::cout << "Testing partial_sort and nth_element..." << std::endl;
+	sjtu::vector<int> a;
+	std::vector<int> b;
+	for (int pattern = 0; pattern < 5; ++pattern) {
+		fill(a, b, 10000, pattern);
+		std::sort(b.begin(), b.end());
+		sjtu::partial_sort(a, 100);
+		for (size_t i = 0; i < 100; ++i) {
+			if (a[i] != b[i]) {
+				std::cout << "FAIL on partial_sort " << kPatterns[pattern] << std::endl;
+				return;
+			}
+		}
+		for (size_t k : {0, 1, 4999, 9999}) {
+			fill(a, b, 10000, pattern);
+			std::sort(b.begin(), b.end());
+			sjtu::nth_element(a, k);
+			if (a[k] != b[k]) {
+				std::cout << "FAIL on nth_element " << kPatterns[pattern] << std::endl;
+				return;
+			}
+			for (size_t i = 0; i < a.size(); ++i) {
+				if ((i < k && a[k] < a[i]) || (i > k && a[i] < a[k])) {
+					std::cout << "FAIL on nth_element " << kPatterns[pattern] << std::endl;
+					return;
+				}
+			}
+		}
+	}
+	try {
+		sjtu::nth_element(a, a.size());
+		std::cout << "FAIL on bound check" << std::endl;
+		return;
+	} catch (sjtu::index_out_of_bound &) {
+	}
+	std::cout << "OK" << std::endl;
+}
+
+// pass the number of elements to sort, e.g. 1000000
+void Benchmark(size_t n)
+{
+	sjtu::vector<int> a;
+	std::vector<int> b;
+	for (int pattern = 0; pattern < 5; ++pattern) {
+		std::cerr << kPatterns[pattern] << " (ms):";
+		fill(a, b, n, pattern);
+		std::cerr << " std::sort " << TimeMs([&] { std::sort(b.begin(), b.end()); });
+		fill(a, b, n, pattern);
+		std::cerr << " pdqsort " << TimeMs([&] { sjtu::sort(a, std::less<int>()); });
+		fill(a, b, n, pattern);
+		std::cerr << " stable_sort " << TimeMs([&] { sjtu::stable_sort(a); });
+		fill(a, b, n, pattern);
+		std::cerr << " radix_sort " << TimeMs([&] { sjtu::radix_sort(a); });
+		fill(a, b, n, pattern);
+		std::cerr << " partial_sort(1000) " << TimeMs([&] { sjtu::partial_sort(a, 1000); });
+		fill(a, b, n, pattern);
+		std::cerr << " nth_element " << TimeMs([&] { sjtu::nth_element(a, n / 2); });
+		std::cerr << std::endl;
+	}
+}
+
+int main(int argc, char const *argv[])
+{
+	seed = 20250302ULL;
+	TestSort();
+	TestStableSort();
+	TestRadixSort();
+	TestSelection();
+	if (argc > 1) {
+		Benchmark(std::strtoul(argv[1], nullptr, 10));
+	}
+	return 0;
+}
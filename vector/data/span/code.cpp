@@ -0,0 +1,117 @@
+#include "class-matrix.hpp"
+#include "inplace_vector.hpp"
+#include "span.hpp"
+#include "vector.hpp"
+
+#include <iostream>
+
+template <typename T>
+long long Sum(sjtu::span<const T> s)
+{
+	long long total = 0;
+	for (const T &x : s) {
+		total += x;
+	}
+	return total;
+}
+
+template <typename Span>
+void Print(const Span &s)
+{
+	for (size_t i = 0; i < s.size(); ++i) {
+		std::cout << s[i] << " ";
+	}
+	std::cout << "| ";
+}
+
+void TestSpan()
+{
+	std::cout << "Testing span..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(i);
+	}
+	sjtu::span<int> all = v;
+	sjtu::span<int> mid = all.subspan(2, 5);
+	mid[0] = 20;
+	Print(mid);
+	Print(mid.first(2));
+	Print(mid.last(2));
+	Print(all.subspan(8));
+	std::cout << std::endl;
+	const sjtu::vector<int> &cv = v;
+	std::cout << Sum<int>(cv) << " " << Sum<int>(mid) << " " << v[2] << std::endl;
+
+	int arr[] = {5, 6, 7};
+	sjtu::span<int> a = arr;
+	sjtu::inplace_vector<int, 4> iv;
+	iv.push_back(1);
+	iv.push_back(2);
+	sjtu::span<const int> is = iv;
+	std::cout << a.size() << " " << a.back() << " " << Sum<int>(is) << " " << (all.end() - all.begin()) << std::endl;
+
+	Diamond::Matrix<int> m(3, 4);
+	for (int i = 0; i < 3; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			m[i][j] = i * 10 + j;
+		}
+	}
+	sjtu::span<int> row = m[1];
+	row[3] = 99;
+	const Diamond::Matrix<int> &cm = m;
+	std::cout << Sum<int>(cm[1]) << " " << m[1][3] << std::endl;
+
+	try {
+		all.subspan(4, 7);
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "OK" << std::endl;
+	}
+	try {
+		sjtu::span<int>().front();
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "OK" << std::endl;
+	}
+}
+
+void TestStrided()
+{
+	std::cout << "Testing strided_span..." << std::endl;
+	// a 4 x 3 row-major matrix in one buffer
+	sjtu::vector<double> flat;
+	for (int i = 0; i < 12; ++i) {
+		flat.push_back(i);
+	}
+	sjtu::strided_span<double> col = sjtu::strided_span<double>::column(flat, 3, 1);
+	Print(col);
+	for (double &x : col) {
+		x *= 10;
+	}
+	Print(col.subspan(1, 2));
+	Print(col.last(1));
+	Print(col.subspan(4));
+	std::cout << std::endl;
+	sjtu::strided_span<const double> ccol = col;
+	sjtu::strided_span<const double> row = sjtu::span<const double>(flat).first(3);
+	std::cout << ccol.size() << " " << ccol.stride() << " " << row.stride() << " " << (ccol.end() - ccol.begin()) << " " << flat[4] << std::endl;
+	try {
+		sjtu::strided_span<double>::column(flat, 5, 0);
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::runtime_error &) {
+		std::cout << "OK" << std::endl;
+	}
+	try {
+		col[4];
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "OK" << std::endl;
+	}
+}
+
+int main()
+{
+	TestSpan();
+	TestStrided();
+	return 0;
+}
@@ -0,0 +1,63 @@
+#include "stlite.hpp"
+
+#include <iostream>
+
+// defined in factorial.cpp, which includes the same headers
+Util::Bint Factorial(int n);
+long long KthSmallestSum(const sjtu::vector<long long> &values, int k);
+
+void TestContainers()
+{
+	std::cout << "Testing the precompiled instantiations..." << std::endl;
+	sjtu::vector<int> v;
+	for (int i = 0; i < 10; ++i) {
+		v.push_back(i * i);
+	}
+	v.erase(3);
+	v.insert(0, -1);
+	sjtu::vector<double> d;
+	for (int i = 0; i < 5; ++i) {
+		d.push_back(i / 4.0);
+	}
+	sjtu::vector<int> copy = v;
+	std::cout << copy.size() << " " << copy[0] << " " << copy[4] << " " << d.back() << std::endl;
+
+	sjtu::priority_queue<int> pq;
+	for (int x : v) {
+		pq.push(x);
+	}
+	sjtu::priority_queue<double> pd;
+	pd.push(0.5);
+	pd.push(1.5);
+	std::cout << pq.top() << " " << pq.size() << " " << pd.top() << std::endl;
+}
+
+void TestBint()
+{
+	std::cout << "Testing Bint from two translation units..." << std::endl;
+	sjtu::vector<Util::Bint> facts;
+	for (int i = 20; i <= 30; i += 5) {
+		facts.push_back(Factorial(i));
+	}
+	for (const Util::Bint &f : facts) {
+		std::cout << f << std::endl;
+	}
+	sjtu::priority_queue<Util::Bint> heap;
+	heap.push(Util::Bint(7));
+	heap.push(Factorial(5));
+	heap.push(Util::Bint(64));
+	std::cout << heap.top() << std::endl;
+
+	sjtu::vector<long long> values;
+	for (long long i = 1; i <= 8; ++i) {
+		values.push_back(i * 37 % 11);
+	}
+	std::cout << KthSmallestSum(values, 3) << std::endl;
+}
+
+int main()
+{
+	TestContainers();
+	TestBint();
+	return 0;
+}
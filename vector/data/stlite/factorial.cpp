@@ -0,0 +1,28 @@
+#include "stlite.hpp"
+
+Util::Bint Factorial(int n)
+{
+	Util::Bint result(1);
+	for (int i = 2; i <= n; ++i) {
+		result = result * Util::Bint(i);
+	}
+	return result;
+}
+
+// the sum of the k smallest values, using a max-heap of size k
+long long KthSmallestSum(const sjtu::vector<long long> &values, int k)
+{
+	sjtu::priority_queue<long long> heap;
+	for (long long x : values) {
+		heap.push(x);
+		if (static_cast<int>(heap.size()) > k) {
+			heap.pop();
+		}
+	}
+	long long sum = 0;
+	while (!heap.empty()) {
+		sum += heap.top();
+		heap.pop();
+	}
+	return sum;
+}
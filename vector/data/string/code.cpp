@@ -0,0 +1,206 @@
+#include "string.hpp"
+#include "string_column.hpp"
+#include "test-utility.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+void TestInline()
+{
+	std::cout << "Testing small strings..." << std::endl;
+	sjtu::string empty;
+	std::cout << sizeof(sjtu::string) << " " << empty.size() << " " << (empty.c_str()[0] == '\0') << " "
+	          << empty.capacity() << std::endl;
+	sjtu::string s = "hello";
+	s += ", ";
+	s += "world";
+	s.push_back('!');
+	std::cout << s << " " << s.size() << " " << s.capacity() << std::endl;
+	sjtu::string fits(22, 'x');
+	std::cout << fits.capacity() << " ";
+	fits.push_back('y');
+	std::cout << fits.size() << " " << (fits.capacity() > 22) << " " << fits.back() << std::endl;
+	fits.resize(3);
+	std::cout << fits << " " << fits.size() << std::endl;
+	try {
+		std::cout << s[s.size()] << std::endl;
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "out of bound" << std::endl;
+	}
+	try {
+		empty.pop_back();
+	} catch (sjtu::container_is_empty &) {
+		std::cout << "empty" << std::endl;
+	}
+}
+
+void TestHeap()
+{
+	std::cout << "Testing long strings..." << std::endl;
+	sjtu::string s;
+	for (int i = 0; i < 100; ++i) {
+		s += static_cast<char>('a' + i % 26);
+	}
+	sjtu::string copy = s;
+	sjtu::string moved = std::move(copy);
+	std::cout << moved.size() << " " << copy.size() << " " << (moved == s) << " " << moved.substr(95) << std::endl;
+	s.append(s);
+	s.append(s.c_str() + 10, 5);
+	std::cout << s.size() << " " << s.substr(195, 10) << std::endl;
+	s = s.substr(190);
+	std::cout << s << std::endl;
+	sjtu::string a = "short";
+	a = moved;
+	moved = "tiny";
+	std::cout << a.size() << " " << moved << " " << moved.capacity() << std::endl;
+	sjtu::string b = a.substr(0, 3);
+	b.insert(1, "XYZ");
+	b.insert(b.size(), b);
+	std::cout << b << " " << b.find("YZ") << " " << b.find("YZ", 3) << " " << (b.find('q') == sjtu::string::npos)
+	          << std::endl;
+	// inserting part of the string itself, shifted in place or reallocated
+	sjtu::string c = "abc";
+	c.insert(1, c);
+	bool same = true;
+	for (size_t cap : {30, 200}) {
+		for (size_t pos = 0; pos <= 20; pos += 4) {
+			for (size_t from = 0; from < 20; from += 3) {
+				std::string expected = "abcdefghijklmnopqrst";
+				sjtu::string t(expected);
+				t.reserve(cap);
+				expected.insert(pos, expected.substr(from, 7));
+				t.insert(pos, std::string_view(t).substr(from, 7));
+				same = same && std::string_view(t) == expected;
+			}
+		}
+	}
+	std::cout << c << " " << same << std::endl;
+}
+
+void TestConcat()
+{
+	std::cout << "Testing concatenation..." << std::endl;
+	sjtu::string prefix = "users";
+	sjtu::string name = "a-rather-long-user-name-that-is-on-the-heap";
+	sjtu::string key = prefix + "/" + name;
+	std::cout << key << std::endl;
+	// the temporary from the first + is reused by the second
+	sjtu::string big(40, '.');
+	const char *buffer = big.data();
+	big.reserve(200);
+	buffer = big.data();
+	sjtu::string joined = std::move(big) + name + "/" + 'x';
+	std::cout << joined.size() << " " << (joined.data() == buffer) << std::endl;
+	sjtu::string tail(50, '-');
+	buffer = tail.data();
+	tail.reserve(100);
+	buffer = tail.data();
+	sjtu::string front = "head" + std::move(tail);
+	std::cout << front.substr(0, 8) << " " << (front.data() == buffer) << std::endl;
+	std::cout << (prefix < name) << " " << (prefix == "users") << " " << ("users" == prefix) << " "
+	          << (prefix != name) << " " << (sjtu::string("b") > "a") << " "
+	          << (prefix.compare(std::string_view("user")) > 0) << std::endl;
+	std::unordered_set<sjtu::string> set;
+	set.insert(prefix);
+	set.insert(name);
+	set.insert(sjtu::string("users"));
+	std::cout << set.size() << " " << set.count("users") << std::endl;
+}
+
+void TestColumn()
+{
+	std::cout << "Testing string_column..." << std::endl;
+	sjtu::string_column col;
+	const char *words[] = {"pear", "apple", "fig", "", "apple pie", "applesauce", "banana", "apple"};
+	for (const char *w : words) {
+		col.push_back(w);
+	}
+	std::cout << col.size() << " " << col.total_chars() << " " << col[1] << " " << col.is_sorted() << std::endl;
+	col.sort();
+	for (std::string_view w : col) {
+		std::cout << "[" << w << "]";
+	}
+	std::cout << std::endl;
+	std::cout << col.is_sorted() << " " << col.lower_bound("apple") << " " << col.find("banana") << " "
+	          << col.find("grape") << " " << col.lower_bound("zzz") << std::endl;
+	col.pop_back();
+	std::cout << col.size() << " " << col.total_chars() << " " << col.offsets().back() << std::endl;
+	try {
+		col[7];
+	} catch (sjtu::index_out_of_bound &) {
+		std::cout << "out of bound" << std::endl;
+	}
+	// strings of the column itself, across reallocations
+	for (int i = 0; i < 6; ++i) {
+		col.push_back(*col.begin());
+		col.push_back(col[col.size() - 2]);
+	}
+	std::cout << col.size() << " " << col.total_chars() << " " << col[18] << std::endl;
+	col.clear();
+	std::cout << col.size() << " " << col.empty() << std::endl;
+}
+
+// sorts n random short keys as std::strings and in a string_column,
+// returns whether the orders agree and the column finds the keys, and the times
+bool SortKeys(size_t n, double &strings_ms, double &column_ms)
+{
+	std::vector<std::string> keys;
+	keys.reserve(n);
+	for (size_t i = 0; i < n; ++i) {
+		std::string k = "key:";
+		int len = static_cast<int>(rand64() % 12);
+		for (int j = 0; j < len; ++j) {
+			k.push_back(static_cast<char>('a' + rand64() % 4));
+		}
+		keys.push_back(k);
+	}
+	sjtu::string_column col;
+	col.reserve(n, n * 10);
+	for (const std::string &k : keys) {
+		col.push_back(k);
+	}
+	strings_ms = TimeMs([&] { std::sort(keys.begin(), keys.end()); });
+	column_ms = TimeMs([&] { col.sort(); });
+	bool same = col.size() == keys.size();
+	for (size_t i = 0; same && i < keys.size(); ++i) {
+		same = col[i] == keys[i];
+	}
+	for (int i = 0; same && i < 1000; ++i) {
+		same = col.find(keys[rand64() % n]) < col.size();
+	}
+	return same && col.find("key:e") == col.size();
+}
+
+void TestSort()
+{
+	std::cout << "Testing sorting many short keys..." << std::endl;
+	double strings_ms, column_ms;
+	std::cout << SortKeys(50000, strings_ms, column_ms) << std::endl;
+}
+
+// pass the number of keys, e.g. 1000000
+void Benchmark(size_t n)
+{
+	double strings_ms, column_ms;
+	bool same = SortKeys(n, strings_ms, column_ms);
+	std::cerr << (same ? "" : "FAIL ") << "sort " << n << " keys (ms): std::vector<std::string> " << strings_ms
+	          << " string_column " << column_ms << std::endl;
+}
+
+int main(int argc, char const *argv[])
+{
+	seed = 8675309;
+	TestInline();
+	TestHeap();
+	TestConcat();
+	TestColumn();
+	TestSort();
+	if (argc > 1) {
+		Benchmark(std::strtoul(argv[1], nullptr, 10));
+	}
+	return 0;
+}
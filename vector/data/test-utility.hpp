@@ -0,0 +1,32 @@
+#ifndef SJTU_TEST_UTILITY_HPP
+#define SJTU_TEST_UTILITY_HPP
+
+#include <chrono>
+
+/**
+ * shared by the tests under data/.
+ * rand64() is an xorshift generator over the global seed. a test sets seed
+ * first, so its answer.txt does not change between runs.
+ * TimeMs times a benchmark. a test runs its benchmarks only when it is
+ * given a size on the command line, so ctest checks behaviour alone.
+ */
+inline unsigned long long seed = 1;
+
+inline unsigned long long rand64()
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return seed;
+}
+
+// the wall time of f() in milliseconds
+template <typename Func>
+double TimeMs(Func &&f)
+{
+	auto start = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+#endif
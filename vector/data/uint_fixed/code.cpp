@@ -0,0 +1,203 @@
+#include "class-bint.hpp"
+#include "uint_fixed.hpp"
+#include "test-utility.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+template <size_t Bits>
+sjtu::uint_fixed<Bits> RandomFixed()
+{
+	unsigned long long limbs[sjtu::uint_fixed<Bits>::kLimbs];
+	for (unsigned long long &l : limbs) {
+		// now and then a limb with all bits set, to exercise the carries
+		l = rand64() % 8 == 0 ? ~0ULL : rand64();
+	}
+	return sjtu::uint_fixed<Bits>::from_limbs(limbs, sjtu::uint_fixed<Bits>::kLimbs);
+}
+
+std::string ToString(const Util::Bint &b)
+{
+	std::ostringstream os;
+	os << b;
+	return os.str();
+}
+
+constexpr sjtu::uint256 Factorial(unsigned n)
+{
+	sjtu::uint256 r = 1;
+	for (unsigned i = 2; i <= n; ++i) {
+		r *= i;
+	}
+	return r;
+}
+
+// evaluated entirely by the compiler
+static_assert(Factorial(30) / 1000000 == sjtu::uint256::parse("265252859812191058636308480"));
+static_assert(Factorial(30) % 1000000 == 0);
+static_assert((sjtu::uint128(1) << 127 >> 127) == 1);
+static_assert(sjtu::uint128::max() + 1 == 0);
+static_assert(-sjtu::uint128(1) == sjtu::uint128::max());
+static_assert(sjtu::uint512(Factorial(57)).bit_width() == 255);
+static_assert((sjtu::uint512(1) << 300).bit_width() == 301);
+static_assert(sjtu::uint256(7) < sjtu::uint256(1) << 64);
+
+void TestBasic()
+{
+	std::cout << "Testing arithmetic..." << std::endl;
+	sjtu::uint256 a = sjtu::uint256::parse("115792089237316195423570985008687907853269984665640564039457584007913129639935");
+	std::cout << (a == sjtu::uint256::max()) << " " << a.bit_width() << " " << (a + 1) << " " << a * a << std::endl;
+	sjtu::uint256 f = Factorial(50);
+	std::cout << f << " " << f.bit_width() << std::endl;
+	std::cout << (f >> 100) << " " << (f << 30) << " " << (f & 0xFFFF) << " " << (f ^ f) << std::endl;
+	sjtu::uint512 wide = f.mul_full(f);
+	std::cout << wide << std::endl;
+	std::cout << sjtu::uint_fixed<192>(f) << " " << sjtu::uint128(f).to_string() << std::endl;
+	sjtu::uint128 x = 10;
+	x--;
+	--x;
+	++x;
+	std::cout << x << " " << sjtu::uint128() << " " << static_cast<unsigned long long>(x) << " " << static_cast<bool>(x - 9) << std::endl;
+	std::cout << (f / 1000000007ULL) << " " << (f % 1000000007ULL) << std::endl;
+	try {
+		sjtu::uint128::parse("340282366920938463463374607431768211456");
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::runtime_error &) {
+		std::cout << "OK" << std::endl;
+	}
+	try {
+		sjtu::uint128::parse("12a");
+		std::cout << "FAIL" << std::endl;
+	} catch (sjtu::runtime_error &) {
+		std::cout << "OK" << std::endl;
+	}
+}
+
+void TestAgainstInt128()
+{
+	std::cout << "Testing against unsigned __int128..." << std::endl;
+	bool ok = true;
+	for (int i = 0; i < 100000; ++i) {
+		sjtu::uint128 a = RandomFixed<128>(), b = RandomFixed<128>();
+		unsigned __int128 x = (static_cast<unsigned __int128>(a.limb(1)) << 64) | a.limb(0);
+		unsigned __int128 y = (static_cast<unsigned __int128>(b.limb(1)) << 64) | b.limb(0);
+		unsigned s = rand64() % 130;
+		unsigned long long d = rand64() >> (rand64() % 64);
+		if (d == 0) {
+			d = 1;
+		}
+		auto same = [](const sjtu::uint128 &u, unsigned __int128 v) {
+			return u.limb(0) == static_cast<unsigned long long>(v) && u.limb(1) == static_cast<unsigned long long>(v >> 64);
+		};
+		if (!same(a + b, x + y) || !same(a - b, x - y) || !same(a * b, x * y) || !same(a / d, x / d) ||
+		    a % d != static_cast<unsigned long long>(x % d) || !same(a | b, x | y) || (a < b) != (x < y) ||
+		    (a == b) != (x == y)) {
+			ok = false;
+		}
+		if (s < 128 && (!same(a << s, x << s) || !same(a >> s, x >> s))) {
+			ok = false;
+		}
+		if (s >= 128 && ((a << s) != 0 || (a >> s) != 0)) {
+			ok = false;
+		}
+		sjtu::uint256 full = a.mul_full(b);
+		if (sjtu::uint128(full) != a * b || sjtu::uint128(full >> 128) != sjtu::uint128(sjtu::uint256(a) * sjtu::uint256(b) >> 128)) {
+			ok = false;
+		}
+		if (sjtu::uint128::parse(a.to_string()) != a) {
+			ok = false;
+		}
+	}
+	std::cout << (ok ? "OK" : "FAIL") << std::endl;
+}
+
+void TestBint()
+{
+	std::cout << "Testing conversions with Util::Bint..." << std::endl;
+	Util::Bint b(Factorial(40));
+	std::cout << b << " " << (b.ToFixed<256>() == Factorial(40)) << std::endl;
+	std::cout << Util::Bint(sjtu::uint512()) << " " << Util::Bint(sjtu::uint128::max()) << std::endl;
+	std::cout << Util::Bint(std::string("123456789012345678901234567890")).ToFixed<128>() << std::endl;
+	try {
+		Util::Bint(std::string("340282366920938463463374607431768211456")).ToFixed<128>();
+		std::cout << "FAIL" << std::endl;
+	} catch (std::invalid_argument &) {
+		std::cout << "OK" << std::endl;
+	}
+	try {
+		Util::Bint(-5).ToFixed<128>();
+		std::cout << "FAIL" << std::endl;
+	} catch (std::invalid_argument &) {
+		std::cout << "OK" << std::endl;
+	}
+	bool ok = true;
+	for (int i = 0; i < 300; ++i) {
+		sjtu::uint512 a = RandomFixed<512>() >> (rand64() % 512);
+		sjtu::uint256 x = RandomFixed<256>(), y = RandomFixed<256>();
+		Util::Bint ba(a);
+		if (ToString(ba) != a.to_string() || ba.ToFixed<512>() != a) {
+			ok = false;
+		}
+		// products agree, Bint computing with its own limbs
+		Util::Bint bx(x), by(y);
+		if ((bx * by).ToFixed<512>() != x.mul_full(y)) {
+			ok = false;
+		}
+	}
+	std::cout << (ok ? "OK" : "FAIL") << std::endl;
+}
+
+// runs the same chain of 256-bit products with Util::Bint and with
+// uint_fixed, returns whether they agree and their times
+bool ProductChain(int rounds, double &bint_ms, double &fixed_ms)
+{
+	sjtu::uint256 m = sjtu::uint256::parse("1000000000000000000000000000000000000000000000000000000000000000000000007");
+	sjtu::uint256 seed_value = RandomFixed<256>() >> 8;
+	Util::Bint acc(seed_value);
+	bint_ms = TimeMs([&] {
+		Util::Bint step{sjtu::uint128(m)};
+		for (int i = 0; i < rounds; ++i) {
+			// keep the Bint at 256 bits the only way it can, through uint_fixed
+			acc = Util::Bint((acc * step).ToFixed<512>() >> 256 ^ sjtu::uint512(i));
+		}
+	});
+	sjtu::uint256 fixed = seed_value;
+	fixed_ms = TimeMs([&] {
+		sjtu::uint256 fstep{sjtu::uint128(m)};
+		for (int i = 0; i < rounds; ++i) {
+			fixed = sjtu::uint256(fixed.mul_full(fstep) >> 256 ^ sjtu::uint512(i));
+		}
+	});
+	return acc.ToFixed<256>() == fixed;
+}
+
+void TestChain()
+{
+	std::cout << "Testing a 256-bit product chain..." << std::endl;
+	double bint_ms, fixed_ms;
+	std::cout << ProductChain(2000, bint_ms, fixed_ms) << std::endl;
+}
+
+// pass the number of products, e.g. 200000
+void Benchmark(int rounds)
+{
+	double bint_ms, fixed_ms;
+	bool same = ProductChain(rounds, bint_ms, fixed_ms);
+	std::cerr << (same ? "" : "FAIL ") << rounds << " 256-bit products (ms): Util::Bint " << bint_ms << " uint_fixed "
+	          << fixed_ms << std::endl;
+}
+
+int main(int argc, char const *argv[])
+{
+	seed = 2645751311064590ULL;
+	TestBasic();
+	TestAgainstInt128();
+	TestBint();
+	TestChain();
+	if (argc > 1) {
+		Benchmark(std::atoi(argv[1]));
+	}
+	return 0;
+}
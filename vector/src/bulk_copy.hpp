@@ -0,0 +1,127 @@
+#ifndef SJTU_BULK_COPY_HPP
+#define SJTU_BULK_COPY_HPP
+
+#include "cpu_features.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace sjtu {
+namespace detail {
+
+/**
+ * copies of at least this many bytes bypass the cache and are split
+ * across threads, smaller ones are a plain memcpy.
+ */
+constexpr size_t kBulkCopyThreshold = size_t(32) << 20;
+constexpr size_t kBulkCopyMaxThreads = 8;
+
+/**
+ * memcpy with non-temporal stores: the destination is written straight to
+ * memory instead of through the cache, so a copy much larger than the
+ * cache does not evict everything else.
+ */
+inline void stream_copy(void *dst, const void *src, size_t bytes) {
+#ifdef SJTU_X86_SIMD
+    char *d = static_cast<char *>(dst);
+    const char *s = static_cast<const char *>(src);
+    size_t head = (16 - reinterpret_cast<std::uintptr_t>(d) % 16) % 16;
+    if (head > bytes) {
+        head = bytes;
+    }
+    memcpy(d, s, head);
+    d += head;
+    s += head;
+    bytes -= head;
+    size_t i = 0;
+    for (; i + 64 <= bytes; i += 64) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + 16));
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + 32));
+        __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + 48));
+        _mm_stream_si128(reinterpret_cast<__m128i *>(d + i), a);
+        _mm_stream_si128(reinterpret_cast<__m128i *>(d + i + 16), b);
+        _mm_stream_si128(reinterpret_cast<__m128i *>(d + i + 32), c);
+        _mm_stream_si128(reinterpret_cast<__m128i *>(d + i + 48), e);
+    }
+    memcpy(d + i, s + i, bytes - i);
+    // streaming stores are weakly ordered, make them visible before returning
+    _mm_sfence();
+#else
+    memcpy(dst, src, bytes);
+#endif
+}
+
+/**
+ * copies bytes from src to dst (which must not overlap), using
+ * stream_copy on up to kBulkCopyMaxThreads threads for large buffers.
+ */
+inline void bulk_copy(void *dst, const void *src, size_t bytes) {
+    if (bytes < kBulkCopyThreshold) {
+        if (bytes) {
+            memcpy(dst, src, bytes);
+        }
+        return;
+    }
+    size_t threads = std::thread::hardware_concurrency();
+    threads = threads < 1 ? 1 : threads > kBulkCopyMaxThreads ? kBulkCopyMaxThreads : threads;
+    // chunks end on page boundaries of dst itself, not of the offset into
+    // it, so no two threads write the same cache line
+    std::uintptr_t base = reinterpret_cast<std::uintptr_t>(dst);
+    size_t chunk = bytes / threads;
+    auto chunk_end = [&](size_t t) -> size_t {
+        if (t == threads) {
+            return bytes;
+        }
+        size_t end = (base + t * chunk + 4095) / 4096 * 4096 - base;
+        return end < bytes ? end : bytes;
+    };
+    std::thread workers[kBulkCopyMaxThreads];
+    size_t started = 0;
+    for (size_t t = 1; t < threads; ++t) {
+        size_t begin = chunk_end(t), len = chunk_end(t + 1) - begin;
+        if (len == 0) {
+            continue;
+        }
+        try {
+            workers[started] = std::thread(stream_copy, static_cast<char *>(dst) + begin,
+                                           static_cast<const char *>(src) + begin, len);
+            ++started;
+        } catch (...) {
+            // no thread available, this chunk is copied here instead
+            stream_copy(static_cast<char *>(dst) + begin, static_cast<const char *>(src) + begin, len);
+        }
+    }
+    stream_copy(dst, src, chunk_end(1));
+    for (size_t t = 0; t < started; ++t) {
+        workers[t].join();
+    }
+}
+
+}  // namespace detail
+
+/**
+ * dst = src for trivially copyable elements, with bulk_copy: a large copy
+ * bypasses the cache and is split across threads. the vector copies stay
+ * a plain memcpy, this is for the callers that want the threads and link
+ * with them (Threads::Threads, or -pthread).
+ */
+template <typename T>
+    requires std::is_trivially_copyable_v<T> && std::is_trivially_default_constructible_v<T>
+void assign_parallel(vector<T> &dst, const vector<T> &src) {
+    if (&dst == &src) {
+        return;
+    }
+    dst.clear();
+    dst.reserve(src.size());
+    dst.resize_uninitialized(src.size());
+    detail::bulk_copy(dst.data(), src.data(), src.size() * sizeof(T));
+}
+
+}  // namespace sjtu
+
+#endif
@@ -0,0 +1,403 @@
+#ifndef SJTU_COMPRESSED_VECTOR_HPP
+#define SJTU_COMPRESSED_VECTOR_HPP
+
+#include "cpu_features.hpp"
+#include "exceptions.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+
+namespace sjtu {
+
+/**
+ * how a compressed_int_vector stores a block:
+ *   frame_of_reference: every value minus the block minimum, bit-packed;
+ *   delta: the differences of neighbouring values, frame-of-reference
+ *     packed, which suits sorted data such as id lists.
+ */
+enum class int_encoding { frame_of_reference, delta };
+
+namespace detail {
+
+/**
+ * a packed block holds 128 offsets below 2^bits in 4 * bits 32-bit words.
+ * offset k goes to lane k % 4 at bit (k / 4) * bits of that lane, and
+ * word w of lane l is stored at index w * 4 + l, so the four lanes are
+ * unpacked side by side with the same shifts and come out in order.
+ * offsets needing more than 32 bits are stored raw as 128 64-bit words
+ * (bits == 64).
+ */
+constexpr size_t kPackBlock = 128;
+
+inline void pack_block(unsigned *words, const unsigned long long *offsets, unsigned bits) {
+    if (bits == 64) {
+        for (size_t k = 0; k < kPackBlock; ++k) {
+            words[2 * k] = static_cast<unsigned>(offsets[k]);
+            words[2 * k + 1] = static_cast<unsigned>(offsets[k] >> 32);
+        }
+        return;
+    }
+    memset(words, 0, 4 * bits * sizeof(unsigned));
+    for (size_t k = 0; k < kPackBlock; ++k) {
+        size_t pos = (k / 4) * bits, lane = k % 4;
+        size_t w = pos / 32, shift = pos % 32;
+        words[w * 4 + lane] |= static_cast<unsigned>(offsets[k] << shift);
+        if (shift + bits > 32) {
+            words[(w + 1) * 4 + lane] |= static_cast<unsigned>(offsets[k] >> (32 - shift));
+        }
+    }
+}
+
+inline unsigned long long unpack_one(const unsigned *words, unsigned bits, size_t k) {
+    if (bits == 0) {
+        return 0;
+    }
+    if (bits == 64) {
+        return words[2 * k] | static_cast<unsigned long long>(words[2 * k + 1]) << 32;
+    }
+    size_t pos = (k / 4) * bits, lane = k % 4;
+    size_t w = pos / 32, shift = pos % 32;
+    unsigned long long v = words[w * 4 + lane];
+    if (shift + bits > 32) {
+        v |= static_cast<unsigned long long>(words[(w + 1) * 4 + lane]) << 32;
+    }
+    return (v >> shift) & ((1ULL << bits) - 1);
+}
+
+/**
+ * out[k] = base + offset k, for the packed layouts with 0 < bits <= 32.
+ */
+inline void unpack_block_scalar(const unsigned *words, unsigned bits, unsigned long long base,
+                                unsigned long long *out) {
+    for (size_t k = 0; k < kPackBlock; ++k) {
+        out[k] = base + unpack_one(words, bits, k);
+    }
+}
+
+#ifdef SJTU_X86_SIMD
+/**
+ * the four lanes of a group of words are widened to 64 bits, joined with
+ * the next group when a value straddles two words, shifted, masked and
+ * offset by the base, four values per step.
+ */
+SJTU_TARGET_AVX2 inline void unpack_block_avx2(const unsigned *words, unsigned bits,
+                                               unsigned long long base, unsigned long long *out) {
+    const __m256i mask = _mm256_set1_epi64x(static_cast<long long>((1ULL << bits) - 1));
+    const __m256i vbase = _mm256_set1_epi64x(static_cast<long long>(base));
+    for (size_t j = 0; j < kPackBlock / 4; ++j) {
+        size_t pos = j * bits, w = pos / 32, shift = pos % 32;
+        __m256i v = _mm256_cvtepu32_epi64(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(words + w * 4)));
+        if (shift + bits > 32) {
+            __m256i hi = _mm256_cvtepu32_epi64(
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(words + (w + 1) * 4)));
+            v = _mm256_or_si256(v, _mm256_slli_epi64(hi, 32));
+        }
+        v = _mm256_and_si256(_mm256_srl_epi64(v, _mm_cvtsi32_si128(shift)), mask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + j * 4), _mm256_add_epi64(v, vbase));
+    }
+}
+SJTU_TARGET_SSE42 inline void unpack_block_sse(const unsigned *words, unsigned bits,
+                                               unsigned long long base, unsigned long long *out) {
+    const __m128i mask = _mm_set1_epi64x(static_cast<long long>((1ULL << bits) - 1));
+    const __m128i vbase = _mm_set1_epi64x(static_cast<long long>(base));
+    for (size_t j = 0; j < kPackBlock / 4; ++j) {
+        size_t pos = j * bits, w = pos / 32, shift = pos % 32;
+        __m128i cnt = _mm_cvtsi32_si128(shift);
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(words + w * 4));
+        __m128i v0 = _mm_cvtepu32_epi64(lo);
+        __m128i v1 = _mm_cvtepu32_epi64(_mm_srli_si128(lo, 8));
+        if (shift + bits > 32) {
+            __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(words + (w + 1) * 4));
+            v0 = _mm_or_si128(v0, _mm_slli_epi64(_mm_cvtepu32_epi64(hi), 32));
+            v1 = _mm_or_si128(v1, _mm_slli_epi64(_mm_cvtepu32_epi64(_mm_srli_si128(hi, 8)), 32));
+        }
+        v0 = _mm_add_epi64(_mm_and_si128(_mm_srl_epi64(v0, cnt), mask), vbase);
+        v1 = _mm_add_epi64(_mm_and_si128(_mm_srl_epi64(v1, cnt), mask), vbase);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + j * 4), v0);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + j * 4 + 2), v1);
+    }
+}
+#endif
+
+inline void unpack_block(const unsigned *words, unsigned bits, unsigned long long base,
+                         unsigned long long *out) {
+    if (bits == 0 || bits == 64) {
+        for (size_t k = 0; k < kPackBlock; ++k) {
+            out[k] = base + unpack_one(words, bits, k);
+        }
+        return;
+    }
+#ifdef SJTU_X86_SIMD
+    switch (cpu_simd_level()) {
+        case simd_level::avx2:
+            return unpack_block_avx2(words, bits, base, out);
+        case simd_level::sse42:
+            return unpack_block_sse(words, bits, base, out);
+        default:
+            break;
+    }
+#endif
+    unpack_block_scalar(words, bits, base, out);
+}
+
+}  // namespace detail
+
+/**
+ * an append-only sequence of long long stored in bit-packed blocks of 128
+ * values, each block using only as many bits per value as the spread of
+ * its values (or of their differences, for int_encoding::delta) needs.
+ * a per-block header keeps random access cheap: O(1) for
+ * frame_of_reference and a walk within one block for delta. whole blocks are
+ * unpacked with SIMD, for_each and decode are the fast sequential paths.
+ * the last size() % 128 values are kept unpacked until their block is full.
+ */
+class compressed_int_vector {
+public:
+    static constexpr size_t kBlockSize = detail::kPackBlock;
+
+    class const_iterator {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = long long;
+        using reference = long long;
+        // values are returned by value, which the legacy forward iterator requirements do not allow
+        using iterator_category = std::input_iterator_tag;
+        using iterator_concept = std::forward_iterator_tag;
+
+    private:
+        // for delta, the running sum of the last value read, which a step
+        // forward within its block extends instead of summing from the start
+        const compressed_int_vector *owner_;
+        size_t idx_;
+        mutable size_t sum_idx_ = kNoSum;
+        mutable unsigned long long sum_ = 0;
+    public:
+        const_iterator() : owner_(nullptr), idx_(0) { }
+        const_iterator(const compressed_int_vector *owner, size_t idx) : owner_(owner), idx_(idx) { }
+        const_iterator &operator++() {
+            ++idx_;
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator p = *this;
+            ++idx_;
+            return p;
+        }
+        long long operator*() const {
+            return owner_->value_at(idx_, sum_idx_, sum_);
+        }
+        bool operator==(const const_iterator &rhs) const {
+            return owner_ == rhs.owner_ && idx_ == rhs.idx_;
+        }
+        bool operator!=(const const_iterator &rhs) const {
+            return !(*this == rhs);
+        }
+    };
+
+    explicit compressed_int_vector(int_encoding encoding = int_encoding::frame_of_reference)
+        : encoding_(encoding) { }
+    compressed_int_vector(const vector<long long> &values,
+                          int_encoding encoding = int_encoding::frame_of_reference)
+        : encoding_(encoding) {
+        headers_.reserve(values.size() / kBlockSize);
+        for (size_t i = 0; i < values.size(); ++i) {
+            push_back(values[i]);
+        }
+    }
+
+    void push_back(const long long &value) {
+        tail_[tail_size_++] = value;
+        if (tail_size_ == kBlockSize) {
+            seal_tail();
+        }
+    }
+    /**
+     * throw index_out_of_bound if pos is not in [0, size)
+     */
+    long long at(const size_t &pos) const {
+        if (pos >= size()) {
+            throw index_out_of_bound();
+        }
+        size_t sum_idx = kNoSum;
+        unsigned long long sum;
+        return value_at(pos, sum_idx, sum);
+    }
+    long long operator[](const size_t &pos) const {
+        return at(pos);
+    }
+    /**
+     * writes every value to out[0, size()).
+     */
+    void decode(long long *out) const {
+        for (size_t b = 0; b * kBlockSize < size(); ++b) {
+            decode_block(b, out + b * kBlockSize);
+        }
+    }
+    /**
+     * calls f(value) for every value in order, a block at a time.
+     */
+    template <typename F>
+    void for_each(F f) const {
+        long long buf[kBlockSize];
+        for (size_t b = 0; b * kBlockSize < size(); ++b) {
+            size_t n = decode_block(b, buf);
+            for (size_t k = 0; k < n; ++k) {
+                f(buf[k]);
+            }
+        }
+    }
+    const_iterator begin() const {
+        return const_iterator(this, 0);
+    }
+    const_iterator end() const {
+        return const_iterator(this, size());
+    }
+
+    size_t size() const {
+        return headers_.size() * kBlockSize + tail_size_;
+    }
+    bool empty() const {
+        return size() == 0;
+    }
+    int_encoding encoding() const {
+        return encoding_;
+    }
+    /**
+     * bytes held for the packed words, block headers and unpacked tail.
+     */
+    size_t memory_usage() const {
+        return words_.capacity() * sizeof(unsigned) + headers_.capacity() * sizeof(block_header) + sizeof(tail_);
+    }
+    void clear() {
+        words_.clear();
+        headers_.clear();
+        tail_size_ = 0;
+    }
+
+private:
+    struct block_header {
+        // frame_of_reference: the minimum value; delta: the block's first value
+        unsigned long long base;
+        // delta only: the minimum difference, added back to every offset
+        unsigned long long delta_base;
+        size_t word_offset;
+        unsigned bits;
+    };
+
+    int_encoding encoding_;
+    vector<unsigned> words_;
+    vector<block_header> headers_;
+    long long tail_[kBlockSize];
+    size_t tail_size_ = 0;
+
+    static constexpr size_t kNoSum = static_cast<size_t>(-1);
+
+    /**
+     * the value at pos < size(). for delta, sum is the running sum up to
+     * index sum_idx; it is extended when sum_idx is at or before pos in the
+     * same block, restarted from the block's first value otherwise, and
+     * left at pos.
+     */
+    long long value_at(size_t pos, size_t &sum_idx, unsigned long long &sum) const {
+        size_t b = pos / kBlockSize, k = pos % kBlockSize;
+        if (b == headers_.size()) {
+            return tail_[k];
+        }
+        const block_header &h = headers_[b];
+        const unsigned *words = words_.data() + h.word_offset;
+        if (encoding_ == int_encoding::frame_of_reference) {
+            return static_cast<long long>(h.base + detail::unpack_one(words, h.bits, k));
+        }
+        size_t j = 0;
+        unsigned long long acc = h.base;
+        if (sum_idx != kNoSum && sum_idx / kBlockSize == b && sum_idx % kBlockSize <= k) {
+            j = sum_idx % kBlockSize;
+            acc = sum;
+        }
+        for (++j; j <= k; ++j) {
+            acc += h.delta_base + detail::unpack_one(words, h.bits, j);
+        }
+        sum_idx = pos;
+        sum = acc;
+        return static_cast<long long>(acc);
+    }
+    static unsigned bit_width(unsigned long long range) {
+        unsigned bits = range ? 64 - __builtin_clzll(range) : 0;
+        return bits > 32 ? 64 : bits;
+    }
+    /**
+     * packs the 128 values of tail_ into a new block. the arithmetic is
+     * modulo 2^64, so any range of long long round-trips.
+     */
+    void seal_tail() {
+        unsigned long long offsets[kBlockSize];
+        block_header h;
+        h.delta_base = 0;
+        if (encoding_ == int_encoding::frame_of_reference) {
+            long long mn = tail_[0], mx = tail_[0];
+            for (size_t k = 1; k < kBlockSize; ++k) {
+                mn = tail_[k] < mn ? tail_[k] : mn;
+                mx = tail_[k] > mx ? tail_[k] : mx;
+            }
+            h.base = static_cast<unsigned long long>(mn);
+            for (size_t k = 0; k < kBlockSize; ++k) {
+                offsets[k] = static_cast<unsigned long long>(tail_[k]) - h.base;
+            }
+            h.bits = bit_width(static_cast<unsigned long long>(mx) - h.base);
+        } else {
+            h.base = static_cast<unsigned long long>(tail_[0]);
+            long long diff[kBlockSize];
+            diff[0] = 0;
+            long long mn = 0, mx = 0;
+            for (size_t k = 1; k < kBlockSize; ++k) {
+                diff[k] = static_cast<long long>(static_cast<unsigned long long>(tail_[k]) -
+                                                 static_cast<unsigned long long>(tail_[k - 1]));
+                mn = diff[k] < mn ? diff[k] : mn;
+                mx = diff[k] > mx ? diff[k] : mx;
+            }
+            h.delta_base = static_cast<unsigned long long>(mn);
+            for (size_t k = 0; k < kBlockSize; ++k) {
+                offsets[k] = static_cast<unsigned long long>(diff[k]) - h.delta_base;
+            }
+            h.bits = bit_width(static_cast<unsigned long long>(mx) - h.delta_base);
+        }
+        h.word_offset = words_.size();
+        words_.append_with(4 * h.bits, [&](unsigned *p, size_t) {
+            if (h.bits) {
+                detail::pack_block(p, offsets, h.bits);
+            }
+        });
+        headers_.push_back(h);
+        tail_size_ = 0;
+    }
+    /**
+     * writes block b to out and returns the number of values in it.
+     */
+    size_t decode_block(size_t b, long long *out) const {
+        if (b == headers_.size()) {
+            memcpy(out, tail_, tail_size_ * sizeof(long long));
+            return tail_size_;
+        }
+        const block_header &h = headers_[b];
+        unsigned long long *u = reinterpret_cast<unsigned long long *>(out);
+        if (encoding_ == int_encoding::frame_of_reference) {
+            detail::unpack_block(words_.data() + h.word_offset, h.bits, h.base, u);
+        } else {
+            detail::unpack_block(words_.data() + h.word_offset, h.bits, h.delta_base, u);
+            // the first difference is 0, so a running sum from base restores the values
+            unsigned long long acc = h.base;
+            for (size_t k = 0; k < kBlockSize; ++k) {
+                acc += u[k];
+                u[k] = acc;
+            }
+        }
+        return kBlockSize;
+    }
+};
+
+}  // namespace sjtu
+
+#endif
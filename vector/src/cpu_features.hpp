@@ -0,0 +1,54 @@
+#ifndef SJTU_CPU_FEATURES_HPP
+#define SJTU_CPU_FEATURES_HPP
+
+/**
+ * runtime detection of the SIMD extensions the kernels in this directory
+ * are written for. SJTU_X86_SIMD is defined when the AVX2/SSE4.2 kernels
+ * are compiled at all, they are then selected per call by simd_level().
+ */
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SJTU_X86_SIMD 1
+#define SJTU_TARGET_AVX2 __attribute__((target("avx2,popcnt")))
+#define SJTU_TARGET_SSE42 __attribute__((target("sse4.2,popcnt")))
+#define SJTU_TARGET_AVX2_FMA __attribute__((target("avx2,fma")))
+#include <immintrin.h>
+#endif
+
+namespace sjtu {
+namespace detail {
+
+enum class simd_level { scalar, sse42, avx2 };
+
+/**
+ * returns the widest instruction set supported by the running CPU,
+ * the answer is computed once per program.
+ */
+inline simd_level cpu_simd_level() {
+#ifdef SJTU_X86_SIMD
+    static const simd_level level =
+        __builtin_cpu_supports("avx2")     ? simd_level::avx2
+        : __builtin_cpu_supports("sse4.2") ? simd_level::sse42
+                                           : simd_level::scalar;
+    return level;
+#else
+    return simd_level::scalar;
+#endif
+}
+
+/**
+ * whether the running CPU has fused multiply-add, which the floating
+ * point kernels need on top of AVX2.
+ */
+inline bool cpu_has_fma() {
+#ifdef SJTU_X86_SIMD
+    static const bool fma = __builtin_cpu_supports("fma");
+    return fma;
+#else
+    return false;
+#endif
+}
+
+}  // namespace detail
+}  // namespace sjtu
+
+#endif
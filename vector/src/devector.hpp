@@ -0,0 +1,461 @@
+#ifndef SJTU_DEVECTOR_HPP
+#define SJTU_DEVECTOR_HPP
+
+#include "exceptions.hpp"
+#include "ranges.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu {
+
+/**
+ * the end of a devector that ran out of room.
+ */
+enum class devector_side { front, back };
+
+/**
+ * growth policies decide how a devector makes room.
+ *   new_capacity(capacity, need) returns the capacity of a reallocation
+ *     that has to hold at least need elements;
+ *   front_gap(free, side) returns how many of free spare slots are put in
+ *     front of the elements after growing towards side, the rest is put
+ *     behind them.
+ * the default policy doubles and gives three quarters of the spare room to
+ * the side that ran out, so a devector only pushed at one end behaves like
+ * a vector and one pushed at both ends stays amortized O(1) at both.
+ */
+struct devector_growth_policy {
+    static size_t new_capacity(size_t capacity, size_t need) {
+        size_t cap = capacity ? capacity * 2 : 4;
+        return cap < need ? need : cap;
+    }
+    static size_t front_gap(size_t free, devector_side side) {
+        return side == devector_side::front ? free - free / 4 : free / 4;
+    }
+};
+
+/**
+ * splits the spare room evenly, for sequences pushed at both ends about
+ * equally often.
+ */
+struct devector_balanced_policy {
+    static size_t new_capacity(size_t capacity, size_t need) {
+        size_t cap = capacity ? capacity * 2 : 4;
+        return cap < need ? need : cap;
+    }
+    static size_t front_gap(size_t free, devector_side) {
+        return free / 2;
+    }
+};
+
+/**
+ * a vector with spare capacity at both ends: push_front and push_back are
+ * both amortized O(1) while the elements stay in one successive range
+ * [data(), data() + size()).
+ * when one end is full but at least half of the buffer is free, the
+ * elements are moved inside the buffer instead of reallocating, so a
+ * devector used as a queue does not grow without bound.
+ */
+template <typename T, typename GrowthPolicy = devector_growth_policy>
+class devector {
+public:
+    using value_type = T;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    devector() { }
+    devector(const devector &other) {
+        if (other.size_ == 0) {
+            return;
+        }
+        buffer_ = allocate(other.size_);
+        capacity_ = other.size_;
+        for (; size_ < other.size_; ++size_) {
+            try {
+                new (buffer_ + size_) T(other.buffer_[other.begin_ + size_]);
+            } catch (...) {
+                clear();
+                free(buffer_);
+                throw;
+            }
+        }
+    }
+    devector(devector &&other) noexcept {
+        swap(other);
+    }
+    template <detail::container_compatible_range<T> R>
+    devector(from_range_t, R &&rg) {
+        try {
+            append_range(std::forward<R>(rg));
+        } catch (...) {
+            clear();
+            free(buffer_);
+            throw;
+        }
+    }
+    ~devector() {
+        clear();
+        free(buffer_);
+    }
+    devector &operator=(const devector &other) {
+        if (this == &other) {
+            return *this;
+        }
+        devector tmp(other);
+        swap(tmp);
+        return *this;
+    }
+    devector &operator=(devector &&other) noexcept {
+        swap(other);
+        return *this;
+    }
+    void swap(devector &other) noexcept {
+        std::swap(buffer_, other.buffer_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(begin_, other.begin_);
+        std::swap(size_, other.size_);
+    }
+
+    /**
+     * throw index_out_of_bound if pos is not in [0, size)
+     */
+    T &at(const size_t &pos) {
+        if (pos >= size_) {
+            throw index_out_of_bound();
+        }
+        return buffer_[begin_ + pos];
+    }
+    const T &at(const size_t &pos) const {
+        if (pos >= size_) {
+            throw index_out_of_bound();
+        }
+        return buffer_[begin_ + pos];
+    }
+    T &operator[](const size_t &pos) {
+        return at(pos);
+    }
+    const T &operator[](const size_t &pos) const {
+        return at(pos);
+    }
+    /**
+     * throw container_is_empty if size == 0
+     */
+    T &front() {
+        if (size_ == 0) {
+            throw container_is_empty();
+        }
+        return buffer_[begin_];
+    }
+    const T &front() const {
+        if (size_ == 0) {
+            throw container_is_empty();
+        }
+        return buffer_[begin_];
+    }
+    /**
+     * throw container_is_empty if size == 0
+     */
+    T &back() {
+        if (size_ == 0) {
+            throw container_is_empty();
+        }
+        return buffer_[begin_ + size_ - 1];
+    }
+    const T &back() const {
+        if (size_ == 0) {
+            throw container_is_empty();
+        }
+        return buffer_[begin_ + size_ - 1];
+    }
+    T *data() {
+        return buffer_ + begin_;
+    }
+    const T *data() const {
+        return buffer_ + begin_;
+    }
+    iterator begin() {
+        return data();
+    }
+    const_iterator begin() const {
+        return data();
+    }
+    const_iterator cbegin() const {
+        return data();
+    }
+    iterator end() {
+        return data() + size_;
+    }
+    const_iterator end() const {
+        return data() + size_;
+    }
+    const_iterator cend() const {
+        return data() + size_;
+    }
+
+    bool empty() const {
+        return size_ == 0;
+    }
+    size_t size() const {
+        return size_;
+    }
+    size_t capacity() const {
+        return capacity_;
+    }
+    /**
+     * the number of elements push_front can add without moving anything.
+     */
+    size_t front_free_capacity() const {
+        return begin_;
+    }
+    /**
+     * the number of elements push_back can add without moving anything.
+     */
+    size_t back_free_capacity() const {
+        return capacity_ - begin_ - size_;
+    }
+    /**
+     * makes room for at least n elements behind data() without
+     * reallocation, the room in front is kept.
+     */
+    void reserve(const size_t &n) {
+        if (n > capacity_ - begin_) {
+            reallocate(begin_ + n, begin_);
+        }
+    }
+    /**
+     * makes room for at least n elements ending at data() + size() without
+     * reallocation, the room behind is kept.
+     */
+    void reserve_front(const size_t &n) {
+        if (n > begin_ + size_) {
+            reallocate(capacity_ - begin_ - size_ + n, n - size_);
+        }
+    }
+    void clear() {
+        for (size_t i = 0; i < size_; ++i) {
+            buffer_[begin_ + i].~T();
+        }
+        size_ = 0;
+    }
+
+    void push_back(const T &value) {
+        emplace_back(value);
+    }
+    void push_back(T &&value) {
+        emplace_back(std::move(value));
+    }
+    template <typename... Args>
+    T &emplace_back(Args &&...args) {
+        if (back_free_capacity() == 0) {
+            // the argument may live in this devector, build it before moving anything
+            T tmp(std::forward<Args>(args)...);
+            make_room(devector_side::back);
+            new (buffer_ + begin_ + size_) T(std::move(tmp));
+        } else {
+            new (buffer_ + begin_ + size_) T(std::forward<Args>(args)...);
+        }
+        return buffer_[begin_ + size_++];
+    }
+    /**
+     * appends every element of rg, growing at most once when the length of
+     * rg is known in advance.
+     */
+    template <detail::container_compatible_range<T> R>
+    void append_range(R &&rg) {
+        size_t n = detail::range_size_hint(rg);
+        if (n > back_free_capacity()) {
+            reserve(size_ + n > 2 * size_ ? size_ + n : 2 * size_);
+        }
+        for (auto &&x : rg) {
+            emplace_back(std::forward<decltype(x)>(x));
+        }
+    }
+    void push_front(const T &value) {
+        emplace_front(value);
+    }
+    void push_front(T &&value) {
+        emplace_front(std::move(value));
+    }
+    template <typename... Args>
+    T &emplace_front(Args &&...args) {
+        if (begin_ == 0) {
+            T tmp(std::forward<Args>(args)...);
+            make_room(devector_side::front);
+            new (buffer_ + begin_ - 1) T(std::move(tmp));
+        } else {
+            new (buffer_ + begin_ - 1) T(std::forward<Args>(args)...);
+        }
+        --begin_;
+        ++size_;
+        return buffer_[begin_];
+    }
+    /**
+     * throw container_is_empty if size() == 0
+     */
+    void pop_back() {
+        if (size_ == 0) {
+            throw container_is_empty();
+        }
+        --size_;
+        buffer_[begin_ + size_].~T();
+    }
+    /**
+     * throw container_is_empty if size() == 0
+     */
+    void pop_front() {
+        if (size_ == 0) {
+            throw container_is_empty();
+        }
+        buffer_[begin_].~T();
+        ++begin_;
+        --size_;
+    }
+    /**
+     * inserts value at index ind, shifting whichever side of ind is shorter.
+     * returns an iterator pointing to the inserted value.
+     * throw index_out_of_bound if ind > size
+     */
+    iterator insert(const size_t &ind, const T &value) {
+        if (ind > size_) {
+            throw index_out_of_bound();
+        }
+        T tmp(value);
+        if (ind < size_ - ind) {
+            if (begin_ == 0) {
+                make_room(devector_side::front);
+            }
+            T *p = buffer_ + begin_;
+            if (ind == 0) {
+                new (p - 1) T(std::move(tmp));
+            } else {
+                new (p - 1) T(std::move(p[0]));
+                for (size_t i = 0; i + 1 < ind; ++i) {
+                    p[i] = std::move(p[i + 1]);
+                }
+                p[ind - 1] = std::move(tmp);
+            }
+            --begin_;
+        } else {
+            if (back_free_capacity() == 0) {
+                make_room(devector_side::back);
+            }
+            T *p = buffer_ + begin_;
+            if (ind == size_) {
+                new (p + size_) T(std::move(tmp));
+            } else {
+                new (p + size_) T(std::move(p[size_ - 1]));
+                for (size_t i = size_ - 1; i > ind; --i) {
+                    p[i] = std::move(p[i - 1]);
+                }
+                p[ind] = std::move(tmp);
+            }
+        }
+        ++size_;
+        return buffer_ + begin_ + ind;
+    }
+    /**
+     * removes the element at index ind, shifting whichever side of ind is
+     * shorter. returns an iterator pointing to the following element.
+     * throw index_out_of_bound if ind >= size
+     */
+    iterator erase(const size_t &ind) {
+        if (ind >= size_) {
+            throw index_out_of_bound();
+        }
+        T *p = buffer_ + begin_;
+        if (ind < size_ - 1 - ind) {
+            for (size_t i = ind; i > 0; --i) {
+                p[i] = std::move(p[i - 1]);
+            }
+            p[0].~T();
+            ++begin_;
+        } else {
+            for (size_t i = ind; i + 1 < size_; ++i) {
+                p[i] = std::move(p[i + 1]);
+            }
+            p[size_ - 1].~T();
+        }
+        --size_;
+        return buffer_ + begin_ + ind;
+    }
+
+private:
+    T *buffer_ = nullptr;
+    size_t capacity_ = 0;
+    // the elements are buffer_[begin_, begin_ + size_)
+    size_t begin_ = 0;
+    size_t size_ = 0;
+
+    static T *allocate(size_t n) {
+        T *p = reinterpret_cast<T *>(malloc(n * sizeof(T)));
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+    /**
+     * moves the elements to dst, which may overlap the current range.
+     */
+    void relocate(T *dst) {
+        T *src = buffer_ + begin_;
+        if (dst == src || size_ == 0) {
+            return;
+        }
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            memmove(dst, src, size_ * sizeof(T));
+        } else if (dst < src) {
+            for (size_t i = 0; i < size_; ++i) {
+                new (dst + i) T(std::move(src[i]));
+                src[i].~T();
+            }
+        } else {
+            for (size_t i = size_; i-- > 0;) {
+                new (dst + i) T(std::move(src[i]));
+                src[i].~T();
+            }
+        }
+    }
+    void reallocate(size_t new_capacity, size_t new_begin) {
+        T *fresh = allocate(new_capacity);
+        relocate(fresh + new_begin);
+        free(buffer_);
+        buffer_ = fresh;
+        capacity_ = new_capacity;
+        begin_ = new_begin;
+    }
+    /**
+     * gives side at least one free slot, by recentring if at least half of
+     * the buffer is free and by reallocating otherwise.
+     */
+    void make_room(devector_side side) {
+        size_t cap = capacity_;
+        if (size_ >= capacity_ - size_) {
+            cap = GrowthPolicy::new_capacity(capacity_, size_ + 1);
+        }
+        size_t free_slots = cap - size_;
+        size_t gap = GrowthPolicy::front_gap(free_slots, side);
+        if (gap > free_slots) {
+            gap = free_slots;
+        }
+        if (side == devector_side::front && gap == 0) {
+            gap = 1;
+        } else if (side == devector_side::back && gap == free_slots) {
+            gap = free_slots - 1;
+        }
+        if (cap == capacity_) {
+            relocate(buffer_ + gap);
+            begin_ = gap;
+        } else {
+            reallocate(cap, gap);
+        }
+    }
+};
+
+}  // namespace sjtu
+
+#endif
@@ -0,0 +1,251 @@
+#ifndef SJTU_FAST_OUTPUT_HPP
+#define SJTU_FAST_OUTPUT_HPP
+
+#include "exceptions.hpp"
+#include "vector.hpp"
+
+#include <cerrno>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <unistd.h>
+
+namespace sjtu {
+namespace detail {
+
+/**
+ * "00" "01" ... "99": integers are written two digits per table lookup,
+ * which halves the number of divisions.
+ */
+constexpr char kDigitPairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/**
+ * writes the decimal digits of value so that they end at end, returns
+ * where they begin. 20 bytes in front of end are always enough.
+ */
+inline char *format_unsigned(unsigned long long value, char *end) {
+    while (value >= 100) {
+        unsigned pair = static_cast<unsigned>(value % 100) * 2;
+        value /= 100;
+        *--end = kDigitPairs[pair + 1];
+        *--end = kDigitPairs[pair];
+    }
+    if (value >= 10) {
+        *--end = kDigitPairs[value * 2 + 1];
+        *--end = kDigitPairs[value * 2];
+    } else {
+        *--end = static_cast<char>('0' + value);
+    }
+    return end;
+}
+
+}  // namespace detail
+
+/**
+ * a buffered writer on a file descriptor, for printing many numbers:
+ *   sjtu::output_writer out;  // standard output
+ *   out << n << ' ' << x << '\n';
+ * numbers are formatted into the buffer directly, without locales, stream
+ * flags or stdio locking, and the buffer reaches the descriptor with one
+ * write(2) per buffer size; blocks at least that large skip the buffer.
+ * integers are written in full, floating point values in their shortest
+ * form that reads back to the same value.
+ * the writer does not share a buffer with std::cout, flush one before
+ * writing through the other to the same descriptor.
+ */
+class output_writer {
+public:
+    static constexpr size_t kDefaultBufferSize = size_t(1) << 16;
+    // room for the longest number written in one piece
+    static constexpr size_t kMaxNumberLength = 64;
+    // room for write_fixed of every double below 10^300 with 8 decimals
+    static constexpr size_t kFixedLength = 320;
+
+    explicit output_writer(int fd = 1, size_t buffer_size = kDefaultBufferSize)
+        : fd_(fd), capacity_(buffer_size < kMaxNumberLength ? kMaxNumberLength : buffer_size) {
+        buffer_ = static_cast<char *>(malloc(capacity_));
+        if (buffer_ == nullptr) {
+            throw std::bad_alloc();
+        }
+    }
+    output_writer(const output_writer &) = delete;
+    output_writer &operator=(const output_writer &) = delete;
+    /**
+     * flushes what is left, an error at this point is ignored.
+     */
+    ~output_writer() {
+        try {
+            flush();
+        } catch (...) {
+        }
+        free(buffer_);
+    }
+
+    /**
+     * hands the buffered bytes to the descriptor.
+     * throw runtime_error if write(2) fails
+     */
+    void flush() {
+        write_fd(buffer_, size_);
+        size_ = 0;
+    }
+    /**
+     * the number of bytes waiting in the buffer.
+     */
+    size_t buffered() const {
+        return size_;
+    }
+
+    output_writer &put(char c) {
+        if (size_ == capacity_) {
+            flush();
+        }
+        buffer_[size_++] = c;
+        return *this;
+    }
+    output_writer &write(const char *s, size_t n) {
+        if (n > capacity_ - size_) {
+            flush();
+            if (n >= capacity_) {
+                write_fd(s, n);
+                return *this;
+            }
+        }
+        memcpy(buffer_ + size_, s, n);
+        size_ += n;
+        return *this;
+    }
+    output_writer &operator<<(char c) {
+        return put(c);
+    }
+    output_writer &operator<<(std::string_view s) {
+        return write(s.data(), s.size());
+    }
+    output_writer &operator<<(const char *s) {
+        return write(s, strlen(s));
+    }
+    template <std::integral Int>
+    output_writer &operator<<(Int value) {
+        return write_int(value);
+    }
+    template <std::floating_point Float>
+    output_writer &operator<<(Float value) {
+        char *p = reserve(kMaxNumberLength);
+        size_ = std::to_chars(p, p + kMaxNumberLength, value).ptr - buffer_;
+        return *this;
+    }
+
+    /**
+     * writes value right-aligned in a field of width characters.
+     */
+    template <std::integral Int>
+    output_writer &write_int(Int value, size_t width = 0) {
+        char digits[24];
+        char *end = digits + sizeof(digits);
+        char *begin;
+        if constexpr (std::is_signed_v<Int>) {
+            // negate as unsigned, -LLONG_MIN does not fit in long long
+            unsigned long long magnitude = value < 0 ? 0ULL - static_cast<unsigned long long>(value)
+                                                     : static_cast<unsigned long long>(value);
+            begin = detail::format_unsigned(magnitude, end);
+            if (value < 0) {
+                *--begin = '-';
+            }
+        } else {
+            begin = detail::format_unsigned(value, end);
+        }
+        return write_padded(begin, end - begin, width);
+    }
+    /**
+     * writes value with precision digits after the point, right-aligned
+     * in a field of width characters, like std::fixed and std::setw, for
+     * values of any magnitude.
+     */
+    template <std::floating_point Float>
+    output_writer &write_fixed(Float value, int precision, size_t width = 0) {
+        char text[kFixedLength];
+        std::to_chars_result r = std::to_chars(text, text + sizeof(text), value, std::chars_format::fixed, precision);
+        if (r.ec == std::errc()) {
+            return write_padded(text, r.ptr - text, width);
+        }
+        // a huge value or precision: room for every digit of the largest
+        // finite value, its sign and point, and the decimals
+        size_t length = std::numeric_limits<Float>::max_exponent10 + 3 + static_cast<size_t>(precision > 6 ? precision : 6);
+        char *big = static_cast<char *>(malloc(length));
+        if (big == nullptr) {
+            throw std::bad_alloc();
+        }
+        r = std::to_chars(big, big + length, value, std::chars_format::fixed, precision);
+        try {
+            write_padded(big, r.ptr - big, width);
+        } catch (...) {
+            free(big);
+            throw;
+        }
+        free(big);
+        return *this;
+    }
+
+private:
+    int fd_;
+    char *buffer_;
+    size_t size_ = 0;
+    size_t capacity_;
+
+    /**
+     * makes room for n bytes at the end of the buffer and returns it.
+     */
+    char *reserve(size_t n) {
+        if (n > capacity_ - size_) {
+            flush();
+        }
+        return buffer_ + size_;
+    }
+    output_writer &write_padded(const char *s, size_t n, size_t width) {
+        while (width > n) {
+            put(' ');
+            --width;
+        }
+        return write(s, n);
+    }
+    void write_fd(const char *s, size_t n) {
+        while (n > 0) {
+            ssize_t written = ::write(fd_, s, n);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw runtime_error();
+            }
+            s += written;
+            n -= written;
+        }
+    }
+};
+
+/**
+ * writes the elements of v separated by single spaces.
+ */
+template <typename T>
+output_writer &operator<<(output_writer &out, const vector<T> &v) {
+    for (size_t i = 0; i < v.size(); i++) {
+        if (i) {
+            out.put(' ');
+        }
+        out << v.data()[i];
+    }
+    return out;
+}
+
+}  // namespace sjtu
+
+#endif
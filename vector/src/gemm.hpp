@@ -0,0 +1,244 @@
+#ifndef SJTU_GEMM_HPP
+#define SJTU_GEMM_HPP
+
+#include "cpu_features.hpp"
+
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace sjtu {
+namespace detail {
+
+/**
+ * the blocking of gemm: a kc x nc slice of B and an mc x kc block of A
+ * are packed into panels of kGemmNR columns and kGemmMR rows, sized so
+ * the A block stays in L2 and one B panel in L1 while the micro-kernel
+ * accumulates an MR x NR tile of C in registers.
+ */
+constexpr size_t kGemmMR = 6;
+constexpr size_t kGemmNR = 8;
+constexpr size_t kGemmKC = 256;
+constexpr size_t kGemmMC = 72;
+constexpr size_t kGemmNC = 4096;
+constexpr size_t kGemmMaxThreads = 8;
+// products with fewer multiply-adds than this run on the calling thread
+constexpr size_t kGemmThreadWork = size_t(1) << 24;
+
+/**
+ * packs the mc x kc block of op(A) at (i0, p0) into panels of kGemmMR
+ * rows, each stored column after column, the last one padded with zeros.
+ */
+template <typename T>
+void gemm_pack_a(const T *a, size_t lda, bool trans, size_t i0, size_t p0, size_t mc, size_t kc, T *dst) {
+    for (size_t ir = 0; ir < mc; ir += kGemmMR) {
+        size_t mr = mc - ir < kGemmMR ? mc - ir : kGemmMR;
+        for (size_t p = 0; p < kc; ++p) {
+            for (size_t r = 0; r < kGemmMR; ++r) {
+                size_t i = i0 + ir + r;
+                *dst++ = r >= mr ? T(0) : trans ? a[(p0 + p) * lda + i] : a[i * lda + p0 + p];
+            }
+        }
+    }
+}
+
+/**
+ * packs the kc x nc slice of op(B) at (p0, j0) into panels of kGemmNR
+ * columns, each stored row after row, the last one padded with zeros.
+ */
+template <typename T>
+void gemm_pack_b(const T *b, size_t ldb, bool trans, size_t p0, size_t j0, size_t kc, size_t nc, T *dst) {
+    for (size_t jr = 0; jr < nc; jr += kGemmNR) {
+        size_t nr = nc - jr < kGemmNR ? nc - jr : kGemmNR;
+        for (size_t p = 0; p < kc; ++p) {
+            for (size_t c = 0; c < kGemmNR; ++c) {
+                size_t j = j0 + jr + c;
+                *dst++ = c >= nr ? T(0) : trans ? b[j * ldb + p0 + p] : b[(p0 + p) * ldb + j];
+            }
+        }
+    }
+}
+
+/**
+ * C -= A * B for one packed A panel and one packed B panel, of which
+ * only the top-left mr x nr corner of the tile is written back.
+ */
+template <typename T>
+void gemm_micro_scalar(size_t kc, const T *a, const T *b, T *c, size_t ldc, size_t mr, size_t nr) {
+    T acc[kGemmMR][kGemmNR] = {};
+    for (size_t p = 0; p < kc; ++p, a += kGemmMR, b += kGemmNR) {
+        for (size_t i = 0; i < kGemmMR; ++i) {
+            for (size_t j = 0; j < kGemmNR; ++j) {
+                acc[i][j] += a[i] * b[j];
+            }
+        }
+    }
+    for (size_t i = 0; i < mr; ++i) {
+        for (size_t j = 0; j < nr; ++j) {
+            c[i * ldc + j] -= acc[i][j];
+        }
+    }
+}
+
+#ifdef SJTU_X86_SIMD
+
+// the 6 x 8 tile is 12 accumulators, which leaves 4 of the 16 registers
+// for the two B vectors and the broadcast A element. they are separate
+// variables, an array of them is kept in memory.
+SJTU_TARGET_AVX2_FMA inline void gemm_micro_avx2(size_t kc, const double *a, const double *b, double *c, size_t ldc,
+                                                 size_t mr, size_t nr) {
+    __m256d c00 = _mm256_setzero_pd(), c01 = c00, c10 = c00, c11 = c00, c20 = c00, c21 = c00;
+    __m256d c30 = c00, c31 = c00, c40 = c00, c41 = c00, c50 = c00, c51 = c00;
+    for (size_t p = 0; p < kc; ++p, a += kGemmMR, b += kGemmNR) {
+        __m256d b0 = _mm256_loadu_pd(b);
+        __m256d b1 = _mm256_loadu_pd(b + 4);
+        __m256d ai = _mm256_broadcast_sd(a);
+        c00 = _mm256_fmadd_pd(ai, b0, c00);
+        c01 = _mm256_fmadd_pd(ai, b1, c01);
+        ai = _mm256_broadcast_sd(a + 1);
+        c10 = _mm256_fmadd_pd(ai, b0, c10);
+        c11 = _mm256_fmadd_pd(ai, b1, c11);
+        ai = _mm256_broadcast_sd(a + 2);
+        c20 = _mm256_fmadd_pd(ai, b0, c20);
+        c21 = _mm256_fmadd_pd(ai, b1, c21);
+        ai = _mm256_broadcast_sd(a + 3);
+        c30 = _mm256_fmadd_pd(ai, b0, c30);
+        c31 = _mm256_fmadd_pd(ai, b1, c31);
+        ai = _mm256_broadcast_sd(a + 4);
+        c40 = _mm256_fmadd_pd(ai, b0, c40);
+        c41 = _mm256_fmadd_pd(ai, b1, c41);
+        ai = _mm256_broadcast_sd(a + 5);
+        c50 = _mm256_fmadd_pd(ai, b0, c50);
+        c51 = _mm256_fmadd_pd(ai, b1, c51);
+    }
+    alignas(32) double tile[kGemmMR][kGemmNR];
+    _mm256_store_pd(tile[0], c00);
+    _mm256_store_pd(tile[0] + 4, c01);
+    _mm256_store_pd(tile[1], c10);
+    _mm256_store_pd(tile[1] + 4, c11);
+    _mm256_store_pd(tile[2], c20);
+    _mm256_store_pd(tile[2] + 4, c21);
+    _mm256_store_pd(tile[3], c30);
+    _mm256_store_pd(tile[3] + 4, c31);
+    _mm256_store_pd(tile[4], c40);
+    _mm256_store_pd(tile[4] + 4, c41);
+    _mm256_store_pd(tile[5], c50);
+    _mm256_store_pd(tile[5] + 4, c51);
+    if (mr == kGemmMR && nr == kGemmNR) {
+        for (size_t i = 0; i < kGemmMR; ++i) {
+            double *row = c + i * ldc;
+            _mm256_storeu_pd(row, _mm256_sub_pd(_mm256_loadu_pd(row), _mm256_load_pd(tile[i])));
+            _mm256_storeu_pd(row + 4, _mm256_sub_pd(_mm256_loadu_pd(row + 4), _mm256_load_pd(tile[i] + 4)));
+        }
+        return;
+    }
+    for (size_t i = 0; i < mr; ++i) {
+        for (size_t j = 0; j < nr; ++j) {
+            c[i * ldc + j] -= tile[i][j];
+        }
+    }
+}
+
+#endif
+
+template <typename T>
+bool gemm_use_avx2() {
+#ifdef SJTU_X86_SIMD
+    if constexpr (std::is_same_v<T, double>) {
+        return cpu_simd_level() == simd_level::avx2 && cpu_has_fma();
+    }
+#endif
+    return false;
+}
+
+/**
+ * rows [m0, m1) of C -= op(A) * op(B), packing into pack_a and pack_b.
+ */
+template <typename T>
+void gemm_rows(size_t m0, size_t m1, size_t n, size_t k, const T *a, size_t lda, bool trans_a, const T *b,
+               size_t ldb, bool trans_b, T *c, size_t ldc, T *pack_a, T *pack_b) {
+    [[maybe_unused]] const bool simd = gemm_use_avx2<T>();
+    for (size_t jc = 0; jc < n; jc += kGemmNC) {
+        size_t nc = n - jc < kGemmNC ? n - jc : kGemmNC;
+        for (size_t pc = 0; pc < k; pc += kGemmKC) {
+            size_t kc = k - pc < kGemmKC ? k - pc : kGemmKC;
+            gemm_pack_b(b, ldb, trans_b, pc, jc, kc, nc, pack_b);
+            for (size_t ic = m0; ic < m1; ic += kGemmMC) {
+                size_t mc = m1 - ic < kGemmMC ? m1 - ic : kGemmMC;
+                gemm_pack_a(a, lda, trans_a, ic, pc, mc, kc, pack_a);
+                for (size_t jr = 0; jr < nc; jr += kGemmNR) {
+                    size_t nr = nc - jr < kGemmNR ? nc - jr : kGemmNR;
+                    for (size_t ir = 0; ir < mc; ir += kGemmMR) {
+                        size_t mr = mc - ir < kGemmMR ? mc - ir : kGemmMR;
+                        const T *pa = pack_a + ir * kc;
+                        const T *pb = pack_b + jr * kc;
+                        T *pc_tile = c + (ic + ir) * ldc + jc + jr;
+#ifdef SJTU_X86_SIMD
+                        if constexpr (std::is_same_v<T, double>) {
+                            if (simd) {
+                                gemm_micro_avx2(kc, pa, pb, pc_tile, ldc, mr, nr);
+                                continue;
+                            }
+                        }
+#endif
+                        gemm_micro_scalar(kc, pa, pb, pc_tile, ldc, mr, nr);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * C -= op(A) * op(B) for row-major matrices: op(A) is m x k, op(B) is
+ * k x n and C is m x n, with leading dimensions lda, ldb and ldc. with
+ * trans_a (trans_b) set, A (B) is stored transposed, k x m (n x k).
+ * large products are split by rows across up to kGemmMaxThreads threads,
+ * each packing its own panels.
+ */
+template <typename T>
+void gemm(size_t m, size_t n, size_t k, const T *a, size_t lda, bool trans_a, const T *b, size_t ldb,
+          bool trans_b, T *c, size_t ldc) {
+    if (m == 0 || n == 0 || k == 0) {
+        return;
+    }
+    size_t threads = std::thread::hardware_concurrency();
+    threads = threads < 1 ? 1 : threads > kGemmMaxThreads ? kGemmMaxThreads : threads;
+    if (m * n * k < kGemmThreadWork || m < 2 * kGemmMC) {
+        threads = 1;
+    }
+    // whole MC blocks per thread, no two threads write the same row of C
+    size_t chunk = ((m + threads - 1) / threads + kGemmMC - 1) / kGemmMC * kGemmMC;
+    threads = (m + chunk - 1) / chunk;
+    size_t kc = k < kGemmKC ? k : kGemmKC;
+    size_t nc = n < kGemmNC ? n : kGemmNC;
+    size_t a_size = (kGemmMC + kGemmMR) * kc;
+    size_t b_size = (nc + kGemmNR) * kc;
+    // allocated up front, a worker thread must not throw
+    std::vector<T> buffer(threads * (a_size + b_size));
+    std::thread workers[kGemmMaxThreads];
+    size_t started = 0;
+    for (size_t t = 1; t < threads; ++t) {
+        size_t m0 = t * chunk, m1 = m0 + chunk < m ? m0 + chunk : m;
+        T *pack = buffer.data() + t * (a_size + b_size);
+        try {
+            workers[started] = std::thread(gemm_rows<T>, m0, m1, n, k, a, lda, trans_a, b, ldb, trans_b, c, ldc, pack,
+                                           pack + a_size);
+            ++started;
+        } catch (...) {
+            // no thread available, these rows are done here instead
+            gemm_rows<T>(m0, m1, n, k, a, lda, trans_a, b, ldb, trans_b, c, ldc, pack, pack + a_size);
+        }
+    }
+    gemm_rows<T>(0, chunk < m ? chunk : m, n, k, a, lda, trans_a, b, ldb, trans_b, c, ldc, buffer.data(),
+                 buffer.data() + a_size);
+    for (size_t t = 0; t < started; ++t) {
+        workers[t].join();
+    }
+}
+
+}  // namespace detail
+}  // namespace sjtu
+
+#endif
@@ -0,0 +1,357 @@
+#ifndef SJTU_INPLACE_VECTOR_HPP
+#define SJTU_INPLACE_VECTOR_HPP
+
+#include "exceptions.hpp"
+#include "ranges.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu {
+
+namespace detail {
+
+/**
+ * element storage of an inplace_vector. trivial types live in a plain
+ * array, which keeps every operation usable in constant expressions;
+ * others live in raw bytes and are constructed with placement new.
+ * the array is left uninitialised at run time, so an empty vector costs
+ * no stores; constant evaluation may not copy indeterminate values, so
+ * there it is value-initialised.
+ */
+template <typename T, size_t N, bool = std::is_trivial_v<T>>
+struct inplace_storage {
+    T elems_[N];
+
+    constexpr inplace_storage() {
+        if (std::is_constant_evaluated()) {
+            for (size_t i = 0; i < N; ++i) {
+                elems_[i] = T();
+            }
+        }
+    }
+
+    constexpr T *ptr() {
+        return elems_;
+    }
+    constexpr const T *ptr() const {
+        return elems_;
+    }
+};
+
+template <typename T, size_t N>
+struct inplace_storage<T, N, false> {
+    alignas(T) unsigned char bytes_[N * sizeof(T)];
+
+    T *ptr() {
+        return std::launder(reinterpret_cast<T *>(bytes_));
+    }
+    const T *ptr() const {
+        return std::launder(reinterpret_cast<const T *>(bytes_));
+    }
+};
+
+}  // namespace detail
+
+/**
+ * a vector holding at most N elements inside the object itself, it never
+ * touches the heap.
+ * it is trivially copyable when T is, and for trivial T every member
+ * function can be used in constant expressions.
+ * growing past N throws std::bad_alloc, try_push_back reports it instead.
+ */
+template <typename T, size_t N>
+class inplace_vector {
+    static_assert(N > 0, "inplace_vector needs a positive capacity");
+
+public:
+    using value_type = T;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    constexpr inplace_vector() = default;
+    constexpr inplace_vector(const inplace_vector &) requires std::is_trivially_copyable_v<T> = default;
+    inplace_vector(const inplace_vector &other) {
+        append_from(other.data(), other.size_);
+    }
+    constexpr inplace_vector(inplace_vector &&) requires std::is_trivially_copyable_v<T> = default;
+    inplace_vector(inplace_vector &&other) {
+        append_from(std::make_move_iterator(other.data()), other.size_);
+    }
+    /**
+     * throw std::bad_alloc if rg has more than N elements
+     */
+    template <detail::container_compatible_range<T> R>
+    constexpr inplace_vector(from_range_t, R &&rg) {
+        try {
+            append_range(std::forward<R>(rg));
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+    constexpr ~inplace_vector() requires std::is_trivially_destructible_v<T> = default;
+    ~inplace_vector() {
+        clear();
+    }
+    constexpr inplace_vector &operator=(const inplace_vector &) requires std::is_trivially_copyable_v<T> = default;
+    inplace_vector &operator=(const inplace_vector &other) {
+        if (this == &other) {
+            return *this;
+        }
+        clear();
+        append_from(other.data(), other.size_);
+        return *this;
+    }
+    constexpr inplace_vector &operator=(inplace_vector &&) requires std::is_trivially_copyable_v<T> = default;
+    inplace_vector &operator=(inplace_vector &&other) {
+        if (this == &other) {
+            return *this;
+        }
+        clear();
+        append_from(std::make_move_iterator(other.data()), other.size_);
+        return *this;
+    }
+
+    /**
+     * throw index_out_of_bound if pos is not in [0, size)
+     */
+    constexpr T &at(const size_t &pos) {
+        if (pos >= size_) {
+            throw index_out_of_bound();
+        }
+        return data()[pos];
+    }
+    constexpr const T &at(const size_t &pos) const {
+        if (pos >= size_) {
+            throw index_out_of_bound();
+        }
+        return data()[pos];
+    }
+    constexpr T &operator[](const size_t &pos) {
+        return at(pos);
+    }
+    constexpr const T &operator[](const size_t &pos) const {
+        return at(pos);
+    }
+    /**
+     * throw container_is_empty if size == 0
+     */
+    constexpr const T &front() const {
+        if (size_ == 0) {
+            throw container_is_empty();
+        }
+        return data()[0];
+    }
+    /**
+     * throw container_is_empty if size == 0
+     */
+    constexpr const T &back() const {
+        if (size_ == 0) {
+            throw container_is_empty();
+        }
+        return data()[size_ - 1];
+    }
+    constexpr T *data() {
+        return storage_.ptr();
+    }
+    constexpr const T *data() const {
+        return storage_.ptr();
+    }
+    constexpr iterator begin() {
+        return data();
+    }
+    constexpr const_iterator begin() const {
+        return data();
+    }
+    constexpr const_iterator cbegin() const {
+        return data();
+    }
+    constexpr iterator end() {
+        return data() + size_;
+    }
+    constexpr const_iterator end() const {
+        return data() + size_;
+    }
+    constexpr const_iterator cend() const {
+        return data() + size_;
+    }
+    constexpr bool empty() const {
+        return size_ == 0;
+    }
+    constexpr size_t size() const {
+        return size_;
+    }
+    static constexpr size_t capacity() {
+        return N;
+    }
+    constexpr void clear() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_t i = 0; i < size_; ++i) {
+                data()[i].~T();
+            }
+        }
+        size_ = 0;
+    }
+
+    /**
+     * inserts value before pos, returns an iterator pointing to it.
+     * (a template so that insert(0, x) picks the index overload)
+     * throw std::bad_alloc if the vector is full
+     */
+    template <typename Iter>
+        requires std::is_same_v<Iter, iterator> || std::is_same_v<Iter, const_iterator>
+    constexpr iterator insert(Iter pos, const T &value) {
+        return insert(static_cast<size_t>(pos - data()), value);
+    }
+    /**
+     * inserts value at index ind, returns an iterator pointing to it.
+     * throw index_out_of_bound if ind > size
+     * throw std::bad_alloc if the vector is full
+     */
+    constexpr iterator insert(const size_t &ind, const T &value) {
+        if (ind > size_) {
+            throw index_out_of_bound();
+        }
+        if (size_ == N) {
+            throw std::bad_alloc();
+        }
+        T tmp(value);
+        T *p = data();
+        if (ind == size_) {
+            construct(p + size_, std::move(tmp));
+        } else {
+            construct(p + size_, std::move(p[size_ - 1]));
+            for (size_t i = size_ - 1; i > ind; --i) {
+                p[i] = std::move(p[i - 1]);
+            }
+            p[ind] = std::move(tmp);
+        }
+        ++size_;
+        return p + ind;
+    }
+    /**
+     * removes the element at pos, returns an iterator pointing to the
+     * following element.
+     */
+    template <typename Iter>
+        requires std::is_same_v<Iter, iterator> || std::is_same_v<Iter, const_iterator>
+    constexpr iterator erase(Iter pos) {
+        return erase(static_cast<size_t>(pos - data()));
+    }
+    /**
+     * throw index_out_of_bound if ind >= size
+     */
+    constexpr iterator erase(const size_t &ind) {
+        if (ind >= size_) {
+            throw index_out_of_bound();
+        }
+        T *p = data();
+        for (size_t i = ind; i + 1 < size_; ++i) {
+            p[i] = std::move(p[i + 1]);
+        }
+        --size_;
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            p[size_].~T();
+        }
+        return p + ind;
+    }
+    /**
+     * throw std::bad_alloc if the vector is full
+     */
+    constexpr void push_back(const T &value) {
+        emplace_back(value);
+    }
+    constexpr void push_back(T &&value) {
+        emplace_back(std::move(value));
+    }
+    template <typename... Args>
+    constexpr T &emplace_back(Args &&...args) {
+        if (size_ == N) {
+            throw std::bad_alloc();
+        }
+        construct(data() + size_, std::forward<Args>(args)...);
+        return data()[size_++];
+    }
+    /**
+     * appends every element of rg.
+     * throw std::bad_alloc if they do not fit, when the length of rg is known
+     * in advance nothing is appended in that case.
+     */
+    template <detail::container_compatible_range<T> R>
+    constexpr void append_range(R &&rg) {
+        if constexpr (std::ranges::sized_range<R> || std::ranges::forward_range<R>) {
+            if (detail::range_size_hint(rg) > N - size_) {
+                throw std::bad_alloc();
+            }
+        }
+        for (auto &&x : rg) {
+            emplace_back(std::forward<decltype(x)>(x));
+        }
+    }
+    /**
+     * appends value if there is room.
+     * returns a pointer to the new element, or nullptr if the vector is full.
+     */
+    constexpr T *try_push_back(const T &value) {
+        return try_emplace_back(value);
+    }
+    constexpr T *try_push_back(T &&value) {
+        return try_emplace_back(std::move(value));
+    }
+    template <typename... Args>
+    constexpr T *try_emplace_back(Args &&...args) {
+        if (size_ == N) {
+            return nullptr;
+        }
+        construct(data() + size_, std::forward<Args>(args)...);
+        return data() + size_++;
+    }
+    /**
+     * throw container_is_empty if size() == 0
+     */
+    constexpr void pop_back() {
+        if (size_ == 0) {
+            throw container_is_empty();
+        }
+        --size_;
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            data()[size_].~T();
+        }
+    }
+
+private:
+    detail::inplace_storage<T, N> storage_;
+    size_t size_ = 0;
+
+    /**
+     * constructs n elements from src into an empty vector, on exception the
+     * ones already built are destroyed again.
+     */
+    template <typename Iter>
+    void append_from(Iter src, size_t n) {
+        try {
+            for (; size_ < n; ++size_, ++src) {
+                new (data() + size_) T(*src);
+            }
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
+    template <typename... Args>
+    static constexpr void construct(T *p, Args &&...args) {
+        if constexpr (std::is_trivial_v<T>) {
+            *p = T(std::forward<Args>(args)...);
+        } else {
+            new (p) T(std::forward<Args>(args)...);
+        }
+    }
+};
+
+}  // namespace sjtu
+
+#endif
@@ -0,0 +1,309 @@
+#ifndef SJTU_INTRUSIVE_LIST_HPP
+#define SJTU_INTRUSIVE_LIST_HPP
+
+#include "exceptions.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace sjtu {
+
+/**
+ * the links an element of an intrusive_list carries itself. an element
+ * derives from one hook per list it can be in at the same time, told
+ * apart by Tag:
+ *   struct entry : sjtu::intrusive_list_hook<lru_tag>,
+ *                  sjtu::intrusive_list_hook<free_tag> { ... };
+ * copying an element does not copy its links, the copy is in no list.
+ * an element must be taken out of its lists before it is destroyed.
+ */
+template <typename Tag = void>
+class intrusive_list_hook {
+public:
+    intrusive_list_hook() : prev_(nullptr), next_(nullptr) { }
+    intrusive_list_hook(const intrusive_list_hook &) : prev_(nullptr), next_(nullptr) { }
+    intrusive_list_hook &operator=(const intrusive_list_hook &) {
+        return *this;
+    }
+    /**
+     * checks whether the element is in a list through this hook.
+     */
+    bool is_linked() const {
+        return next_ != nullptr;
+    }
+
+private:
+    intrusive_list_hook *prev_;
+    intrusive_list_hook *next_;
+    template <typename, typename>
+    friend class intrusive_list;
+};
+
+/**
+ * a doubly linked list of elements it does not own, linked through their
+ * intrusive_list_hook<Tag> base. linking and unlinking never allocate and
+ * an element is erased or moved to the front given only a reference to
+ * it, which is what an LRU order or a free list of preallocated objects
+ * needs:
+ *   lru.move_to_front(entry);         // on a hit
+ *   entry &victim = lru.pop_back();   // on eviction
+ * an element is in at most one list per hook; linking a linked element
+ * throws invalid_iterator. the list unlinks its elements when it is
+ * cleared or destroyed, the elements themselves are left alone.
+ */
+template <typename T, typename Tag = void>
+class intrusive_list {
+    using hook = intrusive_list_hook<Tag>;
+    static_assert(std::is_base_of_v<hook, T>, "T must derive from intrusive_list_hook<Tag>");
+
+public:
+    using value_type = T;
+
+    template <bool Const>
+    class basic_iterator {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using pointer = std::conditional_t<Const, const T *, T *>;
+        using reference = std::conditional_t<Const, const T &, T &>;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+    private:
+        hook *hook_;
+        friend class intrusive_list;
+        friend class basic_iterator<!Const>;
+
+        explicit basic_iterator(hook *h) : hook_(h) { }
+    public:
+        basic_iterator() : hook_(nullptr) { }
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        basic_iterator(const basic_iterator<false> &it) : hook_(it.hook_) { }
+
+        basic_iterator &operator++() {
+            hook_ = hook_->next_;
+            return *this;
+        }
+        basic_iterator operator++(int) {
+            basic_iterator p = *this;
+            hook_ = hook_->next_;
+            return p;
+        }
+        basic_iterator &operator--() {
+            hook_ = hook_->prev_;
+            return *this;
+        }
+        basic_iterator operator--(int) {
+            basic_iterator p = *this;
+            hook_ = hook_->prev_;
+            return p;
+        }
+        reference operator*() const {
+            return static_cast<reference>(*hook_);
+        }
+        pointer operator->() const {
+            return &static_cast<reference>(*hook_);
+        }
+        bool operator==(const basic_iterator &rhs) const {
+            return hook_ == rhs.hook_;
+        }
+        bool operator!=(const basic_iterator &rhs) const {
+            return hook_ != rhs.hook_;
+        }
+    };
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    intrusive_list() {
+        reset();
+    }
+    intrusive_list(const intrusive_list &) = delete;
+    intrusive_list &operator=(const intrusive_list &) = delete;
+    intrusive_list(intrusive_list &&other) noexcept {
+        reset();
+        splice(end(), other);
+    }
+    intrusive_list &operator=(intrusive_list &&other) noexcept {
+        if (this != &other) {
+            clear();
+            splice(end(), other);
+        }
+        return *this;
+    }
+    ~intrusive_list() {
+        clear();
+    }
+
+    iterator begin() {
+        return iterator(head_.next_);
+    }
+    const_iterator begin() const {
+        return const_iterator(head_.next_);
+    }
+    iterator end() {
+        return iterator(&head_);
+    }
+    const_iterator end() const {
+        return const_iterator(const_cast<hook *>(&head_));
+    }
+    /**
+     * the iterator to value, which must be in this list.
+     */
+    iterator iterator_to(T &value) {
+        return iterator(static_cast<hook *>(&value));
+    }
+    size_t size() const {
+        return size_;
+    }
+    bool empty() const {
+        return size_ == 0;
+    }
+
+    /**
+     * throw container_is_empty if size() == 0
+     */
+    T &front() {
+        check_not_empty();
+        return static_cast<T &>(*head_.next_);
+    }
+    T &back() {
+        check_not_empty();
+        return static_cast<T &>(*head_.prev_);
+    }
+
+    /**
+     * links value before pos.
+     * throw invalid_iterator if value is already linked
+     */
+    iterator insert(const_iterator pos, T &value) {
+        hook *h = static_cast<hook *>(&value);
+        if (h->is_linked()) {
+            throw invalid_iterator();
+        }
+        link_before(pos.hook_, h);
+        return iterator(h);
+    }
+    void push_front(T &value) {
+        insert(begin(), value);
+    }
+    void push_back(T &value) {
+        insert(end(), value);
+    }
+    /**
+     * unlinks the element at pos and returns an iterator to the next one.
+     * throw invalid_iterator if pos is end()
+     */
+    iterator erase(const_iterator pos) {
+        if (pos.hook_ == &head_) {
+            throw invalid_iterator();
+        }
+        hook *next = pos.hook_->next_;
+        unlink(pos.hook_);
+        return iterator(next);
+    }
+    /**
+     * unlinks value, which must be in this list.
+     * throw invalid_iterator if value is not linked
+     */
+    void erase(T &value) {
+        hook *h = static_cast<hook *>(&value);
+        if (!h->is_linked()) {
+            throw invalid_iterator();
+        }
+        unlink(h);
+    }
+    /**
+     * unlinks the first or last element and returns it.
+     * throw container_is_empty if size() == 0
+     */
+    T &pop_front() {
+        T &value = front();
+        unlink(head_.next_);
+        return value;
+    }
+    T &pop_back() {
+        T &value = back();
+        unlink(head_.prev_);
+        return value;
+    }
+    /**
+     * moves value, which must be in this list, to the front or the back.
+     */
+    void move_to_front(T &value) {
+        relink_before(head_.next_, static_cast<hook *>(&value));
+    }
+    void move_to_back(T &value) {
+        relink_before(&head_, static_cast<hook *>(&value));
+    }
+    /**
+     * moves all elements of other before pos.
+     */
+    void splice(const_iterator pos, intrusive_list &other) {
+        if (&other == this || other.empty()) {
+            return;
+        }
+        hook *first = other.head_.next_;
+        hook *last = other.head_.prev_;
+        hook *p = pos.hook_;
+        first->prev_ = p->prev_;
+        last->next_ = p;
+        p->prev_->next_ = first;
+        p->prev_ = last;
+        size_ += other.size_;
+        other.reset();
+    }
+    /**
+     * unlinks every element.
+     */
+    void clear() {
+        hook *h = head_.next_;
+        while (h != &head_) {
+            hook *next = h->next_;
+            h->prev_ = h->next_ = nullptr;
+            h = next;
+        }
+        reset();
+    }
+
+private:
+    hook head_;
+    size_t size_;
+
+    void check_not_empty() const {
+        if (size_ == 0) {
+            throw container_is_empty();
+        }
+    }
+    void reset() {
+        head_.prev_ = head_.next_ = &head_;
+        size_ = 0;
+    }
+    void link_before(hook *pos, hook *h) {
+        h->prev_ = pos->prev_;
+        h->next_ = pos;
+        pos->prev_->next_ = h;
+        pos->prev_ = h;
+        ++size_;
+    }
+    void unlink(hook *h) {
+        h->prev_->next_ = h->next_;
+        h->next_->prev_ = h->prev_;
+        h->prev_ = h->next_ = nullptr;
+        --size_;
+    }
+    void relink_before(hook *pos, hook *h) {
+        if (pos == h) {
+            return;
+        }
+        h->prev_->next_ = h->next_;
+        h->next_->prev_ = h->prev_;
+        h->prev_ = pos->prev_;
+        h->next_ = pos;
+        pos->prev_->next_ = h;
+        pos->prev_ = h;
+    }
+};
+
+}  // namespace sjtu
+
+#endif
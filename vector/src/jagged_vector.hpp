@@ -0,0 +1,575 @@
+#ifndef SJTU_JAGGED_VECTOR_HPP
+#define SJTU_JAGGED_VECTOR_HPP
+
+#include "exceptions.hpp"
+#include "ranges.hpp"
+#include "span.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu {
+
+/**
+ * a sequence of variable-length rows stored in compressed sparse row form:
+ * every value lives in one successive buffer and row i is the range
+ * [offsets[i], offsets[i + 1]) of it.
+ * compared with a vector of vectors there is one allocation instead of one
+ * per row, a row access is an offset lookup instead of a pointer chase, and
+ * walking the rows in order walks the values buffer in order.
+ */
+template <typename T>
+class jagged_vector {
+public:
+    using value_type = T;
+    using row_type = span<T>;
+    using const_row_type = span<const T>;
+
+    class const_iterator;
+    class iterator {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = span<T>;
+        using reference = span<T>;
+        using iterator_category = std::random_access_iterator_tag;
+
+    private:
+        jagged_vector *owner_;
+        size_t idx_;
+        friend class const_iterator;
+    public:
+        iterator() : owner_(nullptr), idx_(0) { }
+        iterator(jagged_vector *owner, size_t idx) : owner_(owner), idx_(idx) { }
+        iterator operator+(const difference_type &n) const {
+            return iterator(owner_, idx_ + n);
+        }
+        iterator operator-(const difference_type &n) const {
+            return iterator(owner_, idx_ - n);
+        }
+        // if these two iterators point to different containers, throw invaild_iterator.
+        difference_type operator-(const iterator &rhs) const {
+            if (owner_ != rhs.owner_) {
+                throw invalid_iterator();
+            }
+            return idx_ - rhs.idx_;
+        }
+        iterator &operator+=(const difference_type &n) {
+            idx_ += n;
+            return *this;
+        }
+        iterator &operator-=(const difference_type &n) {
+            idx_ -= n;
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator p = *this;
+            ++idx_;
+            return p;
+        }
+        iterator &operator++() {
+            ++idx_;
+            return *this;
+        }
+        iterator operator--(int) {
+            iterator p = *this;
+            --idx_;
+            return p;
+        }
+        iterator &operator--() {
+            --idx_;
+            return *this;
+        }
+        reference operator*() const {
+            return owner_->unchecked_row(idx_);
+        }
+        bool operator==(const iterator &rhs) const {
+            return owner_ == rhs.owner_ && idx_ == rhs.idx_;
+        }
+        bool operator!=(const iterator &rhs) const {
+            return !(*this == rhs);
+        }
+        bool operator<(const iterator &rhs) const {
+            return idx_ < rhs.idx_;
+        }
+        bool operator>(const iterator &rhs) const {
+            return rhs < *this;
+        }
+        bool operator<=(const iterator &rhs) const {
+            return !(rhs < *this);
+        }
+        bool operator>=(const iterator &rhs) const {
+            return !(*this < rhs);
+        }
+        reference operator[](const difference_type &n) const {
+            return *(*this + n);
+        }
+        friend iterator operator+(const difference_type &n, const iterator &it) {
+            return it + n;
+        }
+    };
+    class const_iterator {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = span<const T>;
+        using reference = span<const T>;
+        using iterator_category = std::random_access_iterator_tag;
+
+    private:
+        const jagged_vector *owner_;
+        size_t idx_;
+    public:
+        const_iterator() : owner_(nullptr), idx_(0) { }
+        const_iterator(const jagged_vector *owner, size_t idx) : owner_(owner), idx_(idx) { }
+        const_iterator(const iterator &it) : owner_(it.owner_), idx_(it.idx_) { }
+        const_iterator operator+(const difference_type &n) const {
+            return const_iterator(owner_, idx_ + n);
+        }
+        const_iterator operator-(const difference_type &n) const {
+            return const_iterator(owner_, idx_ - n);
+        }
+        difference_type operator-(const const_iterator &rhs) const {
+            if (owner_ != rhs.owner_) {
+                throw invalid_iterator();
+            }
+            return idx_ - rhs.idx_;
+        }
+        const_iterator &operator+=(const difference_type &n) {
+            idx_ += n;
+            return *this;
+        }
+        const_iterator &operator-=(const difference_type &n) {
+            idx_ -= n;
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator p = *this;
+            ++idx_;
+            return p;
+        }
+        const_iterator &operator++() {
+            ++idx_;
+            return *this;
+        }
+        const_iterator operator--(int) {
+            const_iterator p = *this;
+            --idx_;
+            return p;
+        }
+        const_iterator &operator--() {
+            --idx_;
+            return *this;
+        }
+        reference operator*() const {
+            return owner_->unchecked_row(idx_);
+        }
+        bool operator==(const const_iterator &rhs) const {
+            return owner_ == rhs.owner_ && idx_ == rhs.idx_;
+        }
+        bool operator!=(const const_iterator &rhs) const {
+            return !(*this == rhs);
+        }
+        bool operator<(const const_iterator &rhs) const {
+            return idx_ < rhs.idx_;
+        }
+        bool operator>(const const_iterator &rhs) const {
+            return rhs < *this;
+        }
+        bool operator<=(const const_iterator &rhs) const {
+            return !(rhs < *this);
+        }
+        bool operator>=(const const_iterator &rhs) const {
+            return !(*this < rhs);
+        }
+        reference operator[](const difference_type &n) const {
+            return *(*this + n);
+        }
+        friend const_iterator operator+(const difference_type &n, const const_iterator &it) {
+            return it + n;
+        }
+    };
+
+    /**
+     * builds a jagged_vector value by value: push_back appends to the row
+     * being built and finish_row closes it.
+     *   jagged_vector<int>::builder b;
+     *   b.push_back(1); b.push_back(2); b.finish_row();
+     *   b.finish_row();  // an empty row
+     *   jagged_vector<int> j = b.build();
+     */
+    class builder {
+    public:
+        builder() { }
+        void reserve(const size_t &rows, const size_t &values) {
+            result_.reserve(rows, values);
+        }
+        /**
+         * appends value to the open row.
+         */
+        void push_back(const T &value) {
+            result_.grow_values(result_.values_size_ + 1);
+            new (result_.values_ + result_.values_size_) T(value);
+            ++result_.values_size_;
+        }
+        /**
+         * closes the open row, the values pushed since the last call
+         * become one row (possibly empty).
+         */
+        void finish_row() {
+            result_.grow_rows(result_.rows_ + 1);
+            result_.offsets_[++result_.rows_] = result_.values_size_;
+        }
+        /**
+         * the number of values pushed to the open row so far.
+         */
+        size_t open_row_size() const {
+            return result_.values_size_ - result_.offsets_[result_.rows_];
+        }
+        /**
+         * returns the rows built so far and resets the builder; values of
+         * a row that was not finished form one last row.
+         */
+        jagged_vector build() {
+            if (open_row_size() != 0) {
+                finish_row();
+            }
+            jagged_vector out(std::move(result_));
+            return out;
+        }
+
+    private:
+        jagged_vector result_;
+    };
+
+    jagged_vector() : offsets_(allocate<size_t>(1)) {
+        offsets_[0] = 0;
+    }
+    jagged_vector(const jagged_vector &other)
+        : values_(allocate<T>(other.values_size_)), values_capacity_(other.values_size_),
+          offsets_(allocate<size_t>(other.rows_ + 1)), rows_capacity_(other.rows_) {
+        try {
+            copy_values(values_, other.values_, other.values_size_);
+        } catch (...) {
+            free(values_);
+            free(offsets_);
+            throw;
+        }
+        memcpy(offsets_, other.offsets_, (other.rows_ + 1) * sizeof(size_t));
+        values_size_ = other.values_size_;
+        rows_ = other.rows_;
+    }
+    jagged_vector(jagged_vector &&other) : jagged_vector() {
+        swap(other);
+    }
+    ~jagged_vector() {
+        destroy_values(0);
+        free(values_);
+        free(offsets_);
+    }
+    jagged_vector &operator=(const jagged_vector &other) {
+        if (this == &other) {
+            return *this;
+        }
+        jagged_vector tmp(other);
+        swap(tmp);
+        return *this;
+    }
+    jagged_vector &operator=(jagged_vector &&other) {
+        swap(other);
+        return *this;
+    }
+    void swap(jagged_vector &other) noexcept {
+        std::swap(values_, other.values_);
+        std::swap(values_size_, other.values_size_);
+        std::swap(values_capacity_, other.values_capacity_);
+        std::swap(offsets_, other.offsets_);
+        std::swap(rows_, other.rows_);
+        std::swap(rows_capacity_, other.rows_capacity_);
+    }
+
+    /**
+     * converts a nested container such as sjtu::vector<std::vector<T>>,
+     * the sizes are summed first so both buffers are allocated once.
+     */
+    template <std::ranges::forward_range Nested>
+        requires detail::container_compatible_range<std::ranges::range_reference_t<Nested>, T>
+    static jagged_vector from_nested(Nested &&rows) {
+        size_t row_count = 0, value_count = 0;
+        for (auto &&r : rows) {
+            ++row_count;
+            value_count += detail::range_size_hint(r);
+        }
+        jagged_vector out;
+        out.reserve(row_count, value_count);
+        for (auto &&r : rows) {
+            out.append_row(r);
+        }
+        return out;
+    }
+
+    /**
+     * returns a view of row pos, valid until the next reallocation.
+     * throw index_out_of_bound if pos is not in [0, size)
+     */
+    span<T> row(const size_t &pos) {
+        if (pos >= rows_) {
+            throw index_out_of_bound();
+        }
+        return unchecked_row(pos);
+    }
+    span<const T> row(const size_t &pos) const {
+        if (pos >= rows_) {
+            throw index_out_of_bound();
+        }
+        return unchecked_row(pos);
+    }
+    span<T> operator[](const size_t &pos) {
+        return row(pos);
+    }
+    span<const T> operator[](const size_t &pos) const {
+        return row(pos);
+    }
+    /**
+     * throw index_out_of_bound if pos is not in [0, size)
+     */
+    size_t row_size(const size_t &pos) const {
+        if (pos >= rows_) {
+            throw index_out_of_bound();
+        }
+        return offsets_[pos + 1] - offsets_[pos];
+    }
+    /**
+     * every value of every row, row after row.
+     */
+    span<T> values() {
+        return span<T>(values_, offsets_[rows_]);
+    }
+    span<const T> values() const {
+        return span<const T>(values_, offsets_[rows_]);
+    }
+    /**
+     * size() + 1 offsets, row i is values()[offsets()[i], offsets()[i + 1]).
+     */
+    span<const size_t> offsets() const {
+        return span<const size_t>(offsets_, rows_ + 1);
+    }
+
+    iterator begin() {
+        return iterator(this, 0);
+    }
+    const_iterator begin() const {
+        return const_iterator(this, 0);
+    }
+    const_iterator cbegin() const {
+        return const_iterator(this, 0);
+    }
+    iterator end() {
+        return iterator(this, rows_);
+    }
+    const_iterator end() const {
+        return const_iterator(this, rows_);
+    }
+    const_iterator cend() const {
+        return const_iterator(this, rows_);
+    }
+    /**
+     * the number of rows.
+     */
+    size_t size() const {
+        return rows_;
+    }
+    bool empty() const {
+        return rows_ == 0;
+    }
+    /**
+     * the number of values in all rows.
+     */
+    size_t total_size() const {
+        return offsets_[rows_];
+    }
+    /**
+     * makes room for rows rows holding values values in total.
+     */
+    void reserve(const size_t &rows, const size_t &values) {
+        grow_rows(rows);
+        grow_values(values);
+    }
+    void clear() {
+        destroy_values(0);
+        values_size_ = 0;
+        rows_ = 0;
+    }
+    /**
+     * adds a row holding a copy of n values starting at first.
+     */
+    void append_row(const T *first, const size_t &n) {
+        append_values(n, [first, n](T *dst) { copy_values(dst, first, n); });
+    }
+    void append_row(span<const T> r) {
+        append_row(r.data(), r.size());
+    }
+    /**
+     * adds a row holding a copy of every element of r, r is any range that
+     * knows its size or can be walked twice.
+     */
+    template <detail::container_compatible_range<T> Range>
+        requires std::ranges::sized_range<Range> || std::ranges::forward_range<Range>
+    void append_row(Range &&r) {
+        size_t n = detail::range_size_hint(r);
+        append_values(n, [&r](T *dst) {
+            size_t built = 0;
+            try {
+                for (auto &&x : r) {
+                    new (dst + built) T(x);
+                    ++built;
+                }
+            } catch (...) {
+                for (size_t i = 0; i < built; ++i) {
+                    dst[i].~T();
+                }
+                throw;
+            }
+        });
+    }
+    /**
+     * adds an empty row.
+     */
+    void append_row() {
+        append_row(static_cast<const T *>(nullptr), 0);
+    }
+    /**
+     * removes the last row.
+     * throw container_is_empty if size() == 0
+     */
+    void pop_row() {
+        if (rows_ == 0) {
+            throw container_is_empty();
+        }
+        --rows_;
+        destroy_values(offsets_[rows_]);
+        values_size_ = offsets_[rows_];
+    }
+
+private:
+    T *values_ = nullptr;
+    size_t values_size_ = 0;
+    size_t values_capacity_ = 0;
+    // offsets_[0] == 0 and offsets_[rows_] == number of values in finished rows
+    size_t *offsets_ = nullptr;
+    size_t rows_ = 0;
+    size_t rows_capacity_ = 0;
+
+    template <typename U>
+    static U *allocate(size_t n) {
+        U *p = reinterpret_cast<U *>(malloc((n ? n : 1) * sizeof(U)));
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+    span<T> unchecked_row(size_t pos) {
+        return span<T>(values_ + offsets_[pos], offsets_[pos + 1] - offsets_[pos]);
+    }
+    span<const T> unchecked_row(size_t pos) const {
+        return span<const T>(values_ + offsets_[pos], offsets_[pos + 1] - offsets_[pos]);
+    }
+    /**
+     * copy-constructs n values into raw memory at dst, a single memcpy for
+     * trivially copyable types.
+     */
+    static void copy_values(T *dst, const T *src, size_t n) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (n) {
+                memcpy(dst, src, n * sizeof(T));
+            }
+        } else {
+            size_t i = 0;
+            try {
+                for (; i < n; ++i) {
+                    new (dst + i) T(src[i]);
+                }
+            } catch (...) {
+                while (i--) {
+                    dst[i].~T();
+                }
+                throw;
+            }
+        }
+    }
+    void destroy_values(size_t from) {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_t i = from; i < values_size_; ++i) {
+                values_[i].~T();
+            }
+        }
+    }
+    /**
+     * adds a row of n values that fill constructs at the pointer it is
+     * given. on reallocation the row is built in the new buffer while the
+     * old one still exists, so the source may be a row of this object.
+     */
+    template <class Fill>
+    void append_values(size_t n, Fill fill) {
+        grow_rows(rows_ + 1);
+        if (values_size_ + n <= values_capacity_) {
+            fill(values_ + values_size_);
+        } else {
+            size_t cap = grown_capacity(values_size_ + n);
+            T *fresh = allocate<T>(cap);
+            try {
+                fill(fresh + values_size_);
+            } catch (...) {
+                free(fresh);
+                throw;
+            }
+            move_values_to(fresh, cap);
+        }
+        values_size_ += n;
+        offsets_[++rows_] = values_size_;
+    }
+    size_t grown_capacity(size_t need) const {
+        return values_capacity_ * 2 > need ? values_capacity_ * 2 : need;
+    }
+    void grow_values(size_t need) {
+        if (need <= values_capacity_) {
+            return;
+        }
+        size_t cap = grown_capacity(need);
+        move_values_to(allocate<T>(cap), cap);
+    }
+    // moves the values to fresh, which has room for cap of them, and frees the old buffer
+    void move_values_to(T *fresh, size_t cap) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (values_size_) {
+                memcpy(fresh, values_, values_size_ * sizeof(T));
+            }
+        } else {
+            for (size_t i = 0; i < values_size_; ++i) {
+                new (fresh + i) T(std::move(values_[i]));
+                values_[i].~T();
+            }
+        }
+        free(values_);
+        values_ = fresh;
+        values_capacity_ = cap;
+    }
+    void grow_rows(size_t need) {
+        if (need <= rows_capacity_) {
+            return;
+        }
+        size_t cap = rows_capacity_ * 2 > need ? rows_capacity_ * 2 : need;
+        size_t *fresh = allocate<size_t>(cap + 1);
+        memcpy(fresh, offsets_, (rows_ + 1) * sizeof(size_t));
+        free(offsets_);
+        offsets_ = fresh;
+        rows_capacity_ = cap;
+    }
+};
+
+}  // namespace sjtu
+
+#endif
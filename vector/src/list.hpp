@@ -0,0 +1,802 @@
+#ifndef SJTU_LIST_HPP
+#define SJTU_LIST_HPP
+
+#include "exceptions.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu {
+namespace detail {
+
+struct list_node_base {
+    list_node_base *prev;
+    list_node_base *next;
+};
+
+template <typename T>
+struct list_node : list_node_base {
+    T value;
+
+    template <typename... Args>
+    explicit list_node(Args &&...args) : value(std::forward<Args>(args)...) { }
+};
+
+}  // namespace detail
+
+/**
+ * the storage the nodes of sjtu::list<T> come from.
+ * nodes are cut from slabs of successive memory, each slab twice as large
+ * as the one before up to kMaxSlabNodes nodes, and freed nodes go to a
+ * free list that the next allocation takes from first. a list allocates
+ * with one pointer bump or pop in the common case, its nodes sit close
+ * together, and the slabs are given back at once when the pool dies.
+ * every list has a pool of its own, which no other list can use; lists
+ * made with a shared pool may splice nodes among each other freely. a
+ * shared pool must outlive the lists using it.
+ */
+template <typename T>
+class list_pool {
+public:
+    static constexpr size_t kMinSlabNodes = 16;
+    static constexpr size_t kMaxSlabNodes = 4096;
+
+    list_pool() { }
+    list_pool(const list_pool &) = delete;
+    list_pool &operator=(const list_pool &) = delete;
+    /**
+     * frees every slab, the nodes in them must not be used any more.
+     */
+    ~list_pool() {
+        release();
+    }
+
+    /**
+     * storage for one node.
+     */
+    void *allocate() {
+        if (free_ != nullptr) {
+            free_node *p = free_;
+            free_ = p->next;
+            return p;
+        }
+        if (bump_ == bump_end_) {
+            add_slab(next_slab_);
+        }
+        return bump_++;
+    }
+    /**
+     * gives the storage of a node back, p must come from this pool.
+     */
+    void deallocate(void *p) {
+        free_node *f = static_cast<free_node *>(p);
+        f->next = free_;
+        free_ = f;
+    }
+    /**
+     * makes sure the current slab has room for n more nodes.
+     */
+    void reserve(const size_t &n) {
+        if (static_cast<size_t>(bump_end_ - bump_) < n) {
+            add_slab(n > next_slab_ ? n : next_slab_);
+        }
+    }
+    /**
+     * the number of nodes in all slabs, used or not.
+     */
+    size_t capacity() const {
+        return capacity_;
+    }
+
+    /**
+     * takes over the slabs of other together with its free nodes, the
+     * nodes handed out by other now belong to this pool.
+     */
+    void adopt(list_pool &other) {
+        if (&other == this) {
+            return;
+        }
+        for (size_t i = 0; i < other.slabs_.size(); ++i) {
+            slabs_.push_back(other.slabs_[i]);
+        }
+        other.slabs_.clear();
+        while (other.bump_ != other.bump_end_) {
+            deallocate(other.bump_++);
+        }
+        while (other.free_ != nullptr) {
+            free_node *p = other.free_;
+            other.free_ = p->next;
+            deallocate(p);
+        }
+        capacity_ += other.capacity_;
+        other.capacity_ = 0;
+        other.next_slab_ = kMinSlabNodes;
+    }
+    void swap(list_pool &other) {
+        slabs_.swap(other.slabs_);
+        std::swap(free_, other.free_);
+        std::swap(bump_, other.bump_);
+        std::swap(bump_end_, other.bump_end_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(next_slab_, other.next_slab_);
+    }
+
+private:
+    using node = detail::list_node<T>;
+    static_assert(alignof(node) <= alignof(std::max_align_t), "over-aligned list nodes are not supported");
+
+    // the first bytes of a node on the free list
+    struct free_node {
+        free_node *next;
+    };
+    // raw storage of one node, what bump_ steps over
+    struct alignas(node) node_storage {
+        unsigned char bytes[sizeof(node)];
+    };
+
+    vector<void *> slabs_;
+    free_node *free_ = nullptr;
+    node_storage *bump_ = nullptr;
+    node_storage *bump_end_ = nullptr;
+    size_t capacity_ = 0;
+    size_t next_slab_ = kMinSlabNodes;
+
+    void add_slab(size_t n) {
+        slabs_.reserve(slabs_.size() + 1);
+        node_storage *p = static_cast<node_storage *>(malloc(n * sizeof(node_storage)));
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        slabs_.push_back(p);
+        // the rest of the old slab stays usable through the free list
+        while (bump_ != bump_end_) {
+            deallocate(bump_++);
+        }
+        bump_ = p;
+        bump_end_ = p + n;
+        capacity_ += n;
+        if (next_slab_ < kMaxSlabNodes) {
+            next_slab_ *= 2;
+        }
+    }
+    void release() {
+        for (size_t i = 0; i < slabs_.size(); ++i) {
+            free(slabs_[i]);
+        }
+        slabs_.clear();
+        free_ = nullptr;
+        bump_ = bump_end_ = nullptr;
+        capacity_ = 0;
+        next_slab_ = kMinSlabNodes;
+    }
+};
+
+/**
+ * a doubly linked list like std::list, with its nodes from a list_pool.
+ * insert and erase anywhere are O(1) and never move other elements, and
+ * iterators stay valid until their element is erased. splice and merge
+ * relink nodes, sort is a stable merge sort that relinks nodes without
+ * copying or moving a single element.
+ * nodes move between lists in O(1) when both lists use the same pool or
+ * a whole list with a pool of its own is spliced or merged (its slabs
+ * come along); in the remaining cases the elements are moved into new
+ * nodes one by one and iterators to them become invalid.
+ */
+template <typename T>
+class list {
+    using node_base = detail::list_node_base;
+    using node = detail::list_node<T>;
+
+public:
+    using value_type = T;
+
+    /**
+     * a bidirectional iterator, iterator converts to const_iterator.
+     */
+    template <bool Const>
+    class basic_iterator {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+        using pointer = std::conditional_t<Const, const T *, T *>;
+        using reference = std::conditional_t<Const, const T &, T &>;
+        using iterator_category = std::bidirectional_iterator_tag;
+
+    private:
+        node_base *node_;
+        friend class list;
+        friend class basic_iterator<!Const>;
+
+        explicit basic_iterator(node_base *n) : node_(n) { }
+    public:
+        basic_iterator() : node_(nullptr) { }
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        basic_iterator(const basic_iterator<false> &it) : node_(it.node_) { }
+
+        basic_iterator &operator++() {
+            node_ = node_->next;
+            return *this;
+        }
+        basic_iterator operator++(int) {
+            basic_iterator p = *this;
+            node_ = node_->next;
+            return p;
+        }
+        basic_iterator &operator--() {
+            node_ = node_->prev;
+            return *this;
+        }
+        basic_iterator operator--(int) {
+            basic_iterator p = *this;
+            node_ = node_->prev;
+            return p;
+        }
+        reference operator*() const {
+            return static_cast<node *>(node_)->value;
+        }
+        pointer operator->() const {
+            return &static_cast<node *>(node_)->value;
+        }
+        bool operator==(const basic_iterator &rhs) const {
+            return node_ == rhs.node_;
+        }
+        bool operator!=(const basic_iterator &rhs) const {
+            return node_ != rhs.node_;
+        }
+    };
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    list() : pool_(&own_pool_) {
+        reset();
+    }
+    /**
+     * a list taking its nodes from pool, which must outlive it.
+     */
+    explicit list(list_pool<T> &pool) : pool_(&pool) {
+        reset();
+    }
+    list(const list &other) : pool_(&own_pool_) {
+        reset();
+        own_pool_.reserve(other.size_);
+        for (const_iterator it = other.begin(); it != other.end(); ++it) {
+            push_back(*it);
+        }
+    }
+    /**
+     * takes the nodes of other, and its pool if other had a pool of its
+     * own. iterators to the elements stay valid.
+     */
+    list(list &&other) noexcept : pool_(&own_pool_) {
+        reset();
+        if (other.pool_ == &other.own_pool_) {
+            own_pool_.swap(other.own_pool_);
+        } else {
+            pool_ = other.pool_;
+        }
+        take_chain(other);
+    }
+    /**
+     * the nodes of a list with a pool of its own and trivially
+     * destructible elements are left for the pool to free.
+     */
+    ~list() {
+        if (!std::is_trivially_destructible_v<T> || pool_ != &own_pool_) {
+            destroy_all();
+        }
+    }
+    /**
+     * the elements are replaced, the nodes of the old ones are reused.
+     */
+    list &operator=(const list &other) {
+        if (this != &other) {
+            clear();
+            for (const_iterator it = other.begin(); it != other.end(); ++it) {
+                push_back(*it);
+            }
+        }
+        return *this;
+    }
+    list &operator=(list &&other) noexcept {
+        if (this != &other) {
+            list tmp(std::move(other));
+            swap(tmp);
+        }
+        return *this;
+    }
+    void swap(list &other) noexcept {
+        if (this == &other) {
+            return;
+        }
+        bool own = pool_ == &own_pool_;
+        bool other_own = other.pool_ == &other.own_pool_;
+        own_pool_.swap(other.own_pool_);
+        list_pool<T> *p = pool_;
+        pool_ = other_own ? &own_pool_ : other.pool_;
+        other.pool_ = own ? &other.own_pool_ : p;
+        swap_chains(other);
+    }
+
+    iterator begin() {
+        return iterator(head_.next);
+    }
+    const_iterator begin() const {
+        return const_iterator(head_.next);
+    }
+    iterator end() {
+        return iterator(&head_);
+    }
+    const_iterator end() const {
+        return const_iterator(const_cast<node_base *>(&head_));
+    }
+    size_t size() const {
+        return size_;
+    }
+    bool empty() const {
+        return size_ == 0;
+    }
+    /**
+     * the pool the nodes come from. it is const: a pool of the list's own
+     * is its alone, and another list sharing it would lose its nodes when
+     * the pool's slabs move along in a splice, a move or a swap. lists
+     * sharing nodes are made from a list_pool outliving them all.
+     */
+    const list_pool<T> &pool() const {
+        return *pool_;
+    }
+
+    /**
+     * throw container_is_empty if size() == 0
+     */
+    T &front() {
+        check_not_empty();
+        return value_of(head_.next);
+    }
+    const T &front() const {
+        check_not_empty();
+        return value_of(head_.next);
+    }
+    T &back() {
+        check_not_empty();
+        return value_of(head_.prev);
+    }
+    const T &back() const {
+        check_not_empty();
+        return value_of(head_.prev);
+    }
+
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args &&...args) {
+        node_base *n = create(std::forward<Args>(args)...);
+        link_before(pos.node_, n);
+        return iterator(n);
+    }
+    /**
+     * inserts value before pos and returns an iterator to it.
+     */
+    iterator insert(const_iterator pos, const T &value) {
+        return emplace(pos, value);
+    }
+    iterator insert(const_iterator pos, T &&value) {
+        return emplace(pos, std::move(value));
+    }
+    template <typename... Args>
+    T &emplace_front(Args &&...args) {
+        return *emplace(begin(), std::forward<Args>(args)...);
+    }
+    template <typename... Args>
+    T &emplace_back(Args &&...args) {
+        return *emplace(end(), std::forward<Args>(args)...);
+    }
+    void push_front(const T &value) {
+        emplace(begin(), value);
+    }
+    void push_front(T &&value) {
+        emplace(begin(), std::move(value));
+    }
+    void push_back(const T &value) {
+        emplace(end(), value);
+    }
+    void push_back(T &&value) {
+        emplace(end(), std::move(value));
+    }
+
+    /**
+     * removes the element at pos and returns an iterator to the next one.
+     * throw invalid_iterator if pos is end()
+     */
+    iterator erase(const_iterator pos) {
+        if (pos.node_ == &head_) {
+            throw invalid_iterator();
+        }
+        node_base *next = pos.node_->next;
+        unlink(pos.node_);
+        destroy(pos.node_);
+        return iterator(next);
+    }
+    iterator erase(const_iterator first, const_iterator last) {
+        while (first != last) {
+            first = erase(first);
+        }
+        return iterator(last.node_);
+    }
+    /**
+     * throw container_is_empty if size() == 0
+     */
+    void pop_front() {
+        check_not_empty();
+        erase(begin());
+    }
+    void pop_back() {
+        check_not_empty();
+        erase(const_iterator(head_.prev));
+    }
+    /**
+     * removes every element, their nodes go back to the pool.
+     */
+    void clear() {
+        destroy_all();
+        reset();
+    }
+
+    /**
+     * moves all elements of other before pos.
+     */
+    void splice(const_iterator pos, list &other) {
+        if (&other == this || other.empty()) {
+            return;
+        }
+        if (!make_relinkable(other)) {
+            list tmp(*pool_);
+            tmp.move_elements_from(other);
+            splice(pos, tmp);
+            return;
+        }
+        node_base *first = other.head_.next;
+        node_base *last = other.head_.prev;
+        size_t n = other.size_;
+        other.reset();
+        link_range_before(pos.node_, first, last, n);
+    }
+    void splice(const_iterator pos, list &&other) {
+        splice(pos, other);
+    }
+    /**
+     * moves the element at it, an element of other, before pos.
+     */
+    void splice(const_iterator pos, list &other, const_iterator it) {
+        const_iterator next = it;
+        splice(pos, other, it, ++next);
+    }
+    /**
+     * moves the elements [first, last) of other before pos. O(1) within
+     * one list, O(last - first) between lists for counting the elements.
+     */
+    void splice(const_iterator pos, list &other, const_iterator first, const_iterator last) {
+        if (first == last || pos == last) {
+            return;
+        }
+        if (pool_ != other.pool_) {
+            for (const_iterator it = first; it != last; ++it) {
+                emplace(pos, std::move(value_of(it.node_)));
+            }
+            other.erase(first, last);
+            return;
+        }
+        size_t n = 0;
+        if (&other != this) {
+            for (const_iterator it = first; it != last; ++it) {
+                ++n;
+            }
+        }
+        node_base *f = first.node_;
+        node_base *l = last.node_->prev;
+        f->prev->next = last.node_;
+        last.node_->prev = f->prev;
+        other.size_ -= n;
+        link_range_before(pos.node_, f, l, n);
+    }
+
+    /**
+     * sorts the elements stably by relinking the nodes, O(n log n)
+     * comparisons. if comp throws, the list keeps all its elements in an
+     * unspecified order.
+     */
+    template <typename Compare>
+    void sort(Compare comp) {
+        if (size_ < 2) {
+            return;
+        }
+        // runs of 2^i nodes, null-terminated through next; a higher bin
+        // holds earlier elements
+        node_base *bins[64] = {};
+        node_base *rest = head_.next;
+        head_.prev->next = nullptr;
+        node_base *carry = nullptr;
+        try {
+            while (rest != nullptr) {
+                carry = rest;
+                rest = rest->next;
+                carry->next = nullptr;
+                size_t i = 0;
+                for (; bins[i] != nullptr; ++i) {
+                    node_base *c = carry;
+                    carry = nullptr;
+                    merge_chains(bins[i], c, comp);
+                    carry = bins[i];
+                    bins[i] = nullptr;
+                }
+                bins[i] = carry;
+                carry = nullptr;
+            }
+            for (size_t i = 1; i < 64; ++i) {
+                if (bins[i - 1] != nullptr) {
+                    node_base *c = bins[i - 1];
+                    bins[i - 1] = nullptr;
+                    if (bins[i] == nullptr) {
+                        bins[i] = c;
+                    } else {
+                        merge_chains(bins[i], c, comp);
+                    }
+                }
+            }
+        } catch (...) {
+            node_base *all = nullptr;
+            all = append_chain(all, rest);
+            all = append_chain(all, carry);
+            for (size_t i = 0; i < 64; ++i) {
+                all = append_chain(all, bins[i]);
+            }
+            relink_chain(all);
+            throw;
+        }
+        relink_chain(bins[63]);
+    }
+    void sort() {
+        sort([](const T &a, const T &b) { return a < b; });
+    }
+    /**
+     * merges the sorted other into this sorted list, stable with the
+     * elements of this list first among equal ones. other ends up empty.
+     */
+    template <typename Compare>
+    void merge(list &other, Compare comp) {
+        if (&other == this || other.empty()) {
+            return;
+        }
+        if (!make_relinkable(other)) {
+            list tmp(*pool_);
+            tmp.move_elements_from(other);
+            merge(tmp, comp);
+            return;
+        }
+        node_base *a = nullptr;
+        if (!empty()) {
+            a = head_.next;
+            head_.prev->next = nullptr;
+        }
+        node_base *b = other.head_.next;
+        other.head_.prev->next = nullptr;
+        size_t n = size_ + other.size_;
+        other.reset();
+        try {
+            merge_chains(a, b, comp);
+        } catch (...) {
+            relink_chain(a);
+            size_ = n;
+            throw;
+        }
+        relink_chain(a);
+        size_ = n;
+    }
+    void merge(list &other) {
+        merge(other, [](const T &a, const T &b) { return a < b; });
+    }
+    void reverse() {
+        node_base *n = &head_;
+        do {
+            std::swap(n->prev, n->next);
+            n = n->prev;
+        } while (n != &head_);
+    }
+    /**
+     * erases the elements pred holds for and returns their number.
+     */
+    template <typename Predicate>
+    size_t remove_if(Predicate pred) {
+        size_t removed = 0;
+        for (const_iterator it = begin(); it != end();) {
+            if (pred(*it)) {
+                it = erase(it);
+                ++removed;
+            } else {
+                ++it;
+            }
+        }
+        return removed;
+    }
+
+private:
+    list_pool<T> own_pool_;
+    list_pool<T> *pool_;
+    node_base head_;
+    size_t size_;
+
+    static T &value_of(node_base *n) {
+        return static_cast<node *>(n)->value;
+    }
+    static const T &value_of(const node_base *n) {
+        return static_cast<const node *>(n)->value;
+    }
+    void check_not_empty() const {
+        if (size_ == 0) {
+            throw container_is_empty();
+        }
+    }
+    void reset() {
+        head_.prev = head_.next = &head_;
+        size_ = 0;
+    }
+
+    template <typename... Args>
+    node_base *create(Args &&...args) {
+        void *p = pool_->allocate();
+        try {
+            return ::new (p) node(std::forward<Args>(args)...);
+        } catch (...) {
+            pool_->deallocate(p);
+            throw;
+        }
+    }
+    void destroy(node_base *n) {
+        static_cast<node *>(n)->~node();
+        pool_->deallocate(n);
+    }
+    /**
+     * destroys every element without touching the links or the size.
+     */
+    void destroy_all() {
+        node_base *n = head_.next;
+        while (n != &head_) {
+            node_base *next = n->next;
+            destroy(n);
+            n = next;
+        }
+    }
+    void link_before(node_base *pos, node_base *n) {
+        n->prev = pos->prev;
+        n->next = pos;
+        pos->prev->next = n;
+        pos->prev = n;
+        ++size_;
+    }
+    void unlink(node_base *n) {
+        n->prev->next = n->next;
+        n->next->prev = n->prev;
+        --size_;
+    }
+    /**
+     * links the chain first ... last of n nodes before pos.
+     */
+    void link_range_before(node_base *pos, node_base *first, node_base *last, size_t n) {
+        first->prev = pos->prev;
+        last->next = pos;
+        pos->prev->next = first;
+        pos->prev = last;
+        size_ += n;
+    }
+    /**
+     * moves the nodes of other, whose head is left dangling, to this empty
+     * list.
+     */
+    void take_chain(list &other) {
+        if (other.size_ != 0) {
+            head_.next = other.head_.next;
+            head_.prev = other.head_.prev;
+            head_.next->prev = &head_;
+            head_.prev->next = &head_;
+            size_ = other.size_;
+        }
+        other.reset();
+    }
+    void swap_chains(list &other) {
+        node_base *first = head_.next, *last = head_.prev;
+        size_t n = size_;
+        bool mine = n != 0;
+        take_chain(other);
+        if (mine) {
+            other.head_.next = first;
+            other.head_.prev = last;
+            first->prev = &other.head_;
+            last->next = &other.head_;
+            other.size_ = n;
+        }
+    }
+    /**
+     * makes the nodes of other ones this list can link, by taking over the
+     * pool other has of its own. false if other shares a different pool.
+     */
+    bool make_relinkable(list &other) {
+        if (pool_ == other.pool_) {
+            return true;
+        }
+        if (other.pool_ != &other.own_pool_) {
+            return false;
+        }
+        // every caller takes all nodes of other right away, other goes on
+        // with its emptied pool
+        pool_->adopt(other.own_pool_);
+        return true;
+    }
+    void move_elements_from(list &other) {
+        for (iterator it = other.begin(); it != other.end(); ++it) {
+            push_back(std::move(*it));
+        }
+        other.clear();
+    }
+
+    /**
+     * merges the null-terminated sorted chain b into the null-terminated
+     * sorted chain a, stable with a first. if comp throws, a holds all
+     * nodes of both chains.
+     */
+    template <typename Compare>
+    static void merge_chains(node_base *&a, node_base *b, Compare &comp) {
+        node_base head;
+        node_base *tail = &head;
+        node_base *x = a;
+        try {
+            while (x != nullptr && b != nullptr) {
+                if (comp(value_of(b), value_of(x))) {
+                    tail->next = b;
+                    tail = b;
+                    b = b->next;
+                } else {
+                    tail->next = x;
+                    tail = x;
+                    x = x->next;
+                }
+            }
+        } catch (...) {
+            tail->next = x;
+            a = append_chain(head.next, b);
+            throw;
+        }
+        tail->next = x != nullptr ? x : b;
+        a = head.next;
+    }
+    static node_base *append_chain(node_base *a, node_base *b) {
+        if (a == nullptr) {
+            return b;
+        }
+        node_base *t = a;
+        while (t->next != nullptr) {
+            t = t->next;
+        }
+        t->next = b;
+        return a;
+    }
+    /**
+     * makes the null-terminated chain the contents of the list, restoring
+     * the prev links.
+     */
+    void relink_chain(node_base *chain) {
+        node_base *prev = &head_;
+        for (node_base *n = chain; n != nullptr; n = n->next) {
+            n->prev = prev;
+            prev->next = n;
+            prev = n;
+        }
+        prev->next = &head_;
+        head_.prev = prev;
+    }
+};
+
+}  // namespace sjtu
+
+#endif
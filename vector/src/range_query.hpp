@@ -0,0 +1,603 @@
+#ifndef SJTU_RANGE_QUERY_HPP
+#define SJTU_RANGE_QUERY_HPP
+
+#include "exceptions.hpp"
+#include "vector.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <utility>
+
+namespace sjtu {
+
+/**
+ * the half-open range of positions [begin, end), what the batch queries
+ * below take.
+ */
+struct index_range {
+    size_t begin;
+    size_t end;
+};
+
+namespace detail {
+
+/**
+ * throw index_out_of_bound if [l, r) is not a range inside [0, n)
+ */
+inline void check_range(size_t l, size_t r, size_t n) {
+    if (l > r || r > n) {
+        throw index_out_of_bound();
+    }
+}
+
+}  // namespace detail
+
+/**
+ * a Fenwick (binary indexed) tree over n values of T: adding to one value
+ * and summing a prefix are O(log n), in n values of extra space and
+ * nothing else. T needs +, - and a value-initialized zero.
+ * element i of the tree holds the sum of the values (i & (i + 1)) .. i.
+ */
+template <typename T>
+class fenwick_tree {
+public:
+    fenwick_tree() { }
+    /**
+     * n zeros.
+     */
+    explicit fenwick_tree(const size_t &n) {
+        tree_.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            tree_.push_back(T());
+        }
+    }
+    /**
+     * the tree of values, built in O(n).
+     */
+    explicit fenwick_tree(const vector<T> &values) {
+        assign(values);
+    }
+    void assign(const vector<T> &values) {
+        tree_ = values;
+        build(tree_.data(), tree_.size());
+    }
+
+    size_t size() const {
+        return tree_.size();
+    }
+    /**
+     * adds delta to value pos.
+     * throw index_out_of_bound if pos is not in [0, size)
+     */
+    void add(const size_t &pos, const T &delta) {
+        size_t n = tree_.size();
+        if (pos >= n) {
+            throw index_out_of_bound();
+        }
+        T *t = tree_.data();
+        for (size_t i = pos; i < n; i |= i + 1) {
+            t[i] += delta;
+        }
+    }
+    /**
+     * adds deltas[i] to every value i at once, O(n): the tree of a sum is
+     * the sum of the trees.
+     * throw index_out_of_bound if deltas.size() != size()
+     */
+    void add(const vector<T> &deltas) {
+        if (deltas.size() != tree_.size()) {
+            throw index_out_of_bound();
+        }
+        vector<T> d = deltas;
+        build(d.data(), d.size());
+        T *t = tree_.data();
+        for (size_t i = 0; i < d.size(); i++) {
+            t[i] += d.data()[i];
+        }
+    }
+    /**
+     * replaces value pos.
+     */
+    void set(const size_t &pos, const T &value) {
+        add(pos, value - get(pos));
+    }
+    T get(const size_t &pos) const {
+        return sum(pos, pos + 1);
+    }
+    /**
+     * the sum of the values [0, n).
+     * throw index_out_of_bound if n > size()
+     */
+    T prefix_sum(const size_t &n) const {
+        if (n > tree_.size()) {
+            throw index_out_of_bound();
+        }
+        return unchecked_prefix(n);
+    }
+    /**
+     * the sum of the values [l, r).
+     * throw index_out_of_bound if [l, r) is not inside [0, size)
+     */
+    T sum(const size_t &l, const size_t &r) const {
+        detail::check_range(l, r, tree_.size());
+        return unchecked_prefix(r) - unchecked_prefix(l);
+    }
+    /**
+     * the sums of many ranges.
+     */
+    vector<T> sum(const vector<index_range> &ranges) const {
+        vector<T> result;
+        result.reserve(ranges.size());
+        for (size_t i = 0; i < ranges.size(); i++) {
+            result.push_back(sum(ranges.data()[i].begin, ranges.data()[i].end));
+        }
+        return result;
+    }
+    /**
+     * the smallest n with prefix_sum(n) >= target, size() + 1 if there is
+     * none, in O(log n). only meaningful when no value is negative.
+     */
+    size_t lower_bound(T target) const {
+        if (!(T() < target)) {
+            return 0;
+        }
+        size_t n = tree_.size();
+        const T *t = tree_.data();
+        // pos grows by descending powers of two while the prefix stays
+        // below target
+        size_t pos = 0;
+        for (size_t step = std::bit_floor(n); step > 0; step >>= 1) {
+            if (pos + step <= n && t[pos + step - 1] < target) {
+                pos += step;
+                target -= t[pos - 1];
+            }
+        }
+        return pos + 1;
+    }
+    /**
+     * the values themselves, recovered in O(n).
+     */
+    vector<T> values() const {
+        vector<T> v = tree_;
+        T *p = v.data();
+        for (size_t i = v.size(); i-- > 0;) {
+            size_t parent = i | (i + 1);
+            if (parent < v.size()) {
+                p[parent] -= p[i];
+            }
+        }
+        return v;
+    }
+
+private:
+    vector<T> tree_;
+
+    /**
+     * turns n values into their tree in place, O(n).
+     */
+    static void build(T *t, size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            size_t parent = i | (i + 1);
+            if (parent < n) {
+                t[parent] += t[i];
+            }
+        }
+    }
+    T unchecked_prefix(size_t n) const {
+        const T *t = tree_.data();
+        T s = T();
+        for (; n > 0; n &= n - 1) {
+            s += t[n - 1];
+        }
+        return s;
+    }
+};
+
+/**
+ * operations for sparse_table: idempotent (op(a, a) == a) and
+ * associative, so two overlapping blocks answer any range.
+ */
+template <typename T>
+struct range_min {
+    const T &operator()(const T &a, const T &b) const {
+        return b < a ? b : a;
+    }
+};
+template <typename T>
+struct range_max {
+    const T &operator()(const T &a, const T &b) const {
+        return a < b ? b : a;
+    }
+};
+
+/**
+ * answers op over any range of a fixed sequence in O(1) after an
+ * O(n log n) build, for idempotent operations such as min, max, gcd or
+ * bitwise and/or. level k holds op over every block of 2^k values; the
+ * levels lie back to back in one vector, the lowest first, so the two
+ * blocks of a query are read from the same level.
+ */
+template <typename T, typename Op = range_min<T>>
+class sparse_table {
+public:
+    sparse_table() { }
+    explicit sparse_table(const vector<T> &values, Op op = Op()) : op_(op) {
+        assign(values);
+    }
+    void assign(const vector<T> &values) {
+        n_ = values.size();
+        table_.clear();
+        level_.clear();
+        size_t levels = n_ == 0 ? 0 : std::bit_width(n_);
+        size_t total = 0;
+        for (size_t k = 0; k < levels; k++) {
+            total += n_ - (size_t(1) << k) + 1;
+        }
+        table_.reserve(total);
+        level_.reserve(levels);
+        table_.append_range(values);
+        level_.push_back(0);
+        for (size_t k = 1; k < levels; k++) {
+            size_t prev = level_[k - 1];
+            size_t half = size_t(1) << (k - 1);
+            size_t count = n_ - (size_t(1) << k) + 1;
+            level_.push_back(table_.size());
+            for (size_t i = 0; i < count; i++) {
+                const T *t = table_.data();
+                table_.push_back(op_(t[prev + i], t[prev + i + half]));
+            }
+        }
+    }
+
+    size_t size() const {
+        return n_;
+    }
+    /**
+     * op over the values [l, r).
+     * throw index_out_of_bound if [l, r) is empty or not inside [0, size)
+     */
+    T query(const size_t &l, const size_t &r) const {
+        detail::check_range(l, r, n_);
+        if (l == r) {
+            throw index_out_of_bound();
+        }
+        size_t k = std::bit_width(r - l) - 1;
+        const T *t = table_.data() + level_.data()[k];
+        return op_(t[l], t[r - (size_t(1) << k)]);
+    }
+    /**
+     * the answers of many ranges.
+     */
+    vector<T> query(const vector<index_range> &ranges) const {
+        vector<T> result;
+        result.reserve(ranges.size());
+        for (size_t i = 0; i < ranges.size(); i++) {
+            result.push_back(query(ranges.data()[i].begin, ranges.data()[i].end));
+        }
+        return result;
+    }
+
+private:
+    vector<T> table_;
+    // where each level starts in table_
+    vector<size_t> level_;
+    size_t n_ = 0;
+    Op op_;
+};
+
+/**
+ * policies for segment_tree. a policy names
+ *   value_type, what a range sums up to, with identity() and
+ *     combine(a, b) forming a monoid;
+ *   tag_type, a pending update, with no_tag();
+ *   apply(tag, value, len), the value of a range of len elements after
+ *     the update;
+ *   compose(outer, inner), the single tag doing inner first, then outer.
+ */
+
+/**
+ * adding to every value of a range, summing a range.
+ */
+template <typename T>
+struct range_add_sum {
+    using value_type = T;
+    using tag_type = T;
+    static T identity() {
+        return T();
+    }
+    static T combine(const T &a, const T &b) {
+        return a + b;
+    }
+    static T no_tag() {
+        return T();
+    }
+    static T apply(const T &tag, const T &value, size_t len) {
+        return value + tag * static_cast<T>(len);
+    }
+    static T compose(const T &outer, const T &inner) {
+        return outer + inner;
+    }
+};
+/**
+ * adding to every value of a range, the minimum of a range. identity is
+ * the largest value of T.
+ */
+template <typename T, T Identity>
+struct range_add_min {
+    using value_type = T;
+    using tag_type = T;
+    static T identity() {
+        return Identity;
+    }
+    static T combine(const T &a, const T &b) {
+        return b < a ? b : a;
+    }
+    static T no_tag() {
+        return T();
+    }
+    static T apply(const T &tag, const T &value, size_t) {
+        return value + tag;
+    }
+    static T compose(const T &outer, const T &inner) {
+        return outer + inner;
+    }
+};
+/**
+ * adding to every value of a range, the maximum of a range. identity is
+ * the smallest value of T.
+ */
+template <typename T, T Identity>
+struct range_add_max {
+    using value_type = T;
+    using tag_type = T;
+    static T identity() {
+        return Identity;
+    }
+    static T combine(const T &a, const T &b) {
+        return a < b ? b : a;
+    }
+    static T no_tag() {
+        return T();
+    }
+    static T apply(const T &tag, const T &value, size_t) {
+        return value + tag;
+    }
+    static T compose(const T &outer, const T &inner) {
+        return outer + inner;
+    }
+};
+
+/**
+ * a segment tree with lazy propagation: updating and querying any range
+ * are O(log n). the tree is a perfect binary tree over the first power of
+ * two >= n leaves, stored implicitly in one array (node k has children 2k
+ * and 2k + 1, leaf i is node cap + i), and the pending tags of the inner
+ * nodes in a second one. queries and updates work bottom-up from the two
+ * boundary leaves without recursion, pushing tags down only along the two
+ * boundary paths.
+ * padding leaves hold identity() and never receive tags, apply is told
+ * how many real elements a node covers.
+ */
+template <typename Policy>
+class segment_tree {
+public:
+    using value_type = typename Policy::value_type;
+    using tag_type = typename Policy::tag_type;
+
+    segment_tree() { }
+    /**
+     * n identity values.
+     */
+    explicit segment_tree(const size_t &n) {
+        vector<value_type> v;
+        v.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            v.push_back(Policy::identity());
+        }
+        assign(v);
+    }
+    /**
+     * the tree of values, built in O(n).
+     */
+    explicit segment_tree(const vector<value_type> &values) {
+        assign(values);
+    }
+    void assign(const vector<value_type> &values) {
+        n_ = values.size();
+        log_ = n_ <= 1 ? 0 : std::bit_width(n_ - 1);
+        cap_ = size_t(1) << log_;
+        value_.clear();
+        tag_.clear();
+        value_.reserve(2 * cap_);
+        tag_.reserve(cap_);
+        for (size_t i = 0; i < cap_; i++) {
+            value_.push_back(Policy::identity());
+            tag_.push_back(Policy::no_tag());
+        }
+        value_.append_range(values);
+        for (size_t i = n_; i < cap_; i++) {
+            value_.push_back(Policy::identity());
+        }
+        for (size_t k = cap_; k-- > 1;) {
+            pull(k);
+        }
+    }
+
+    size_t size() const {
+        return n_;
+    }
+    /**
+     * the value at pos.
+     * throw index_out_of_bound if pos is not in [0, size)
+     */
+    value_type get(const size_t &pos) {
+        if (pos >= n_) {
+            throw index_out_of_bound();
+        }
+        size_t k = pos + cap_;
+        push_path(k);
+        return value_.data()[k];
+    }
+    void set(const size_t &pos, const value_type &value) {
+        if (pos >= n_) {
+            throw index_out_of_bound();
+        }
+        size_t k = pos + cap_;
+        push_path(k);
+        value_.data()[k] = value;
+        for (k >>= 1; k > 0; k >>= 1) {
+            pull(k);
+        }
+    }
+    /**
+     * combine over the values [l, r), identity() for an empty range.
+     * throw index_out_of_bound if [l, r) is not inside [0, size)
+     */
+    value_type query(const size_t &l, const size_t &r) {
+        detail::check_range(l, r, n_);
+        if (l == r) {
+            return Policy::identity();
+        }
+        size_t lo = l + cap_, hi = r + cap_;
+        push_boundaries(lo, hi);
+        value_type left = Policy::identity(), right = Policy::identity();
+        const value_type *v = value_.data();
+        for (; lo < hi; lo >>= 1, hi >>= 1) {
+            if (lo & 1) {
+                left = Policy::combine(left, v[lo++]);
+            }
+            if (hi & 1) {
+                right = Policy::combine(v[--hi], right);
+            }
+        }
+        return Policy::combine(left, right);
+    }
+    /**
+     * combine over all values, O(1).
+     */
+    value_type all() const {
+        return n_ == 0 ? Policy::identity() : value_.data()[1];
+    }
+    /**
+     * the answers of many ranges.
+     */
+    vector<value_type> query(const vector<index_range> &ranges) {
+        vector<value_type> result;
+        result.reserve(ranges.size());
+        for (size_t i = 0; i < ranges.size(); i++) {
+            result.push_back(query(ranges.data()[i].begin, ranges.data()[i].end));
+        }
+        return result;
+    }
+    /**
+     * applies tag to every value in [l, r).
+     * throw index_out_of_bound if [l, r) is not inside [0, size)
+     */
+    void apply(const size_t &l, const size_t &r, const tag_type &tag) {
+        detail::check_range(l, r, n_);
+        if (l == r) {
+            return;
+        }
+        size_t lo = l + cap_, hi = r + cap_;
+        push_boundaries(lo, hi);
+        for (size_t a = lo, b = hi; a < b; a >>= 1, b >>= 1) {
+            if (a & 1) {
+                apply_node(a++, tag);
+            }
+            if (b & 1) {
+                apply_node(--b, tag);
+            }
+        }
+        for (size_t i = 1; i <= log_; i++) {
+            if (((lo >> i) << i) != lo) {
+                pull(lo >> i);
+            }
+            if (((hi >> i) << i) != hi) {
+                pull((hi - 1) >> i);
+            }
+        }
+    }
+    /**
+     * all values, every pending tag pushed down, O(n).
+     */
+    vector<value_type> values() {
+        for (size_t k = 1; k < cap_; k++) {
+            push(k);
+        }
+        vector<value_type> v;
+        v.reserve(n_);
+        for (size_t i = 0; i < n_; i++) {
+            v.push_back(value_.data()[cap_ + i]);
+        }
+        return v;
+    }
+
+private:
+    // value_[k] for the nodes 1 .. 2cap - 1, tag_[k] for the inner ones
+    vector<value_type> value_;
+    vector<tag_type> tag_;
+    size_t n_ = 0;
+    size_t cap_ = 0;
+    size_t log_ = 0;
+
+    /**
+     * how many of the n real elements node k covers.
+     */
+    size_t width(size_t k) const {
+        size_t depth = std::bit_width(k) - 1;
+        size_t len = cap_ >> depth;
+        size_t first = (k - (size_t(1) << depth)) * len;
+        if (first >= n_) {
+            return 0;
+        }
+        return n_ - first < len ? n_ - first : len;
+    }
+    void pull(size_t k) {
+        value_type *v = value_.data();
+        v[k] = Policy::combine(v[2 * k], v[2 * k + 1]);
+    }
+    void apply_node(size_t k, const tag_type &tag) {
+        size_t len = width(k);
+        if (len == 0) {
+            return;
+        }
+        value_type *v = value_.data();
+        v[k] = Policy::apply(tag, v[k], len);
+        if (k < cap_) {
+            tag_type *t = tag_.data();
+            t[k] = Policy::compose(tag, t[k]);
+        }
+    }
+    void push(size_t k) {
+        tag_type *t = tag_.data();
+        apply_node(2 * k, t[k]);
+        apply_node(2 * k + 1, t[k]);
+        t[k] = Policy::no_tag();
+    }
+    /**
+     * pushes the tags above leaf k down to it.
+     */
+    void push_path(size_t k) {
+        for (size_t i = log_; i >= 1; i--) {
+            push(k >> i);
+        }
+    }
+    /**
+     * pushes the tags above the nodes the range [lo, hi) of leaves
+     * decomposes into.
+     */
+    void push_boundaries(size_t lo, size_t hi) {
+        for (size_t i = log_; i >= 1; i--) {
+            if (((lo >> i) << i) != lo) {
+                push(lo >> i);
+            }
+            if (((hi >> i) << i) != hi) {
+                push((hi - 1) >> i);
+            }
+        }
+    }
+};
+
+}  // namespace sjtu
+
+#endif
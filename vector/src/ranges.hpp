@@ -0,0 +1,56 @@
+#ifndef SJTU_RANGES_HPP
+#define SJTU_RANGES_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+
+namespace sjtu {
+
+/**
+ * selects the range constructors, as std::from_range does in C++23 (the
+ * standard library this tree builds with does not have it yet):
+ *   sjtu::vector<int> v(sjtu::from_range, std::views::iota(0, 10));
+ */
+struct from_range_t {
+    explicit from_range_t() = default;
+};
+inline constexpr from_range_t from_range{};
+
+namespace detail {
+
+/**
+ * a range whose elements convert to T.
+ */
+template <typename R, typename T>
+concept container_compatible_range =
+    std::ranges::input_range<R> && std::convertible_to<std::ranges::range_reference_t<R>, T>;
+
+/**
+ * a range whose elements can be copied into T storage as raw bytes.
+ */
+template <typename R, typename T>
+concept trivially_copyable_range =
+    std::ranges::contiguous_range<R> && std::ranges::sized_range<R> && std::is_trivially_copyable_v<T> &&
+    std::same_as<std::ranges::range_value_t<R>, T>;
+
+/**
+ * the number of elements of r when it can be known without consuming r,
+ * 0 for single-pass ranges. a forward range that does not know its size
+ * is walked once to count it.
+ */
+template <typename R>
+constexpr size_t range_size_hint(R &r) {
+    if constexpr (std::ranges::sized_range<R>) {
+        return std::ranges::size(r);
+    } else if constexpr (std::ranges::forward_range<R>) {
+        return std::ranges::distance(r);
+    } else {
+        return 0;
+    }
+}
+
+}  // namespace detail
+}  // namespace sjtu
+
+#endif
@@ -0,0 +1,695 @@
+#ifndef SJTU_SIMD_ALGORITHM_HPP
+#define SJTU_SIMD_ALGORITHM_HPP
+
+#include "cpu_features.hpp"
+#include "exceptions.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace sjtu {
+
+namespace detail {
+
+/**
+ * portable kernels, used for every arithmetic type and as the fallback
+ * when the CPU has neither AVX2 nor SSE4.2.
+ */
+template <typename T>
+size_t find_scalar(const T *p, size_t n, T x) {
+    for (size_t i = 0; i < n; ++i) {
+        if (p[i] == x) {
+            return i;
+        }
+    }
+    return n;
+}
+
+template <typename T>
+size_t count_scalar(const T *p, size_t n, T x) {
+    size_t cnt = 0;
+    for (size_t i = 0; i < n; ++i) {
+        cnt += p[i] == x;
+    }
+    return cnt;
+}
+
+template <typename T>
+void minmax_scalar(const T *p, size_t n, T &mn, T &mx) {
+    for (size_t i = 0; i < n; ++i) {
+        if (p[i] < mn) {
+            mn = p[i];
+        }
+        if (mx < p[i]) {
+            mx = p[i];
+        }
+    }
+}
+
+template <typename T>
+using sum_t = std::conditional_t<
+    std::is_floating_point_v<T>, double,
+    std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>>;
+
+template <typename T>
+sum_t<T> sum_scalar(const T *p, size_t n) {
+    sum_t<T> s = 0;
+    for (size_t i = 0; i < n; ++i) {
+        s += p[i];
+    }
+    return s;
+}
+
+template <typename T>
+bool equal_scalar(const T *a, const T *b, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        if (!(a[i] == b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+bool contains_any_scalar(const T *p, size_t n, const T *values, size_t m) {
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < m; ++j) {
+            if (p[i] == values[j]) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+#ifdef SJTU_X86_SIMD
+
+SJTU_TARGET_AVX2 inline unsigned eq_mask_avx2(const int *p, __m256i needle) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    return _mm256_movemask_ps(
+        _mm256_castsi256_ps(_mm256_cmpeq_epi32(v, needle)));
+}
+
+SJTU_TARGET_AVX2 inline unsigned eq_mask_avx2(const double *p,
+                                              __m256d needle) {
+    return _mm256_movemask_pd(
+        _mm256_cmp_pd(_mm256_loadu_pd(p), needle, _CMP_EQ_OQ));
+}
+
+SJTU_TARGET_SSE42 inline unsigned eq_mask_sse(const int *p, __m128i needle) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v, needle)));
+}
+
+SJTU_TARGET_SSE42 inline unsigned eq_mask_sse(const double *p,
+                                             __m128d needle) {
+    return _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(p), needle));
+}
+
+// find: 4 registers are tested per iteration, the exact lane is located
+// afterwards by the single register loop.
+
+SJTU_TARGET_AVX2 inline size_t find_avx2(const int *p, size_t n, int x) {
+    const __m256i needle = _mm256_set1_epi32(x);
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        if (eq_mask_avx2(p + i, needle) | eq_mask_avx2(p + i + 8, needle) |
+            eq_mask_avx2(p + i + 16, needle) |
+            eq_mask_avx2(p + i + 24, needle)) {
+            break;
+        }
+    }
+    for (; i + 8 <= n; i += 8) {
+        unsigned mask = eq_mask_avx2(p + i, needle);
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + find_scalar(p + i, n - i, x);
+}
+
+SJTU_TARGET_AVX2 inline size_t find_avx2(const double *p, size_t n,
+                                         double x) {
+    const __m256d needle = _mm256_set1_pd(x);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        if (eq_mask_avx2(p + i, needle) | eq_mask_avx2(p + i + 4, needle) |
+            eq_mask_avx2(p + i + 8, needle) |
+            eq_mask_avx2(p + i + 12, needle)) {
+            break;
+        }
+    }
+    for (; i + 4 <= n; i += 4) {
+        unsigned mask = eq_mask_avx2(p + i, needle);
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + find_scalar(p + i, n - i, x);
+}
+
+SJTU_TARGET_SSE42 inline size_t find_sse(const int *p, size_t n, int x) {
+    const __m128i needle = _mm_set1_epi32(x);
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        if (eq_mask_sse(p + i, needle) | eq_mask_sse(p + i + 4, needle) |
+            eq_mask_sse(p + i + 8, needle) | eq_mask_sse(p + i + 12, needle)) {
+            break;
+        }
+    }
+    for (; i + 4 <= n; i += 4) {
+        unsigned mask = eq_mask_sse(p + i, needle);
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + find_scalar(p + i, n - i, x);
+}
+
+SJTU_TARGET_SSE42 inline size_t find_sse(const double *p, size_t n,
+                                        double x) {
+    const __m128d needle = _mm_set1_pd(x);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        if (eq_mask_sse(p + i, needle) | eq_mask_sse(p + i + 2, needle) |
+            eq_mask_sse(p + i + 4, needle) | eq_mask_sse(p + i + 6, needle)) {
+            break;
+        }
+    }
+    for (; i + 2 <= n; i += 2) {
+        unsigned mask = eq_mask_sse(p + i, needle);
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return i + find_scalar(p + i, n - i, x);
+}
+
+// count: the integer kernels subtract the all-ones compare result from
+// per-lane counters, which are flushed before they can overflow.
+
+SJTU_TARGET_AVX2 inline size_t count_avx2(const int *p, size_t n, int x) {
+    const __m256i needle = _mm256_set1_epi32(x);
+    const size_t kFlush = size_t(1) << 30;
+    size_t cnt = 0;
+    size_t i = 0;
+    while (i + 8 <= n) {
+        __m256i acc = _mm256_setzero_si256();
+        size_t stop = n - i > kFlush ? i + kFlush : n;
+        for (; i + 8 <= stop; i += 8) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+            acc = _mm256_sub_epi32(acc, _mm256_cmpeq_epi32(v, needle));
+        }
+        alignas(32) unsigned lane[8];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lane), acc);
+        for (int k = 0; k < 8; ++k) {
+            cnt += lane[k];
+        }
+    }
+    return cnt + count_scalar(p + i, n - i, x);
+}
+
+SJTU_TARGET_AVX2 inline size_t count_avx2(const double *p, size_t n,
+                                          double x) {
+    const __m256d needle = _mm256_set1_pd(x);
+    size_t cnt = 0;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        cnt += __builtin_popcount(eq_mask_avx2(p + i, needle));
+    }
+    return cnt + count_scalar(p + i, n - i, x);
+}
+
+SJTU_TARGET_SSE42 inline size_t count_sse(const int *p, size_t n, int x) {
+    const __m128i needle = _mm_set1_epi32(x);
+    const size_t kFlush = size_t(1) << 30;
+    size_t cnt = 0;
+    size_t i = 0;
+    while (i + 4 <= n) {
+        __m128i acc = _mm_setzero_si128();
+        size_t stop = n - i > kFlush ? i + kFlush : n;
+        for (; i + 4 <= stop; i += 4) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+            acc = _mm_sub_epi32(acc, _mm_cmpeq_epi32(v, needle));
+        }
+        alignas(16) unsigned lane[4];
+        _mm_store_si128(reinterpret_cast<__m128i *>(lane), acc);
+        for (int k = 0; k < 4; ++k) {
+            cnt += lane[k];
+        }
+    }
+    return cnt + count_scalar(p + i, n - i, x);
+}
+
+SJTU_TARGET_SSE42 inline size_t count_sse(const double *p, size_t n,
+                                         double x) {
+    const __m128d needle = _mm_set1_pd(x);
+    size_t cnt = 0;
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        cnt += __builtin_popcount(eq_mask_sse(p + i, needle));
+    }
+    return cnt + count_scalar(p + i, n - i, x);
+}
+
+// minmax: mn and mx must be initialized by the caller.
+
+SJTU_TARGET_AVX2 inline void minmax_avx2(const int *p, size_t n, int &mn,
+                                         int &mx) {
+    size_t i = 0;
+    if (n >= 8) {
+        __m256i vmin = _mm256_set1_epi32(mn);
+        __m256i vmax = _mm256_set1_epi32(mx);
+        for (; i + 8 <= n; i += 8) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+            vmin = _mm256_min_epi32(vmin, v);
+            vmax = _mm256_max_epi32(vmax, v);
+        }
+        alignas(32) int lane[8];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lane), vmin);
+        minmax_scalar(lane, 8, mn, mx);
+        _mm256_store_si256(reinterpret_cast<__m256i *>(lane), vmax);
+        minmax_scalar(lane, 8, mn, mx);
+    }
+    minmax_scalar(p + i, n - i, mn, mx);
+}
+
+SJTU_TARGET_AVX2 inline void minmax_avx2(const double *p, size_t n,
+                                         double &mn, double &mx) {
+    size_t i = 0;
+    if (n >= 4) {
+        __m256d vmin = _mm256_set1_pd(mn);
+        __m256d vmax = _mm256_set1_pd(mx);
+        for (; i + 4 <= n; i += 4) {
+            __m256d v = _mm256_loadu_pd(p + i);
+            vmin = _mm256_min_pd(v, vmin);
+            vmax = _mm256_max_pd(v, vmax);
+        }
+        alignas(32) double lane[4];
+        _mm256_store_pd(lane, vmin);
+        minmax_scalar(lane, 4, mn, mx);
+        _mm256_store_pd(lane, vmax);
+        minmax_scalar(lane, 4, mn, mx);
+    }
+    minmax_scalar(p + i, n - i, mn, mx);
+}
+
+SJTU_TARGET_SSE42 inline void minmax_sse(const int *p, size_t n, int &mn,
+                                        int &mx) {
+    size_t i = 0;
+    if (n >= 4) {
+        __m128i vmin = _mm_set1_epi32(mn);
+        __m128i vmax = _mm_set1_epi32(mx);
+        for (; i + 4 <= n; i += 4) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+            vmin = _mm_min_epi32(vmin, v);
+            vmax = _mm_max_epi32(vmax, v);
+        }
+        alignas(16) int lane[4];
+        _mm_store_si128(reinterpret_cast<__m128i *>(lane), vmin);
+        minmax_scalar(lane, 4, mn, mx);
+        _mm_store_si128(reinterpret_cast<__m128i *>(lane), vmax);
+        minmax_scalar(lane, 4, mn, mx);
+    }
+    minmax_scalar(p + i, n - i, mn, mx);
+}
+
+SJTU_TARGET_SSE42 inline void minmax_sse(const double *p, size_t n,
+                                        double &mn, double &mx) {
+    size_t i = 0;
+    if (n >= 2) {
+        __m128d vmin = _mm_set1_pd(mn);
+        __m128d vmax = _mm_set1_pd(mx);
+        for (; i + 2 <= n; i += 2) {
+            __m128d v = _mm_loadu_pd(p + i);
+            vmin = _mm_min_pd(v, vmin);
+            vmax = _mm_max_pd(v, vmax);
+        }
+        alignas(16) double lane[2];
+        _mm_store_pd(lane, vmin);
+        minmax_scalar(lane, 2, mn, mx);
+        _mm_store_pd(lane, vmax);
+        minmax_scalar(lane, 2, mn, mx);
+    }
+    minmax_scalar(p + i, n - i, mn, mx);
+}
+
+// sum: int lanes are widened to 64 bits before accumulation, so the result
+// equals the scalar one exactly. double sums are accumulated in several
+// lanes, which may round differently from a left-to-right loop.
+
+SJTU_TARGET_AVX2 inline long long sum_avx2(const int *p, size_t n) {
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+        acc0 = _mm256_add_epi64(
+            acc0, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        acc1 = _mm256_add_epi64(
+            acc1, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+    alignas(32) long long lane[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lane),
+                       _mm256_add_epi64(acc0, acc1));
+    return lane[0] + lane[1] + lane[2] + lane[3] + sum_scalar(p + i, n - i);
+}
+
+SJTU_TARGET_AVX2 inline double sum_avx2(const double *p, size_t n) {
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(p + i));
+        acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(p + i + 4));
+    }
+    alignas(32) double lane[4];
+    _mm256_store_pd(lane, _mm256_add_pd(acc0, acc1));
+    return (lane[0] + lane[1]) + (lane[2] + lane[3]) +
+           sum_scalar(p + i, n - i);
+}
+
+SJTU_TARGET_SSE42 inline long long sum_sse(const int *p, size_t n) {
+    __m128i acc0 = _mm_setzero_si128();
+    __m128i acc1 = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+        acc0 = _mm_add_epi64(acc0, _mm_cvtepi32_epi64(v));
+        acc1 = _mm_add_epi64(acc1, _mm_cvtepi32_epi64(_mm_srli_si128(v, 8)));
+    }
+    alignas(16) long long lane[2];
+    _mm_store_si128(reinterpret_cast<__m128i *>(lane), _mm_add_epi64(acc0, acc1));
+    return lane[0] + lane[1] + sum_scalar(p + i, n - i);
+}
+
+SJTU_TARGET_SSE42 inline double sum_sse(const double *p, size_t n) {
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc0 = _mm_add_pd(acc0, _mm_loadu_pd(p + i));
+        acc1 = _mm_add_pd(acc1, _mm_loadu_pd(p + i + 2));
+    }
+    alignas(16) double lane[2];
+    _mm_store_pd(lane, _mm_add_pd(acc0, acc1));
+    return (lane[0] + lane[1]) + sum_scalar(p + i, n - i);
+}
+
+// equal: only needed for double, where 0.0 == -0.0 and NaN != NaN rule out
+// a byte comparison.
+
+SJTU_TARGET_AVX2 inline bool equal_avx2(const double *a, const double *b,
+                                        size_t n) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d eq = _mm256_cmp_pd(_mm256_loadu_pd(a + i),
+                                   _mm256_loadu_pd(b + i), _CMP_EQ_OQ);
+        if (_mm256_movemask_pd(eq) != 0xf) {
+            return false;
+        }
+    }
+    return equal_scalar(a + i, b + i, n - i);
+}
+
+SJTU_TARGET_SSE42 inline bool equal_sse(const double *a, const double *b,
+                                       size_t n) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d eq = _mm_cmpeq_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i));
+        if (_mm_movemask_pd(eq) != 0x3) {
+            return false;
+        }
+    }
+    return equal_scalar(a + i, b + i, n - i);
+}
+
+// contains_any: every loaded register is compared against each needle, so
+// the data is read only once however many needles are given.
+
+SJTU_TARGET_AVX2 inline bool contains_any_avx2(const int *p, size_t n,
+                                               const int *values, size_t m) {
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i));
+        __m256i hit = _mm256_setzero_si256();
+        for (size_t j = 0; j < m; ++j) {
+            hit = _mm256_or_si256(
+                hit, _mm256_cmpeq_epi32(v, _mm256_set1_epi32(values[j])));
+        }
+        if (!_mm256_testz_si256(hit, hit)) {
+            return true;
+        }
+    }
+    return contains_any_scalar(p + i, n - i, values, m);
+}
+
+SJTU_TARGET_AVX2 inline bool contains_any_avx2(const double *p, size_t n,
+                                               const double *values,
+                                               size_t m) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(p + i);
+        __m256d hit = _mm256_setzero_pd();
+        for (size_t j = 0; j < m; ++j) {
+            hit = _mm256_or_pd(
+                hit, _mm256_cmp_pd(v, _mm256_set1_pd(values[j]), _CMP_EQ_OQ));
+        }
+        if (_mm256_movemask_pd(hit)) {
+            return true;
+        }
+    }
+    return contains_any_scalar(p + i, n - i, values, m);
+}
+
+SJTU_TARGET_SSE42 inline bool contains_any_sse(const int *p, size_t n,
+                                              const int *values, size_t m) {
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+        __m128i hit = _mm_setzero_si128();
+        for (size_t j = 0; j < m; ++j) {
+            hit = _mm_or_si128(hit,
+                               _mm_cmpeq_epi32(v, _mm_set1_epi32(values[j])));
+        }
+        if (!_mm_testz_si128(hit, hit)) {
+            return true;
+        }
+    }
+    return contains_any_scalar(p + i, n - i, values, m);
+}
+
+SJTU_TARGET_SSE42 inline bool contains_any_sse(const double *p, size_t n,
+                                              const double *values,
+                                              size_t m) {
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d v = _mm_loadu_pd(p + i);
+        __m128d hit = _mm_setzero_pd();
+        for (size_t j = 0; j < m; ++j) {
+            hit = _mm_or_pd(hit, _mm_cmpeq_pd(v, _mm_set1_pd(values[j])));
+        }
+        if (_mm_movemask_pd(hit)) {
+            return true;
+        }
+    }
+    return contains_any_scalar(p + i, n - i, values, m);
+}
+
+#endif
+
+/**
+ * the dispatchers below pick a kernel for int and double according to
+ * cpu_simd_level(), other arithmetic types use the scalar kernels.
+ */
+template <typename T>
+constexpr bool has_simd_kernel_v =
+    std::is_same_v<T, int> || std::is_same_v<T, double>;
+
+template <typename T>
+size_t find(const T *p, size_t n, T x) {
+#ifdef SJTU_X86_SIMD
+    if constexpr (has_simd_kernel_v<T>) {
+        switch (cpu_simd_level()) {
+            case simd_level::avx2:
+                return find_avx2(p, n, x);
+            case simd_level::sse42:
+                return find_sse(p, n, x);
+            default:
+                break;
+        }
+    }
+#endif
+    return find_scalar(p, n, x);
+}
+
+template <typename T>
+size_t count(const T *p, size_t n, T x) {
+#ifdef SJTU_X86_SIMD
+    if constexpr (has_simd_kernel_v<T>) {
+        switch (cpu_simd_level()) {
+            case simd_level::avx2:
+                return count_avx2(p, n, x);
+            case simd_level::sse42:
+                return count_sse(p, n, x);
+            default:
+                break;
+        }
+    }
+#endif
+    return count_scalar(p, n, x);
+}
+
+template <typename T>
+void minmax(const T *p, size_t n, T &mn, T &mx) {
+#ifdef SJTU_X86_SIMD
+    if constexpr (has_simd_kernel_v<T>) {
+        switch (cpu_simd_level()) {
+            case simd_level::avx2:
+                minmax_avx2(p, n, mn, mx);
+                return;
+            case simd_level::sse42:
+                minmax_sse(p, n, mn, mx);
+                return;
+            default:
+                break;
+        }
+    }
+#endif
+    minmax_scalar(p, n, mn, mx);
+}
+
+template <typename T>
+sum_t<T> sum(const T *p, size_t n) {
+#ifdef SJTU_X86_SIMD
+    if constexpr (has_simd_kernel_v<T>) {
+        switch (cpu_simd_level()) {
+            case simd_level::avx2:
+                return sum_avx2(p, n);
+            case simd_level::sse42:
+                return sum_sse(p, n);
+            default:
+                break;
+        }
+    }
+#endif
+    return sum_scalar(p, n);
+}
+
+template <typename T>
+bool equal(const T *a, const T *b, size_t n) {
+    if constexpr (std::is_integral_v<T>) {
+        // integers compare equal iff their bytes do, and memcmp is
+        // vectorized by the C library already.
+        return n == 0 || memcmp(a, b, n * sizeof(T)) == 0;
+    } else {
+#ifdef SJTU_X86_SIMD
+        if constexpr (std::is_same_v<T, double>) {
+            switch (cpu_simd_level()) {
+                case simd_level::avx2:
+                    return equal_avx2(a, b, n);
+                case simd_level::sse42:
+                    return equal_sse(a, b, n);
+                default:
+                    break;
+            }
+        }
+#endif
+        return equal_scalar(a, b, n);
+    }
+}
+
+template <typename T>
+bool contains_any(const T *p, size_t n, const T *values, size_t m) {
+#ifdef SJTU_X86_SIMD
+    if constexpr (has_simd_kernel_v<T>) {
+        switch (cpu_simd_level()) {
+            case simd_level::avx2:
+                return contains_any_avx2(p, n, values, m);
+            case simd_level::sse42:
+                return contains_any_sse(p, n, values, m);
+            default:
+                break;
+        }
+    }
+#endif
+    return contains_any_scalar(p, n, values, m);
+}
+
+}  // namespace detail
+
+/**
+ * returns the index of the first element equal to value,
+ * or size() if there is none.
+ */
+template <typename T>
+size_t find(const vector<T> &v, const T &value) {
+    static_assert(std::is_arithmetic_v<T>, "find requires arithmetic T");
+    return detail::find(v.data(), v.size(), value);
+}
+
+/**
+ * returns the number of elements equal to value.
+ */
+template <typename T>
+size_t count(const vector<T> &v, const T &value) {
+    static_assert(std::is_arithmetic_v<T>, "count requires arithmetic T");
+    return detail::count(v.data(), v.size(), value);
+}
+
+/**
+ * returns the smallest and the largest element as (min, max).
+ * the result is unspecified if a floating point vector holds NaN.
+ * throw container_is_empty if size == 0
+ */
+template <typename T>
+pair<T, T> minmax(const vector<T> &v) {
+    static_assert(std::is_arithmetic_v<T>, "minmax requires arithmetic T");
+    if (v.empty()) {
+        throw container_is_empty();
+    }
+    T mn = v.data()[0];
+    T mx = v.data()[0];
+    detail::minmax(v.data() + 1, v.size() - 1, mn, mx);
+    const T &lo = mn;
+    const T &hi = mx;
+    return pair<T, T>(lo, hi);
+}
+
+/**
+ * returns the sum of all elements, accumulated in long long
+ * (unsigned long long for unsigned T) or double.
+ */
+template <typename T>
+detail::sum_t<T> sum(const vector<T> &v) {
+    static_assert(std::is_arithmetic_v<T>, "sum requires arithmetic T");
+    return detail::sum(v.data(), v.size());
+}
+
+/**
+ * checks whether two vectors have the same size and equal elements.
+ */
+template <typename T>
+bool equal(const vector<T> &a, const vector<T> &b) {
+    static_assert(std::is_arithmetic_v<T>, "equal requires arithmetic T");
+    return a.size() == b.size() && detail::equal(a.data(), b.data(), a.size());
+}
+
+/**
+ * checks whether v holds an element equal to any of values.
+ * intended for a handful of values, the cost is O(size() * values.size()).
+ */
+template <typename T>
+bool contains_any(const vector<T> &v, const vector<T> &values) {
+    static_assert(std::is_arithmetic_v<T>,
+                  "contains_any requires arithmetic T");
+    return detail::contains_any(v.data(), v.size(), values.data(),
+                                values.size());
+}
+
+}  // namespace sjtu
+
+#endif
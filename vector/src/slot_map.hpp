@@ -0,0 +1,217 @@
+#ifndef SJTU_SLOT_MAP_HPP
+#define SJTU_SLOT_MAP_HPP
+
+#include "exceptions.hpp"
+#include "vector.hpp"
+
+#include <cstddef>
+#include <utility>
+
+namespace sjtu {
+
+/**
+ * a container handing out stable handles to its elements.
+ * the values are packed densely in a sjtu::vector, erasing moves the last
+ * value into the hole, so insert and erase are O(1) and iteration walks
+ * successive memory. a handle keeps referring to its value across those
+ * moves and is detected as stale once the value is erased.
+ *
+ * a handle is 64 bits: the low half is a slot index, the high half the
+ * slot's generation. a slot's generation is odd while it holds a value and
+ * is increased on every insert and erase, so 0 is never a valid handle.
+ * a slot is retired instead of reused once its generation runs out, so
+ * the generation never wraps around to one an old handle carries.
+ */
+template <typename T>
+class slot_map {
+public:
+    using handle = unsigned long long;
+    using iterator = typename vector<T>::iterator;
+    using const_iterator = typename vector<T>::const_iterator;
+
+    static constexpr handle kNullHandle = 0;
+
+    slot_map() { }
+
+    /**
+     * stores a copy of value and returns its handle.
+     */
+    handle insert(const T &value) {
+        unsigned slot = acquire_slot();
+        try {
+            values_.push_back(value);
+        } catch (...) {
+            release_slot(slot);
+            throw;
+        }
+        dense_to_slot_.push_back(slot);
+        slots_[slot].index = values_.size() - 1;
+        return make_handle(slot, slots_[slot].generation);
+    }
+    /**
+     * removes the value referred by h, h and every copy of it become stale.
+     * throw invalid_iterator if h is stale
+     */
+    void erase(const handle &h) {
+        unsigned slot = checked_slot(h);
+        size_t index = slots_[slot].index;
+        size_t last = values_.size() - 1;
+        if (index != last) {
+            values_[index] = std::move(values_[last]);
+            dense_to_slot_[index] = dense_to_slot_[last];
+            slots_[dense_to_slot_[index]].index = index;
+        }
+        values_.pop_back();
+        dense_to_slot_.pop_back();
+        release_slot(slot);
+    }
+    /**
+     * checks whether h refers to a value in this container.
+     */
+    bool contains(const handle &h) const {
+        unsigned slot = static_cast<unsigned>(h);
+        return slot < slots_.size() && slots_[slot].generation == generation_of(h) &&
+               (generation_of(h) & 1);
+    }
+    /**
+     * returns a pointer to the value of h, or nullptr if h is stale.
+     */
+    T *find(const handle &h) {
+        return contains(h) ? &values_[slots_[static_cast<unsigned>(h)].index] : nullptr;
+    }
+    const T *find(const handle &h) const {
+        return contains(h) ? &values_[slots_[static_cast<unsigned>(h)].index] : nullptr;
+    }
+    /**
+     * throw invalid_iterator if h is stale
+     */
+    T &at(const handle &h) {
+        return values_[slots_[checked_slot(h)].index];
+    }
+    const T &at(const handle &h) const {
+        return values_[slots_[checked_slot(h)].index];
+    }
+    T &operator[](const handle &h) {
+        return at(h);
+    }
+    const T &operator[](const handle &h) const {
+        return at(h);
+    }
+    /**
+     * returns the current position of h's value in the dense storage,
+     * valid until the next erase.
+     * throw invalid_iterator if h is stale
+     */
+    size_t index_of(const handle &h) const {
+        return slots_[checked_slot(h)].index;
+    }
+    /**
+     * returns the handle of the value at position index of the dense
+     * storage.
+     * throw index_out_of_bound if index >= size
+     */
+    handle handle_at(const size_t &index) const {
+        unsigned slot = dense_to_slot_[index];
+        return make_handle(slot, slots_[slot].generation);
+    }
+    /**
+     * the values in their dense order.
+     */
+    iterator begin() {
+        return values_.begin();
+    }
+    const_iterator begin() const {
+        return values_.begin();
+    }
+    iterator end() {
+        return values_.end();
+    }
+    const_iterator end() const {
+        return values_.end();
+    }
+    T *data() {
+        return values_.data();
+    }
+    const T *data() const {
+        return values_.data();
+    }
+    bool empty() const {
+        return values_.empty();
+    }
+    size_t size() const {
+        return values_.size();
+    }
+    /**
+     * makes room for n values without reallocation.
+     */
+    void reserve(const size_t &n) {
+        values_.reserve(n);
+        dense_to_slot_.reserve(n);
+        slots_.reserve(n);
+    }
+    /**
+     * removes every value at once, all outstanding handles become stale.
+     * the slots are kept for reuse.
+     */
+    void clear() {
+        for (size_t i = 0; i < dense_to_slot_.size(); ++i) {
+            release_slot(dense_to_slot_[i]);
+        }
+        values_.clear();
+        dense_to_slot_.clear();
+    }
+
+private:
+    struct slot_entry {
+        // position in values_ while alive, the next free slot otherwise
+        size_t index;
+        unsigned generation;
+    };
+    static constexpr size_t kNoFreeSlot = static_cast<size_t>(-1);
+    // the last even generation, a slot that reaches it is never used again
+    static constexpr unsigned kRetiredGeneration = static_cast<unsigned>(-1) - 1;
+
+    vector<T> values_;
+    vector<unsigned> dense_to_slot_;
+    vector<slot_entry> slots_;
+    size_t free_head_ = kNoFreeSlot;
+
+    static handle make_handle(unsigned slot, unsigned generation) {
+        return (static_cast<handle>(generation) << 32) | slot;
+    }
+    static unsigned generation_of(const handle &h) {
+        return static_cast<unsigned>(h >> 32);
+    }
+    unsigned checked_slot(const handle &h) const {
+        if (!contains(h)) {
+            throw invalid_iterator();
+        }
+        return static_cast<unsigned>(h);
+    }
+    /**
+     * pops a slot from the free list (or appends one) and marks it alive.
+     */
+    unsigned acquire_slot() {
+        unsigned slot;
+        if (free_head_ != kNoFreeSlot) {
+            slot = static_cast<unsigned>(free_head_);
+            free_head_ = slots_[slot].index;
+        } else {
+            slots_.push_back(slot_entry{kNoFreeSlot, 0});
+            slot = slots_.size() - 1;
+        }
+        ++slots_[slot].generation;
+        return slot;
+    }
+    void release_slot(unsigned slot) {
+        if (++slots_[slot].generation == kRetiredGeneration) {
+            return;
+        }
+        slots_[slot].index = free_head_;
+        free_head_ = slot;
+    }
+};
+
+}  // namespace sjtu
+
+#endif
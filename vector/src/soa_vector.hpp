@@ -0,0 +1,406 @@
+#ifndef SJTU_SOA_VECTOR_HPP
+#define SJTU_SOA_VECTOR_HPP
+
+#include "exceptions.hpp"
+#include "span.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <tuple>
+#include <utility>
+
+namespace sjtu {
+
+/**
+ * a structure-of-arrays container: row i is (column<0>()[i], ...,
+ * column<N-1>()[i]) and every field is kept in its own successive memory,
+ * all columns sharing one size and capacity.
+ * a loop touching one field reads only that field's column.
+ */
+template <typename... Fields>
+class soa_vector {
+    static_assert(sizeof...(Fields) > 0, "soa_vector needs at least one field");
+
+public:
+    static constexpr size_t kFields = sizeof...(Fields);
+    template <size_t I>
+    using field_type = std::tuple_element_t<I, std::tuple<Fields...>>;
+    using value_type = std::tuple<Fields...>;
+    /**
+     * a row proxy, so AoS-style code keeps working:
+     *   for (auto [x, y] : v) { x += y; }
+     */
+    using reference = std::tuple<Fields &...>;
+    using const_reference = std::tuple<const Fields &...>;
+
+    class const_iterator;
+    class iterator {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = soa_vector::value_type;
+        using reference = soa_vector::reference;
+
+    private:
+        soa_vector *owner_;
+        size_t idx_;
+        friend class const_iterator;
+    public:
+        iterator() : owner_(nullptr), idx_(0) { }
+        iterator(soa_vector *owner, size_t idx) : owner_(owner), idx_(idx) { }
+        iterator operator+(const int &n) const {
+            return iterator(owner_, idx_ + n);
+        }
+        iterator operator-(const int &n) const {
+            return iterator(owner_, idx_ - n);
+        }
+        // if these two iterators point to different containers, throw invaild_iterator.
+        int operator-(const iterator &rhs) const {
+            if (owner_ != rhs.owner_) {
+                throw invalid_iterator();
+            }
+            return idx_ - rhs.idx_;
+        }
+        iterator &operator+=(const int &n) {
+            idx_ += n;
+            return *this;
+        }
+        iterator &operator-=(const int &n) {
+            idx_ -= n;
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator p = *this;
+            ++idx_;
+            return p;
+        }
+        iterator &operator++() {
+            ++idx_;
+            return *this;
+        }
+        iterator operator--(int) {
+            iterator p = *this;
+            --idx_;
+            return p;
+        }
+        iterator &operator--() {
+            --idx_;
+            return *this;
+        }
+        reference operator*() const {
+            return owner_->row(idx_, std::index_sequence_for<Fields...>());
+        }
+        bool operator==(const iterator &rhs) const {
+            return owner_ == rhs.owner_ && idx_ == rhs.idx_;
+        }
+        bool operator!=(const iterator &rhs) const {
+            return !(*this == rhs);
+        }
+    };
+    class const_iterator {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = soa_vector::value_type;
+        using reference = soa_vector::const_reference;
+
+    private:
+        const soa_vector *owner_;
+        size_t idx_;
+    public:
+        const_iterator() : owner_(nullptr), idx_(0) { }
+        const_iterator(const soa_vector *owner, size_t idx) : owner_(owner), idx_(idx) { }
+        const_iterator(const iterator &it) : owner_(it.owner_), idx_(it.idx_) { }
+        const_iterator operator+(const int &n) const {
+            return const_iterator(owner_, idx_ + n);
+        }
+        const_iterator operator-(const int &n) const {
+            return const_iterator(owner_, idx_ - n);
+        }
+        int operator-(const const_iterator &rhs) const {
+            if (owner_ != rhs.owner_) {
+                throw invalid_iterator();
+            }
+            return idx_ - rhs.idx_;
+        }
+        const_iterator &operator+=(const int &n) {
+            idx_ += n;
+            return *this;
+        }
+        const_iterator &operator-=(const int &n) {
+            idx_ -= n;
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator p = *this;
+            ++idx_;
+            return p;
+        }
+        const_iterator &operator++() {
+            ++idx_;
+            return *this;
+        }
+        const_iterator operator--(int) {
+            const_iterator p = *this;
+            --idx_;
+            return p;
+        }
+        const_iterator &operator--() {
+            --idx_;
+            return *this;
+        }
+        reference operator*() const {
+            return owner_->row(idx_, std::index_sequence_for<Fields...>());
+        }
+        bool operator==(const const_iterator &rhs) const {
+            return owner_ == rhs.owner_ && idx_ == rhs.idx_;
+        }
+        bool operator!=(const const_iterator &rhs) const {
+            return !(*this == rhs);
+        }
+    };
+
+    soa_vector() { }
+    soa_vector(const soa_vector &other) {
+        reserve(other.size_);
+        try {
+            for (size_t i = 0; i < other.size_; ++i) {
+                construct_row<0>(i, other.row(i, std::index_sequence_for<Fields...>()));
+                ++size_;
+            }
+        } catch (...) {
+            clear();
+            free_columns(columns_, std::index_sequence_for<Fields...>());
+            throw;
+        }
+    }
+    soa_vector(soa_vector &&other) noexcept
+        : columns_(other.columns_), size_(other.size_), capacity_(other.capacity_) {
+        other.columns_ = std::tuple<Fields *...>();
+        other.size_ = other.capacity_ = 0;
+    }
+    ~soa_vector() {
+        clear();
+        free_columns(columns_, std::index_sequence_for<Fields...>());
+    }
+    soa_vector &operator=(const soa_vector &other) {
+        if (this == &other) {
+            return *this;
+        }
+        soa_vector tmp(other);
+        swap(tmp);
+        return *this;
+    }
+    soa_vector &operator=(soa_vector &&other) noexcept {
+        swap(other);
+        return *this;
+    }
+    void swap(soa_vector &other) noexcept {
+        std::swap(columns_, other.columns_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+    /**
+     * returns the row proxy at pos.
+     * throw index_out_of_bound if pos is not in [0, size)
+     */
+    reference at(const size_t &pos) {
+        if (pos >= size_) {
+            throw index_out_of_bound();
+        }
+        return row(pos, std::index_sequence_for<Fields...>());
+    }
+    const_reference at(const size_t &pos) const {
+        if (pos >= size_) {
+            throw index_out_of_bound();
+        }
+        return row(pos, std::index_sequence_for<Fields...>());
+    }
+    reference operator[](const size_t &pos) {
+        return at(pos);
+    }
+    const_reference operator[](const size_t &pos) const {
+        return at(pos);
+    }
+    /**
+     * returns field I of row pos.
+     * throw index_out_of_bound if pos is not in [0, size)
+     */
+    template <size_t I>
+    field_type<I> &get(const size_t &pos) {
+        if (pos >= size_) {
+            throw index_out_of_bound();
+        }
+        return std::get<I>(columns_)[pos];
+    }
+    template <size_t I>
+    const field_type<I> &get(const size_t &pos) const {
+        if (pos >= size_) {
+            throw index_out_of_bound();
+        }
+        return std::get<I>(columns_)[pos];
+    }
+    /**
+     * returns the successive storage of field I, valid until the next
+     * reallocation.
+     */
+    template <size_t I>
+    span<field_type<I>> column() {
+        return span<field_type<I>>(std::get<I>(columns_), size_);
+    }
+    template <size_t I>
+    span<const field_type<I>> column() const {
+        return span<const field_type<I>>(std::get<I>(columns_), size_);
+    }
+
+    iterator begin() {
+        return iterator(this, 0);
+    }
+    const_iterator begin() const {
+        return const_iterator(this, 0);
+    }
+    const_iterator cbegin() const {
+        return const_iterator(this, 0);
+    }
+    iterator end() {
+        return iterator(this, size_);
+    }
+    const_iterator end() const {
+        return const_iterator(this, size_);
+    }
+    const_iterator cend() const {
+        return const_iterator(this, size_);
+    }
+    bool empty() const {
+        return size_ == 0;
+    }
+    size_t size() const {
+        return size_;
+    }
+    size_t capacity() const {
+        return capacity_;
+    }
+    void clear() {
+        for (size_t i = 0; i < size_; ++i) {
+            destroy_row(i, std::index_sequence_for<Fields...>());
+        }
+        size_ = 0;
+    }
+    /**
+     * makes room for n rows, every column is reallocated at once.
+     */
+    void reserve(const size_t &n) {
+        if (n <= capacity_) {
+            return;
+        }
+        std::tuple<Fields *...> fresh;
+        allocate_columns(fresh, n, std::index_sequence_for<Fields...>());
+        relocate_columns(fresh, std::index_sequence_for<Fields...>());
+        free_columns(columns_, std::index_sequence_for<Fields...>());
+        columns_ = fresh;
+        capacity_ = n;
+    }
+    /**
+     * adds a row to the end.
+     */
+    void push_back(const value_type &value) {
+        grow_if_full();
+        construct_row<0>(size_, value);
+        ++size_;
+    }
+    void push_back(value_type &&value) {
+        grow_if_full();
+        construct_row<0>(size_, std::move(value));
+        ++size_;
+    }
+    /**
+     * adds a row to the end, field i is constructed from the i-th argument.
+     */
+    template <typename... Args>
+    void emplace_back(Args &&...args) {
+        static_assert(sizeof...(Args) == kFields, "emplace_back takes one argument per field");
+        grow_if_full();
+        construct_row<0>(size_, std::forward_as_tuple(std::forward<Args>(args)...));
+        ++size_;
+    }
+    /**
+     * remove the last row.
+     * throw container_is_empty if size() == 0
+     */
+    void pop_back() {
+        if (size_ == 0) {
+            throw container_is_empty();
+        }
+        --size_;
+        destroy_row(size_, std::index_sequence_for<Fields...>());
+    }
+
+private:
+    std::tuple<Fields *...> columns_;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+
+    void grow_if_full() {
+        if (size_ == capacity_) {
+            reserve(capacity_ ? capacity_ * 2 : 1);
+        }
+    }
+    template <size_t... I>
+    reference row(size_t pos, std::index_sequence<I...>) {
+        return reference(std::get<I>(columns_)[pos]...);
+    }
+    template <size_t... I>
+    const_reference row(size_t pos, std::index_sequence<I...>) const {
+        return const_reference(std::get<I>(columns_)[pos]...);
+    }
+    /**
+     * constructs the fields I.. of row pos from the matching elements of
+     * the tuple t; if one constructor throws, the fields already built are
+     * destroyed again.
+     */
+    template <size_t I, typename Tuple>
+    void construct_row(size_t pos, Tuple &&t) {
+        if constexpr (I < kFields) {
+            using F = field_type<I>;
+            F *p = std::get<I>(columns_) + pos;
+            new (p) F(std::get<I>(std::forward<Tuple>(t)));
+            try {
+                construct_row<I + 1>(pos, std::forward<Tuple>(t));
+            } catch (...) {
+                p->~F();
+                throw;
+            }
+        }
+    }
+    template <size_t... I>
+    void destroy_row(size_t pos, std::index_sequence<I...>) {
+        ((std::get<I>(columns_) + pos)->~Fields(), ...);
+    }
+    template <size_t... I>
+    static void free_columns(std::tuple<Fields *...> &cols, std::index_sequence<I...>) {
+        (free(std::get<I>(cols)), ...);
+    }
+    template <size_t... I>
+    static void allocate_columns(std::tuple<Fields *...> &cols, size_t n, std::index_sequence<I...>) {
+        ((std::get<I>(cols) = reinterpret_cast<Fields *>(malloc(n * sizeof(Fields)))), ...);
+        if (((std::get<I>(cols) == nullptr) || ...)) {
+            free_columns(cols, std::index_sequence<I...>());
+            throw std::bad_alloc();
+        }
+    }
+    template <typename F>
+    void relocate_column(F *dst, F *src) {
+        for (size_t i = 0; i < size_; ++i) {
+            new (dst + i) F(std::move(src[i]));
+            src[i].~F();
+        }
+    }
+    template <size_t... I>
+    void relocate_columns(std::tuple<Fields *...> &fresh, std::index_sequence<I...>) {
+        (relocate_column(std::get<I>(fresh), std::get<I>(columns_)), ...);
+    }
+};
+
+}  // namespace sjtu
+
+#endif
@@ -0,0 +1,742 @@
+#ifndef SJTU_SORT_HPP
+#define SJTU_SORT_HPP
+
+#include "vector.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu {
+
+namespace detail {
+
+// ranges shorter than this are finished by insertion sort.
+const size_t kInsertionSortThreshold = 24;
+// ranges longer than this pick the pivot by Tukey's ninther.
+const size_t kNintherThreshold = 128;
+// partial insertion sort gives up after moving this many elements.
+const size_t kPartialInsertionSortLimit = 8;
+// sort() hands arithmetic vectors at least this long to radix_sort().
+const size_t kRadixSortThreshold = 1 << 12;
+
+template <typename T, class Compare>
+void insertion_sort(T *begin, T *end, Compare &comp) {
+    if (begin == end) {
+        return;
+    }
+    for (T *cur = begin + 1; cur != end; ++cur) {
+        T *sift = cur;
+        T *sift_1 = cur - 1;
+        if (comp(*sift, *sift_1)) {
+            T tmp(std::move(*sift));
+            do {
+                *sift-- = std::move(*sift_1);
+            } while (sift != begin && comp(tmp, *--sift_1));
+            *sift = std::move(tmp);
+        }
+    }
+}
+
+/**
+ * insertion sort which assumes *(begin - 1) is not greater than any element
+ * in [begin, end), so the inner loop needs no bound check.
+ */
+template <typename T, class Compare>
+void unguarded_insertion_sort(T *begin, T *end, Compare &comp) {
+    if (begin == end) {
+        return;
+    }
+    for (T *cur = begin + 1; cur != end; ++cur) {
+        T *sift = cur;
+        T *sift_1 = cur - 1;
+        if (comp(*sift, *sift_1)) {
+            T tmp(std::move(*sift));
+            do {
+                *sift-- = std::move(*sift_1);
+            } while (comp(tmp, *--sift_1));
+            *sift = std::move(tmp);
+        }
+    }
+}
+
+/**
+ * attempts insertion sort, but gives up once too many elements are moved.
+ * returns true if [begin, end) is sorted afterwards.
+ */
+template <typename T, class Compare>
+bool partial_insertion_sort(T *begin, T *end, Compare &comp) {
+    if (begin == end) {
+        return true;
+    }
+    size_t limit = 0;
+    for (T *cur = begin + 1; cur != end; ++cur) {
+        T *sift = cur;
+        T *sift_1 = cur - 1;
+        if (comp(*sift, *sift_1)) {
+            T tmp(std::move(*sift));
+            do {
+                *sift-- = std::move(*sift_1);
+            } while (sift != begin && comp(tmp, *--sift_1));
+            *sift = std::move(tmp);
+            limit += cur - sift;
+        }
+        if (limit > kPartialInsertionSortLimit) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T, class Compare>
+void sort2(T *a, T *b, Compare &comp) {
+    if (comp(*b, *a)) {
+        std::swap(*a, *b);
+    }
+}
+
+template <typename T, class Compare>
+void sort3(T *a, T *b, T *c, Compare &comp) {
+    sort2(a, b, comp);
+    sort2(b, c, comp);
+    sort2(a, b, comp);
+}
+
+template <typename T, class Compare>
+void sift_down(T *heap, size_t pos, size_t len, Compare &comp) {
+    T tmp(std::move(heap[pos]));
+    while (true) {
+        size_t child = pos * 2 + 1;
+        if (child >= len) {
+            break;
+        }
+        if (child + 1 < len && comp(heap[child], heap[child + 1])) {
+            ++child;
+        }
+        if (!comp(tmp, heap[child])) {
+            break;
+        }
+        heap[pos] = std::move(heap[child]);
+        pos = child;
+    }
+    heap[pos] = std::move(tmp);
+}
+
+template <typename T, class Compare>
+void make_heap(T *begin, T *end, Compare &comp) {
+    size_t len = end - begin;
+    for (size_t i = len / 2; i > 0; --i) {
+        sift_down(begin, i - 1, len, comp);
+    }
+}
+
+template <typename T, class Compare>
+void sort_heap(T *begin, T *end, Compare &comp) {
+    for (size_t len = end - begin; len > 1; --len) {
+        std::swap(begin[0], begin[len - 1]);
+        sift_down(begin, 0, len - 1, comp);
+    }
+}
+
+template <typename T, class Compare>
+void heap_sort(T *begin, T *end, Compare &comp) {
+    make_heap(begin, end, comp);
+    sort_heap(begin, end, comp);
+}
+
+/**
+ * partitions [begin, end) around the pivot *begin, elements equal to the
+ * pivot go to the right part.
+ * returns the final position of the pivot and whether the range was already
+ * partitioned (no swap happened).
+ * requires an element not less than the pivot somewhere after begin.
+ */
+template <typename T, class Compare>
+std::pair<T *, bool> partition_right(T *begin, T *end, Compare &comp) {
+    T pivot(std::move(*begin));
+    T *first = begin;
+    T *last = end;
+    while (comp(*++first, pivot)) {
+    }
+    if (first - 1 == begin) {
+        while (first < last && !comp(*--last, pivot)) {
+        }
+    } else {
+        while (!comp(*--last, pivot)) {
+        }
+    }
+    bool already_partitioned = first >= last;
+    while (first < last) {
+        std::swap(*first, *last);
+        while (comp(*++first, pivot)) {
+        }
+        while (!comp(*--last, pivot)) {
+        }
+    }
+    T *pivot_pos = first - 1;
+    *begin = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return std::pair<T *, bool>(pivot_pos, already_partitioned);
+}
+
+/**
+ * partitions [begin, end) around the pivot *begin, elements equal to the
+ * pivot go to the left part. used when the range is known to hold many
+ * copies of the pivot, so they are never touched again.
+ */
+template <typename T, class Compare>
+T *partition_left(T *begin, T *end, Compare &comp) {
+    T pivot(std::move(*begin));
+    T *first = begin;
+    T *last = end;
+    while (comp(pivot, *--last)) {
+    }
+    if (last + 1 == end) {
+        while (first < last && !comp(pivot, *++first)) {
+        }
+    } else {
+        while (!comp(pivot, *++first)) {
+        }
+    }
+    while (first < last) {
+        std::swap(*first, *last);
+        while (comp(pivot, *--last)) {
+        }
+        while (!comp(pivot, *++first)) {
+        }
+    }
+    T *pivot_pos = last;
+    *begin = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return pivot_pos;
+}
+
+/**
+ * moves the pivot candidate to *begin: median of three for short ranges,
+ * Tukey's ninther for long ones.
+ */
+template <typename T, class Compare>
+void choose_pivot(T *begin, T *end, Compare &comp) {
+    size_t size = end - begin;
+    size_t s2 = size / 2;
+    if (size > kNintherThreshold) {
+        sort3(begin, begin + s2, end - 1, comp);
+        sort3(begin + 1, begin + (s2 - 1), end - 2, comp);
+        sort3(begin + 2, begin + (s2 + 1), end - 3, comp);
+        sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), comp);
+        std::swap(*begin, *(begin + s2));
+    } else {
+        sort3(begin + s2, begin, end - 1, comp);
+    }
+}
+
+/**
+ * swaps a few elements of an unbalanced part to break the pattern which
+ * caused the bad partition.
+ */
+template <typename T>
+void break_patterns(T *begin, T *end) {
+    size_t size = end - begin;
+    if (size < kInsertionSortThreshold) {
+        return;
+    }
+    size_t q = size / 4;
+    std::swap(*begin, *(begin + q));
+    std::swap(*(end - 1), *(end - q));
+    if (size > kNintherThreshold) {
+        std::swap(*(begin + 1), *(begin + (q + 1)));
+        std::swap(*(begin + 2), *(begin + (q + 2)));
+        std::swap(*(end - 2), *(end - (q + 1)));
+        std::swap(*(end - 3), *(end - (q + 2)));
+    }
+}
+
+inline int log2_floor(size_t n) {
+    int log = 0;
+    while (n >>= 1) {
+        ++log;
+    }
+    return log;
+}
+
+/**
+ * pattern-defeating quicksort.
+ * bad_allowed is the number of highly unbalanced partitions tolerated before
+ * falling back to heap sort, which bounds the worst case by O(nlogn).
+ * leftmost is false if *(begin - 1) is a valid sentinel.
+ */
+template <typename T, class Compare>
+void pdqsort_loop(T *begin, T *end, Compare &comp, int bad_allowed,
+                  bool leftmost) {
+    while (true) {
+        size_t size = end - begin;
+        if (size < kInsertionSortThreshold) {
+            if (leftmost) {
+                insertion_sort(begin, end, comp);
+            } else {
+                unguarded_insertion_sort(begin, end, comp);
+            }
+            return;
+        }
+        choose_pivot(begin, end, comp);
+        // the pivot equals the sentinel on the left, so every element equal
+        // to the pivot is already in place and only greater ones remain.
+        if (!leftmost && !comp(*(begin - 1), *begin)) {
+            begin = partition_left(begin, end, comp) + 1;
+            continue;
+        }
+        std::pair<T *, bool> part = partition_right(begin, end, comp);
+        T *pivot_pos = part.first;
+        size_t l_size = pivot_pos - begin;
+        size_t r_size = end - (pivot_pos + 1);
+        if (l_size < size / 8 || r_size < size / 8) {
+            if (--bad_allowed == 0) {
+                heap_sort(begin, end, comp);
+                return;
+            }
+            break_patterns(begin, pivot_pos);
+            break_patterns(pivot_pos + 1, end);
+        } else if (part.second && partial_insertion_sort(begin, pivot_pos, comp) &&
+                   partial_insertion_sort(pivot_pos + 1, end, comp)) {
+            return;
+        }
+        pdqsort_loop(begin, pivot_pos, comp, bad_allowed, leftmost);
+        begin = pivot_pos + 1;
+        leftmost = false;
+    }
+}
+
+/**
+ * destroys the objects placed in a scratch buffer when leaving the scope,
+ * including by an exception thrown from Compare.
+ */
+template <typename T>
+struct scratch_guard {
+    T *buf;
+    size_t len;
+    ~scratch_guard() {
+        for (size_t i = 0; i < len; ++i) {
+            buf[i].~T();
+        }
+    }
+};
+
+template <typename T, class Compare>
+void merge_sort(T *begin, T *end, T *buf, Compare &comp) {
+    size_t size = end - begin;
+    if (size <= kInsertionSortThreshold) {
+        insertion_sort(begin, end, comp);
+        return;
+    }
+    T *mid = begin + size / 2;
+    merge_sort(begin, mid, buf, comp);
+    merge_sort(mid, end, buf, comp);
+    if (!comp(*mid, *(mid - 1))) {
+        return;
+    }
+    scratch_guard<T> guard{buf, 0};
+    for (T *p = begin; p != mid; ++p, ++guard.len) {
+        new (buf + guard.len) T(std::move(*p));
+    }
+    T *a = buf;
+    T *a_end = buf + guard.len;
+    T *b = mid;
+    T *out = begin;
+    while (a != a_end && b != end) {
+        if (comp(*b, *a)) {
+            *out++ = std::move(*b++);
+        } else {
+            *out++ = std::move(*a++);
+        }
+    }
+    while (a != a_end) {
+        *out++ = std::move(*a++);
+    }
+}
+
+/**
+ * maps an arithmetic key to an unsigned integer of the same width whose
+ * natural order agrees with the order of the key.
+ */
+template <typename K, size_t Size = sizeof(K)>
+struct radix_traits;
+
+template <typename K>
+struct radix_traits<K, 4> {
+    using type = unsigned int;
+};
+
+template <typename K>
+struct radix_traits<K, 8> {
+    using type = unsigned long long;
+};
+
+template <typename K>
+struct radix_traits<K, 2> {
+    using type = unsigned short;
+};
+
+template <typename K>
+struct radix_traits<K, 1> {
+    using type = unsigned char;
+};
+
+template <typename K>
+using radix_key_t = typename radix_traits<K>::type;
+
+template <typename K>
+radix_key_t<K> to_radix_key(K key) {
+    using U = radix_key_t<K>;
+    const U sign = U(1) << (sizeof(U) * 8 - 1);
+    U bits;
+    memcpy(&bits, &key, sizeof(U));
+    if constexpr (std::is_floating_point_v<K>) {
+        return (bits & sign) ? U(~bits) : U(bits | sign);
+    } else if constexpr (std::is_signed_v<K>) {
+        return bits ^ sign;
+    } else {
+        return bits;
+    }
+}
+
+template <typename K>
+K from_radix_key(radix_key_t<K> bits) {
+    using U = radix_key_t<K>;
+    const U sign = U(1) << (sizeof(U) * 8 - 1);
+    if constexpr (std::is_floating_point_v<K>) {
+        bits = (bits & sign) ? U(bits ^ sign) : U(~bits);
+    } else if constexpr (std::is_signed_v<K>) {
+        bits ^= sign;
+    }
+    K key;
+    memcpy(&key, &bits, sizeof(U));
+    return key;
+}
+
+// keys of up to 8 bytes with radix_traits for their size. long double
+// is left out, the padding bytes of its representation are not part of
+// the value.
+template <typename K>
+constexpr bool is_radix_key_v = ((std::is_integral_v<K> &&
+                                  !std::is_same_v<K, bool>) ||
+                                 (std::is_floating_point_v<K> &&
+                                  !std::is_same_v<K, long double>)) &&
+                                sizeof(K) <= 8;
+
+/**
+ * LSD radix sort on unsigned keys, one byte per pass. keys[] and, if not
+ * null, the satellite idx[] are permuted together; the result stays in
+ * keys/idx. passes whose byte is equal for all keys are skipped.
+ */
+template <typename U>
+void radix_sort_keys(U *keys, size_t *idx, size_t n) {
+    const size_t kPasses = sizeof(U);
+    size_t *count =
+        reinterpret_cast<size_t *>(calloc(kPasses * 256, sizeof(size_t)));
+    U *keys_buf = reinterpret_cast<U *>(malloc(n * sizeof(U)));
+    size_t *idx_buf =
+        idx ? reinterpret_cast<size_t *>(malloc(n * sizeof(size_t))) : nullptr;
+    if (!count || !keys_buf || (idx && !idx_buf)) {
+        free(count);
+        free(keys_buf);
+        free(idx_buf);
+        throw std::bad_alloc();
+    }
+    for (size_t i = 0; i < n; ++i) {
+        U k = keys[i];
+        for (size_t pass = 0; pass < kPasses; ++pass) {
+            ++count[pass * 256 + ((k >> (pass * 8)) & 0xff)];
+        }
+    }
+    U *src_keys = keys;
+    U *dst_keys = keys_buf;
+    size_t *src_idx = idx;
+    size_t *dst_idx = idx_buf;
+    for (size_t pass = 0; pass < kPasses; ++pass) {
+        size_t *c = count + pass * 256;
+        if (c[(src_keys[0] >> (pass * 8)) & 0xff] == n) {
+            continue;
+        }
+        size_t sum = 0;
+        for (size_t b = 0; b < 256; ++b) {
+            size_t tmp = c[b];
+            c[b] = sum;
+            sum += tmp;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            size_t pos = c[(src_keys[i] >> (pass * 8)) & 0xff]++;
+            dst_keys[pos] = src_keys[i];
+            if (src_idx) {
+                dst_idx[pos] = src_idx[i];
+            }
+        }
+        std::swap(src_keys, dst_keys);
+        std::swap(src_idx, dst_idx);
+    }
+    if (src_keys != keys) {
+        memcpy(keys, src_keys, n * sizeof(U));
+        if (idx) {
+            memcpy(idx, src_idx, n * sizeof(size_t));
+        }
+    }
+    free(count);
+    free(keys_buf);
+    free(idx_buf);
+}
+
+}  // namespace detail
+
+/**
+ * sorts [begin, end) by pattern-defeating quicksort.
+ * O(nlogn) in the worst case, O(n) for sorted, reversed or equal ranges.
+ * not stable.
+ */
+template <typename T, class Compare>
+void sort(T *begin, T *end, Compare comp) {
+    if (end - begin < 2) {
+        return;
+    }
+    detail::pdqsort_loop(begin, end, comp, detail::log2_floor(end - begin),
+                         true);
+}
+
+/**
+ * sorts [begin, end) by merge sort, the relative order of equal elements is
+ * preserved. needs an extra buffer of (end - begin) / 2 elements.
+ */
+template <typename T, class Compare>
+void stable_sort(T *begin, T *end, Compare comp) {
+    size_t size = end - begin;
+    if (size < 2) {
+        return;
+    }
+    T *buf = reinterpret_cast<T *>(malloc((size / 2 + 1) * sizeof(T)));
+    if (!buf) {
+        throw std::bad_alloc();
+    }
+    try {
+        detail::merge_sort(begin, end, buf, comp);
+    } catch (...) {
+        free(buf);
+        throw;
+    }
+    free(buf);
+}
+
+/**
+ * rearranges [begin, end) so that [begin, middle) holds the smallest
+ * elements in sorted order. O(nlogk) where k = middle - begin.
+ */
+template <typename T, class Compare>
+void partial_sort(T *begin, T *middle, T *end, Compare comp) {
+    if (begin == middle) {
+        return;
+    }
+    size_t k = middle - begin;
+    detail::make_heap(begin, middle, comp);
+    for (T *cur = middle; cur != end; ++cur) {
+        if (comp(*cur, *begin)) {
+            std::swap(*cur, *begin);
+            detail::sift_down(begin, 0, k, comp);
+        }
+    }
+    detail::sort_heap(begin, middle, comp);
+}
+
+/**
+ * rearranges [begin, end) so that *nth is the element which would be there
+ * if the range were sorted, no element before nth is greater than it and no
+ * element after nth is less than it. O(n) on average.
+ */
+template <typename T, class Compare>
+void nth_element(T *begin, T *nth, T *end, Compare comp) {
+    if (nth >= end) {
+        return;
+    }
+    int bad_allowed = detail::log2_floor(end - begin);
+    while (size_t(end - begin) >= detail::kInsertionSortThreshold) {
+        detail::choose_pivot(begin, end, comp);
+        T *pivot_pos = detail::partition_right(begin, end, comp).first;
+        size_t size = end - begin;
+        size_t l_size = pivot_pos - begin;
+        if (l_size < size / 8 || size - l_size - 1 < size / 8) {
+            if (--bad_allowed == 0) {
+                partial_sort(begin, nth + 1, end, comp);
+                return;
+            }
+            detail::break_patterns(begin, pivot_pos);
+            detail::break_patterns(pivot_pos + 1, end);
+        }
+        if (pivot_pos == nth) {
+            return;
+        }
+        if (nth < pivot_pos) {
+            end = pivot_pos;
+        } else {
+            begin = pivot_pos + 1;
+        }
+    }
+    detail::insertion_sort(begin, end, comp);
+}
+
+/**
+ * sorts arithmetic elements by LSD radix sort in O(n * sizeof(T)).
+ * floating point values are ordered by their IEEE-754 bits, so -0.0 comes
+ * before 0.0 and NaNs are put at both ends according to their sign.
+ */
+template <typename T>
+void radix_sort(T *begin, T *end) {
+    static_assert(detail::is_radix_key_v<T>,
+                  "radix_sort requires integral or floating point elements of at most 8 bytes, not long double");
+    using U = detail::radix_key_t<T>;
+    size_t n = end - begin;
+    if (n < 2) {
+        return;
+    }
+    U *keys = reinterpret_cast<U *>(malloc(n * sizeof(U)));
+    if (!keys) {
+        throw std::bad_alloc();
+    }
+    for (size_t i = 0; i < n; ++i) {
+        keys[i] = detail::to_radix_key(begin[i]);
+    }
+    try {
+        detail::radix_sort_keys(keys, static_cast<size_t *>(nullptr), n);
+    } catch (...) {
+        free(keys);
+        throw;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        begin[i] = detail::from_radix_key<T>(keys[i]);
+    }
+    free(keys);
+}
+
+/**
+ * sorts elements by the arithmetic key key(element) using LSD radix sort.
+ * the sort is stable, key is called exactly once per element.
+ */
+template <typename T, class KeyOf>
+void radix_sort(T *begin, T *end, KeyOf key) {
+    using K = std::decay_t<decltype(key(*begin))>;
+    static_assert(detail::is_radix_key_v<K>,
+                  "radix_sort requires an integral or floating point key of at most 8 bytes, not long double");
+    using U = detail::radix_key_t<K>;
+    size_t n = end - begin;
+    if (n < 2) {
+        return;
+    }
+    // owns the scratch memory, the moved elements in tmp are destroyed
+    // even if moving another one throws.
+    struct buffers {
+        U *keys;
+        size_t *idx;
+        T *tmp;
+        size_t built;
+        ~buffers() {
+            for (size_t i = 0; i < built; ++i) {
+                tmp[i].~T();
+            }
+            free(keys);
+            free(idx);
+            free(tmp);
+        }
+    } b{reinterpret_cast<U *>(malloc(n * sizeof(U))),
+        reinterpret_cast<size_t *>(malloc(n * sizeof(size_t))),
+        reinterpret_cast<T *>(malloc(n * sizeof(T))), 0};
+    if (!b.keys || !b.idx || !b.tmp) {
+        throw std::bad_alloc();
+    }
+    for (size_t i = 0; i < n; ++i) {
+        b.keys[i] = detail::to_radix_key(static_cast<K>(key(begin[i])));
+        b.idx[i] = i;
+    }
+    detail::radix_sort_keys(b.keys, b.idx, n);
+    for (; b.built < n; ++b.built) {
+        new (b.tmp + b.built) T(std::move(begin[b.idx[b.built]]));
+    }
+    for (size_t i = 0; i < n; ++i) {
+        begin[i] = std::move(b.tmp[i]);
+    }
+}
+
+template <typename T, class Compare>
+void sort(vector<T> &v, Compare comp) {
+    sort(v.data(), v.data() + v.size(), comp);
+}
+
+/**
+ * sorts v in ascending order. long vectors of integral or floating point
+ * elements of up to 8 bytes are dispatched to radix_sort, the others to
+ * pdqsort.
+ */
+template <typename T>
+void sort(vector<T> &v) {
+    if constexpr (detail::is_radix_key_v<T>) {
+        if (v.size() >= detail::kRadixSortThreshold) {
+            radix_sort(v.data(), v.data() + v.size());
+            return;
+        }
+    }
+    sort(v.data(), v.data() + v.size(), std::less<T>());
+}
+
+template <typename T, class Compare>
+void stable_sort(vector<T> &v, Compare comp) {
+    stable_sort(v.data(), v.data() + v.size(), comp);
+}
+
+template <typename T>
+void stable_sort(vector<T> &v) {
+    stable_sort(v.data(), v.data() + v.size(), std::less<T>());
+}
+
+template <typename T>
+void radix_sort(vector<T> &v) {
+    radix_sort(v.data(), v.data() + v.size());
+}
+
+template <typename T, class KeyOf>
+void radix_sort(vector<T> &v, KeyOf key) {
+    radix_sort(v.data(), v.data() + v.size(), key);
+}
+
+/**
+ * throw index_out_of_bound if k > size
+ */
+template <typename T, class Compare>
+void partial_sort(vector<T> &v, const size_t &k, Compare comp) {
+    if (k > v.size()) {
+        throw index_out_of_bound();
+    }
+    partial_sort(v.data(), v.data() + k, v.data() + v.size(), comp);
+}
+
+template <typename T>
+void partial_sort(vector<T> &v, const size_t &k) {
+    partial_sort(v, k, std::less<T>());
+}
+
+/**
+ * throw index_out_of_bound if k >= size
+ */
+template <typename T, class Compare>
+void nth_element(vector<T> &v, const size_t &k, Compare comp) {
+    if (k >= v.size()) {
+        throw index_out_of_bound();
+    }
+    nth_element(v.data(), v.data() + k, v.data() + v.size(), comp);
+}
+
+template <typename T>
+void nth_element(vector<T> &v, const size_t &k) {
+    nth_element(v, k, std::less<T>());
+}
+
+}  // namespace sjtu
+
+#endif
@@ -0,0 +1,326 @@
+#ifndef SJTU_SPAN_HPP
+#define SJTU_SPAN_HPP
+
+#include "exceptions.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+
+namespace sjtu {
+
+template <typename T>
+class span;
+
+namespace detail {
+
+/**
+ * anything exposing successive storage through data() and size() whose
+ * elements can be viewed as T: sjtu::vector, inplace_vector, devector,
+ * the rows of Diamond::Matrix, other spans...
+ */
+template <typename C, typename T>
+concept contiguous_source = requires(C &c) {
+    { c.data() } -> std::convertible_to<T *>;
+    { c.size() } -> std::convertible_to<size_t>;
+} && std::is_convertible_v<std::remove_pointer_t<decltype(std::declval<C &>().data())> (*)[], T (*)[]>;
+
+}  // namespace detail
+
+/**
+ * a non-owning view of size() successive elements starting at data().
+ * it is invalidated by anything that reallocates the viewed storage.
+ */
+template <typename T>
+class span {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using pointer = T *;
+    using reference = T &;
+    using iterator = T *;
+
+    span() : data_(nullptr), size_(0) { }
+    span(T *data, const size_t &size) : data_(data), size_(size) { }
+    template <size_t N>
+    span(T (&arr)[N]) : data_(arr), size_(N) { }
+    /**
+     * views every element of c; a span of T is also a span of const T.
+     */
+    template <typename C>
+        requires detail::contiguous_source<C, T>
+    span(C &&c) : data_(c.data()), size_(c.size()) { }
+
+    /**
+     * throw index_out_of_bound if pos is not in [0, size)
+     */
+    T &operator[](const size_t &pos) const {
+        if (pos >= size_) {
+            throw index_out_of_bound();
+        }
+        return data_[pos];
+    }
+    /**
+     * throw container_is_empty if size == 0
+     */
+    T &front() const {
+        if (size_ == 0) {
+            throw container_is_empty();
+        }
+        return data_[0];
+    }
+    T &back() const {
+        if (size_ == 0) {
+            throw container_is_empty();
+        }
+        return data_[size_ - 1];
+    }
+    T *data() const {
+        return data_;
+    }
+    size_t size() const {
+        return size_;
+    }
+    bool empty() const {
+        return size_ == 0;
+    }
+    iterator begin() const {
+        return data_;
+    }
+    iterator end() const {
+        return data_ + size_;
+    }
+    /**
+     * the first count elements.
+     * throw index_out_of_bound if count > size
+     */
+    span first(const size_t &count) const {
+        return subspan(0, count);
+    }
+    /**
+     * the last count elements.
+     * throw index_out_of_bound if count > size
+     */
+    span last(const size_t &count) const {
+        if (count > size_) {
+            throw index_out_of_bound();
+        }
+        return span(data_ + (size_ - count), count);
+    }
+    /**
+     * count elements starting at offset, or everything from offset on if
+     * count is omitted.
+     * throw index_out_of_bound if the range does not fit in [0, size)
+     */
+    span subspan(const size_t &offset, const size_t &count = static_cast<size_t>(-1)) const {
+        if (offset > size_) {
+            throw index_out_of_bound();
+        }
+        if (count == static_cast<size_t>(-1)) {
+            return span(data_ + offset, size_ - offset);
+        }
+        if (count > size_ - offset) {
+            throw index_out_of_bound();
+        }
+        return span(data_ + offset, count);
+    }
+
+private:
+    T *data_;
+    size_t size_;
+};
+
+/**
+ * a non-owning view of size() elements that are stride() elements apart,
+ * such as one column of a row-major buffer:
+ *   strided_span<double> col = strided_span<double>::column(flat, n_cols, j);
+ */
+template <typename T>
+class strided_span {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+
+    class iterator {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::remove_cv_t<T>;
+        using pointer = T *;
+        using reference = T &;
+        using iterator_category = std::random_access_iterator_tag;
+
+    private:
+        // an index instead of a moving pointer, so end() never points past the buffer
+        T *base_;
+        std::ptrdiff_t idx_;
+        std::ptrdiff_t stride_;
+    public:
+        iterator() : base_(nullptr), idx_(0), stride_(1) { }
+        iterator(T *base, std::ptrdiff_t idx, std::ptrdiff_t stride) : base_(base), idx_(idx), stride_(stride) { }
+        iterator operator+(const std::ptrdiff_t &n) const {
+            return iterator(base_, idx_ + n, stride_);
+        }
+        iterator operator-(const std::ptrdiff_t &n) const {
+            return iterator(base_, idx_ - n, stride_);
+        }
+        std::ptrdiff_t operator-(const iterator &rhs) const {
+            return idx_ - rhs.idx_;
+        }
+        iterator &operator+=(const std::ptrdiff_t &n) {
+            idx_ += n;
+            return *this;
+        }
+        iterator &operator-=(const std::ptrdiff_t &n) {
+            idx_ -= n;
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator p = *this;
+            ++idx_;
+            return p;
+        }
+        iterator &operator++() {
+            ++idx_;
+            return *this;
+        }
+        iterator operator--(int) {
+            iterator p = *this;
+            --idx_;
+            return p;
+        }
+        iterator &operator--() {
+            --idx_;
+            return *this;
+        }
+        T &operator*() const {
+            return base_[idx_ * stride_];
+        }
+        T &operator[](const std::ptrdiff_t &n) const {
+            return base_[(idx_ + n) * stride_];
+        }
+        bool operator==(const iterator &rhs) const {
+            return base_ == rhs.base_ && idx_ == rhs.idx_;
+        }
+        bool operator!=(const iterator &rhs) const {
+            return !(*this == rhs);
+        }
+        bool operator<(const iterator &rhs) const {
+            return idx_ < rhs.idx_;
+        }
+        bool operator>(const iterator &rhs) const {
+            return rhs < *this;
+        }
+        bool operator<=(const iterator &rhs) const {
+            return !(rhs < *this);
+        }
+        bool operator>=(const iterator &rhs) const {
+            return !(*this < rhs);
+        }
+        friend iterator operator+(const std::ptrdiff_t &n, const iterator &it) {
+            return it + n;
+        }
+    };
+
+    strided_span() : data_(nullptr), size_(0), stride_(1) { }
+    strided_span(T *data, const size_t &size, const std::ptrdiff_t &stride)
+        : data_(data), size_(size), stride_(stride) { }
+    /**
+     * a span is a strided_span of stride 1.
+     */
+    template <typename U>
+        requires std::is_convertible_v<U (*)[], T (*)[]>
+    strided_span(const span<U> &s) : data_(s.data()), size_(s.size()), stride_(1) { }
+    template <typename U>
+        requires(!std::is_same_v<U, T> && std::is_convertible_v<U (*)[], T (*)[]>)
+    strided_span(const strided_span<U> &s) : data_(s.data()), size_(s.size()), stride_(s.stride()) { }
+
+    /**
+     * column col of a row-major buffer with n_cols columns.
+     * throw index_out_of_bound if col >= n_cols
+     * throw runtime_error if the buffer size is not a multiple of n_cols
+     */
+    static strided_span column(span<T> storage, const size_t &n_cols, const size_t &col) {
+        if (col >= n_cols) {
+            throw index_out_of_bound();
+        }
+        if (storage.size() % n_cols != 0) {
+            throw runtime_error();
+        }
+        return strided_span(storage.data() + col, storage.size() / n_cols, n_cols);
+    }
+
+    /**
+     * throw index_out_of_bound if pos is not in [0, size)
+     */
+    T &operator[](const size_t &pos) const {
+        if (pos >= size_) {
+            throw index_out_of_bound();
+        }
+        return data_[pos * stride_];
+    }
+    T *data() const {
+        return data_;
+    }
+    size_t size() const {
+        return size_;
+    }
+    std::ptrdiff_t stride() const {
+        return stride_;
+    }
+    bool empty() const {
+        return size_ == 0;
+    }
+    iterator begin() const {
+        return iterator(data_, 0, stride_);
+    }
+    iterator end() const {
+        return iterator(data_, size_, stride_);
+    }
+    /**
+     * throw index_out_of_bound if count > size
+     */
+    strided_span first(const size_t &count) const {
+        return subspan(0, count);
+    }
+    strided_span last(const size_t &count) const {
+        if (count > size_) {
+            throw index_out_of_bound();
+        }
+        return subspan(size_ - count, count);
+    }
+    /**
+     * throw index_out_of_bound if the range does not fit in [0, size)
+     */
+    strided_span subspan(const size_t &offset, const size_t &count = static_cast<size_t>(-1)) const {
+        if (offset > size_) {
+            throw index_out_of_bound();
+        }
+        size_t n = count == static_cast<size_t>(-1) ? size_ - offset : count;
+        if (n > size_ - offset) {
+            throw index_out_of_bound();
+        }
+        // an empty tail keeps data_, offset * stride_ may lie past the buffer
+        return strided_span(n ? data_ + offset * stride_ : data_, n, stride_);
+    }
+
+private:
+    T *data_;
+    size_t size_;
+    std::ptrdiff_t stride_;
+};
+
+}  // namespace sjtu
+
+// spans do not own their elements: they are views, and iterators taken from
+// a temporary span stay valid
+template <typename T>
+inline constexpr bool std::ranges::enable_borrowed_range<sjtu::span<T>> = true;
+template <typename T>
+inline constexpr bool std::ranges::enable_view<sjtu::span<T>> = true;
+template <typename T>
+inline constexpr bool std::ranges::enable_borrowed_range<sjtu::strided_span<T>> = true;
+template <typename T>
+inline constexpr bool std::ranges::enable_view<sjtu::strided_span<T>> = true;
+
+#endif
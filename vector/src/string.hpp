@@ -0,0 +1,442 @@
+#ifndef SJTU_STRING_HPP
+#define SJTU_STRING_HPP
+
+#include "exceptions.hpp"
+
+#include <compare>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <ostream>
+#include <string_view>
+
+namespace sjtu {
+
+/**
+ * a byte string like std::string.
+ * strings of up to kInlineCapacity characters are stored inside the
+ * object itself, longer ones in one malloc'ed buffer that grows
+ * geometrically. the characters are always followed by a '\0', so c_str()
+ * is data().
+ * concatenating onto an rvalue reuses its buffer:
+ *   sjtu::string key = std::move(prefix) + "/" + name;  // one buffer
+ */
+class string {
+public:
+    using value_type = char;
+    using iterator = char *;
+    using const_iterator = const char *;
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    static constexpr size_t kInlineCapacity = 22;
+
+    string() {
+        set_inline(0);
+    }
+    string(const char *s) : string(s, strlen(s)) { }
+    string(const char *s, size_t n) {
+        set_inline(0);
+        assign(s, n);
+    }
+    explicit string(std::string_view s) : string(s.data(), s.size()) { }
+    string(size_t n, char c) {
+        set_inline(0);
+        resize(n, c);
+    }
+    string(const string &other) : string(other.data(), other.size()) { }
+    string(string &&other) noexcept {
+        steal(other);
+    }
+    ~string() {
+        if (on_heap()) {
+            free(rep_.heap.data);
+        }
+    }
+    string &operator=(const string &other) {
+        if (this != &other) {
+            assign(other.data(), other.size());
+        }
+        return *this;
+    }
+    string &operator=(string &&other) noexcept {
+        if (this != &other) {
+            if (on_heap()) {
+                free(rep_.heap.data);
+            }
+            steal(other);
+        }
+        return *this;
+    }
+    string &operator=(const char *s) {
+        return assign(s, strlen(s));
+    }
+    string &operator=(std::string_view s) {
+        return assign(s.data(), s.size());
+    }
+    /**
+     * replaces the contents with the n characters at s, which may point
+     * into this string.
+     */
+    string &assign(const char *s, size_t n) {
+        if (n > capacity()) {
+            char *p = allocate(n);
+            memcpy(p, s, n);
+            set_heap(p, n, n);
+        } else {
+            memmove(data(), s, n);
+        }
+        set_size(n);
+        return *this;
+    }
+
+    /**
+     * access the character at pos.
+     * throw index_out_of_bound if pos is not in [0, size)
+     */
+    char &operator[](const size_t &pos) {
+        if (pos >= size()) {
+            throw index_out_of_bound();
+        }
+        return data()[pos];
+    }
+    const char &operator[](const size_t &pos) const {
+        if (pos >= size()) {
+            throw index_out_of_bound();
+        }
+        return data()[pos];
+    }
+    char &at(const size_t &pos) {
+        return (*this)[pos];
+    }
+    const char &at(const size_t &pos) const {
+        return (*this)[pos];
+    }
+    /**
+     * throw container_is_empty if size() == 0
+     */
+    char &front() {
+        if (empty()) {
+            throw container_is_empty();
+        }
+        return data()[0];
+    }
+    char &back() {
+        if (empty()) {
+            throw container_is_empty();
+        }
+        return data()[size() - 1];
+    }
+    char *data() {
+        return on_heap() ? rep_.heap.data : rep_.chars;
+    }
+    const char *data() const {
+        return on_heap() ? rep_.heap.data : rep_.chars;
+    }
+    const char *c_str() const {
+        return data();
+    }
+    operator std::string_view() const {
+        return std::string_view(data(), size());
+    }
+    iterator begin() {
+        return data();
+    }
+    const_iterator begin() const {
+        return data();
+    }
+    iterator end() {
+        return data() + size();
+    }
+    const_iterator end() const {
+        return data() + size();
+    }
+
+    size_t size() const {
+        return on_heap() ? rep_.heap.size : tag_;
+    }
+    size_t length() const {
+        return size();
+    }
+    bool empty() const {
+        return size() == 0;
+    }
+    size_t capacity() const {
+        return on_heap() ? rep_.heap.capacity : kInlineCapacity;
+    }
+    /**
+     * makes room for n characters without reallocation.
+     */
+    void reserve(const size_t &n) {
+        if (n > capacity()) {
+            grow(n);
+        }
+    }
+    void clear() {
+        set_size(0);
+    }
+    void resize(const size_t &n, char c = '\0') {
+        size_t old = size();
+        if (n > old) {
+            reserve(n);
+            memset(data() + old, c, n - old);
+        }
+        set_size(n);
+    }
+
+    void push_back(char c) {
+        size_t n = size();
+        if (n == capacity()) {
+            grow(n * 2);
+        }
+        data()[n] = c;
+        set_size(n + 1);
+    }
+    /**
+     * throw container_is_empty if size() == 0
+     */
+    void pop_back() {
+        if (empty()) {
+            throw container_is_empty();
+        }
+        set_size(size() - 1);
+    }
+    /**
+     * appends the n characters at s, which may point into this string.
+     */
+    string &append(const char *s, size_t n) {
+        size_t old = size();
+        if (n > capacity() - old) {
+            // the new buffer is filled before the old one, which s may
+            // point into, is freed
+            size_t cap = old + n > capacity() * 2 ? old + n : capacity() * 2;
+            char *p = allocate(cap);
+            memcpy(p, data(), old);
+            memcpy(p + old, s, n);
+            set_heap(p, old, cap);
+        } else {
+            memmove(data() + old, s, n);
+        }
+        set_size(old + n);
+        return *this;
+    }
+    string &append(std::string_view s) {
+        return append(s.data(), s.size());
+    }
+    string &operator+=(std::string_view s) {
+        return append(s.data(), s.size());
+    }
+    string &operator+=(const char *s) {
+        return append(s, strlen(s));
+    }
+    string &operator+=(char c) {
+        push_back(c);
+        return *this;
+    }
+    /**
+     * inserts s before position pos, s may point into this string.
+     * throw index_out_of_bound if pos > size()
+     */
+    string &insert(const size_t &pos, std::string_view s) {
+        size_t old = size();
+        if (pos > old) {
+            throw index_out_of_bound();
+        }
+        size_t n = s.size();
+        if (n > capacity() - old) {
+            size_t cap = old + n > capacity() * 2 ? old + n : capacity() * 2;
+            char *p = allocate(cap);
+            memcpy(p, data(), pos);
+            memcpy(p + pos, s.data(), n);
+            memcpy(p + pos + n, data() + pos, old - pos);
+            set_heap(p, old, cap);
+        } else {
+            char *d = data();
+            std::less<const char *> before;
+            bool inside = !before(s.data(), d) && before(s.data(), d + old);
+            size_t from = inside ? static_cast<size_t>(s.data() - d) : 0;
+            memmove(d + pos + n, d + pos, old - pos);
+            if (!inside) {
+                memcpy(d + pos, s.data(), n);
+            } else if (from + n <= pos) {
+                memcpy(d + pos, d + from, n);
+            } else if (from >= pos) {
+                // the tail, and s with it, has moved n to the right
+                memcpy(d + pos, d + from + n, n);
+            } else {
+                size_t head = pos - from;
+                memcpy(d + pos, d + from, head);
+                memcpy(d + pos + head, d + pos + n, n - head);
+            }
+        }
+        set_size(old + n);
+        return *this;
+    }
+
+    /**
+     * the characters [pos, pos + n), cut at the end of the string.
+     * throw index_out_of_bound if pos > size()
+     */
+    string substr(const size_t &pos, const size_t &n = npos) const {
+        if (pos > size()) {
+            throw index_out_of_bound();
+        }
+        return string(std::string_view(*this).substr(pos, n));
+    }
+    /**
+     * the position of the first occurrence of s at or after pos, npos if
+     * there is none.
+     */
+    size_t find(std::string_view s, const size_t &pos = 0) const {
+        return std::string_view(*this).find(s, pos);
+    }
+    size_t find(char c, const size_t &pos = 0) const {
+        return std::string_view(*this).find(c, pos);
+    }
+    bool starts_with(std::string_view s) const {
+        return std::string_view(*this).starts_with(s);
+    }
+    bool ends_with(std::string_view s) const {
+        return std::string_view(*this).ends_with(s);
+    }
+    int compare(std::string_view s) const {
+        return std::string_view(*this).compare(s);
+    }
+
+    friend bool operator==(const string &lhs, const string &rhs) {
+        return std::string_view(lhs) == std::string_view(rhs);
+    }
+    friend bool operator==(const string &lhs, const char *rhs) {
+        return std::string_view(lhs) == std::string_view(rhs);
+    }
+    friend bool operator==(const string &lhs, std::string_view rhs) {
+        return std::string_view(lhs) == rhs;
+    }
+    friend std::strong_ordering operator<=>(const string &lhs, const string &rhs) {
+        return lhs.compare(rhs) <=> 0;
+    }
+    friend std::strong_ordering operator<=>(const string &lhs, const char *rhs) {
+        return lhs.compare(rhs) <=> 0;
+    }
+    friend std::strong_ordering operator<=>(const string &lhs, std::string_view rhs) {
+        return lhs.compare(rhs) <=> 0;
+    }
+
+    friend string operator+(const string &lhs, const string &rhs) {
+        return concat(lhs, rhs);
+    }
+    friend string operator+(string &&lhs, const string &rhs) {
+        return std::move(lhs.append(rhs));
+    }
+    friend string operator+(const string &lhs, string &&rhs) {
+        return std::move(rhs.insert(0, lhs));
+    }
+    friend string operator+(string &&lhs, string &&rhs) {
+        return std::move(lhs.append(rhs));
+    }
+    friend string operator+(const string &lhs, const char *rhs) {
+        return concat(lhs, rhs);
+    }
+    friend string operator+(string &&lhs, const char *rhs) {
+        return std::move(lhs += rhs);
+    }
+    friend string operator+(const char *lhs, const string &rhs) {
+        return concat(lhs, rhs);
+    }
+    friend string operator+(const char *lhs, string &&rhs) {
+        return std::move(rhs.insert(0, lhs));
+    }
+    friend string operator+(const string &lhs, char rhs) {
+        return concat(lhs, std::string_view(&rhs, 1));
+    }
+    friend string operator+(string &&lhs, char rhs) {
+        return std::move(lhs += rhs);
+    }
+
+    friend std::ostream &operator<<(std::ostream &os, const string &s) {
+        return os << std::string_view(s);
+    }
+
+private:
+    struct heap_rep {
+        char *data;
+        size_t size;
+        size_t capacity;
+    };
+    union {
+        heap_rep heap;
+        char chars[kInlineCapacity + 1];
+    } rep_;
+    // the length of an inline string, or kOnHeap
+    unsigned char tag_;
+
+    static constexpr unsigned char kOnHeap = 0xFF;
+
+    bool on_heap() const {
+        return tag_ == kOnHeap;
+    }
+    void set_inline(size_t n) {
+        tag_ = static_cast<unsigned char>(n);
+        rep_.chars[n] = '\0';
+    }
+    /**
+     * switches to the buffer p, freeing the old one.
+     */
+    void set_heap(char *p, size_t n, size_t cap) {
+        if (on_heap()) {
+            free(rep_.heap.data);
+        }
+        rep_.heap.data = p;
+        rep_.heap.size = n;
+        rep_.heap.capacity = cap;
+        tag_ = kOnHeap;
+    }
+    void set_size(size_t n) {
+        if (on_heap()) {
+            rep_.heap.size = n;
+            rep_.heap.data[n] = '\0';
+        } else {
+            set_inline(n);
+        }
+    }
+    void grow(size_t cap) {
+        size_t n = size();
+        char *p = allocate(cap);
+        memcpy(p, data(), n + 1);
+        set_heap(p, n, cap);
+    }
+    void steal(string &other) {
+        rep_ = other.rep_;
+        tag_ = other.tag_;
+        other.set_inline(0);
+    }
+    /**
+     * a buffer for cap characters and the '\0' behind them.
+     */
+    static char *allocate(size_t cap) {
+        char *p = static_cast<char *>(malloc(cap + 1));
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+    static string concat(std::string_view lhs, std::string_view rhs) {
+        string result;
+        result.reserve(lhs.size() + rhs.size());
+        result.append(lhs);
+        result.append(rhs);
+        return result;
+    }
+};
+
+}  // namespace sjtu
+
+template <>
+struct std::hash<sjtu::string> {
+    size_t operator()(const sjtu::string &s) const noexcept {
+        return std::hash<std::string_view>()(s);
+    }
+};
+
+#endif
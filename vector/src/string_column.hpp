@@ -0,0 +1,312 @@
+#ifndef SJTU_STRING_COLUMN_HPP
+#define SJTU_STRING_COLUMN_HPP
+
+#include "exceptions.hpp"
+#include "vector.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+namespace sjtu {
+
+/**
+ * a sequence of immutable strings packed back to back into one character
+ * buffer, string i being [offsets[i], offsets[i + 1]) of it.
+ * compared with a vector of strings there is no allocation and no pointer
+ * per string, and walking the column walks the buffer in order.
+ * sort() orders the strings bytewise and lays the buffer out again in the
+ * new order; a sorted column answers lower_bound and find by binary search.
+ */
+class string_column {
+public:
+    class const_iterator {
+    public:
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::string_view;
+        using reference = std::string_view;
+        using iterator_category = std::random_access_iterator_tag;
+
+    private:
+        const string_column *owner_;
+        size_t idx_;
+    public:
+        const_iterator() : owner_(nullptr), idx_(0) { }
+        const_iterator(const string_column *owner, size_t idx) : owner_(owner), idx_(idx) { }
+        const_iterator operator+(const difference_type &n) const {
+            return const_iterator(owner_, idx_ + n);
+        }
+        const_iterator operator-(const difference_type &n) const {
+            return const_iterator(owner_, idx_ - n);
+        }
+        friend const_iterator operator+(const difference_type &n, const const_iterator &it) {
+            return it + n;
+        }
+        difference_type operator-(const const_iterator &rhs) const {
+            if (owner_ != rhs.owner_) {
+                throw invalid_iterator();
+            }
+            return idx_ - rhs.idx_;
+        }
+        const_iterator &operator+=(const difference_type &n) {
+            idx_ += n;
+            return *this;
+        }
+        const_iterator &operator-=(const difference_type &n) {
+            idx_ -= n;
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator p = *this;
+            ++idx_;
+            return p;
+        }
+        const_iterator &operator++() {
+            ++idx_;
+            return *this;
+        }
+        const_iterator operator--(int) {
+            const_iterator p = *this;
+            --idx_;
+            return p;
+        }
+        const_iterator &operator--() {
+            --idx_;
+            return *this;
+        }
+        reference operator*() const {
+            return owner_->unchecked_at(idx_);
+        }
+        reference operator[](const difference_type &n) const {
+            return owner_->unchecked_at(idx_ + n);
+        }
+        bool operator==(const const_iterator &rhs) const {
+            return owner_ == rhs.owner_ && idx_ == rhs.idx_;
+        }
+        bool operator!=(const const_iterator &rhs) const {
+            return !(*this == rhs);
+        }
+        bool operator<(const const_iterator &rhs) const {
+            return idx_ < rhs.idx_;
+        }
+        bool operator>(const const_iterator &rhs) const {
+            return rhs < *this;
+        }
+        bool operator<=(const const_iterator &rhs) const {
+            return !(rhs < *this);
+        }
+        bool operator>=(const const_iterator &rhs) const {
+            return !(*this < rhs);
+        }
+    };
+    using iterator = const_iterator;
+
+    string_column() {
+        offsets_.push_back(0);
+    }
+
+    /**
+     * makes room for strings more strings holding chars characters in
+     * total without reallocation.
+     */
+    void reserve(const size_t &strings, const size_t &chars) {
+        offsets_.reserve(offsets_.size() + strings);
+        chars_.reserve(chars_.size() + chars);
+    }
+    /**
+     * appends s, which may be a string of this column.
+     */
+    void push_back(std::string_view s) {
+        // as an offset, s is found again in the buffer after reallocation
+        size_t from = reinterpret_cast<uintptr_t>(s.data()) - reinterpret_cast<uintptr_t>(chars_.data());
+        if (!s.empty() && from < chars_.size()) {
+            size_t need = chars_.size() + s.size();
+            if (need > chars_.capacity()) {
+                chars_.reserve(need > chars_.capacity() * 2 ? need : chars_.capacity() * 2);
+            }
+            s = std::string_view(chars_.data() + from, s.size());
+        }
+        chars_.append_range(s);
+        offsets_.push_back(chars_.size());
+    }
+    /**
+     * removes the last string.
+     * throw container_is_empty if size() == 0
+     */
+    void pop_back() {
+        if (empty()) {
+            throw container_is_empty();
+        }
+        offsets_.pop_back();
+        chars_.resize_uninitialized(offsets_.back());
+    }
+    void clear() {
+        chars_.clear();
+        offsets_.clear();
+        offsets_.push_back(0);
+    }
+
+    /**
+     * a view of string pos, valid until the column is modified.
+     * throw index_out_of_bound if pos is not in [0, size)
+     */
+    std::string_view operator[](const size_t &pos) const {
+        if (pos >= size()) {
+            throw index_out_of_bound();
+        }
+        return unchecked_at(pos);
+    }
+    std::string_view at(const size_t &pos) const {
+        return (*this)[pos];
+    }
+    const_iterator begin() const {
+        return const_iterator(this, 0);
+    }
+    const_iterator end() const {
+        return const_iterator(this, size());
+    }
+
+    size_t size() const {
+        return offsets_.size() - 1;
+    }
+    bool empty() const {
+        return size() == 0;
+    }
+    /**
+     * the number of characters of all strings together.
+     */
+    size_t total_chars() const {
+        return chars_.size();
+    }
+    const vector<char> &chars() const {
+        return chars_;
+    }
+    /**
+     * size() + 1 offsets into chars(), the last one is total_chars().
+     */
+    const vector<size_t> &offsets() const {
+        return offsets_;
+    }
+
+    /**
+     * sorts the strings bytewise (as std::string_view compares them).
+     * the bytes every string starts with are skipped, the strings are
+     * ordered by their next sixteen bytes, which decides most comparisons
+     * of short keys without touching the buffer, and the buffer is rebuilt
+     * in sorted order.
+     */
+    void sort() {
+        size_t n = size();
+        size_t skip = common_prefix_length();
+        vector<sort_key> keys;
+        keys.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            sort_key k;
+            k.high = prefix_of(unchecked_at(i), skip);
+            k.low = prefix_of(unchecked_at(i), skip + 8);
+            k.length = offsets_.data()[i + 1] - offsets_.data()[i];
+            k.index = i;
+            keys.push_back(k);
+        }
+        std::sort(keys.data(), keys.data() + n, [this, skip](const sort_key &a, const sort_key &b) {
+            if (a.high != b.high) {
+                return a.high < b.high;
+            }
+            if (a.low != b.low) {
+                return a.low < b.low;
+            }
+            // with equal prefixes a string ending inside them is a prefix of
+            // the other one (which may have been padded with zeros)
+            if (a.length <= skip + 16 || b.length <= skip + 16) {
+                return a.length < b.length;
+            }
+            return unchecked_at(a.index).substr(skip + 16) < unchecked_at(b.index).substr(skip + 16);
+        });
+        vector<char> chars;
+        chars.reserve(chars_.size());
+        vector<size_t> offsets;
+        offsets.reserve(n + 1);
+        offsets.push_back(0);
+        for (size_t i = 0; i < n; i++) {
+            chars.append_range(unchecked_at(keys.data()[i].index));
+            offsets.push_back(chars.size());
+        }
+        chars_.swap(chars);
+        offsets_.swap(offsets);
+    }
+    bool is_sorted() const {
+        for (size_t i = 1; i < size(); i++) {
+            if (unchecked_at(i) < unchecked_at(i - 1)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    /**
+     * the index of the first string not less than key, in a sorted column.
+     */
+    size_t lower_bound(std::string_view key) const {
+        return std::lower_bound(begin(), end(), key) - begin();
+    }
+    /**
+     * the index of a string equal to key in a sorted column, size() if
+     * there is none.
+     */
+    size_t find(std::string_view key) const {
+        size_t i = lower_bound(key);
+        return i < size() && unchecked_at(i) == key ? i : size();
+    }
+
+private:
+    vector<char> chars_;
+    vector<size_t> offsets_;
+
+    struct sort_key {
+        // bytes [skip, skip + 16) of the string
+        unsigned long long high;
+        unsigned long long low;
+        size_t length;
+        size_t index;
+    };
+
+    std::string_view unchecked_at(size_t pos) const {
+        const size_t *off = offsets_.data();
+        return std::string_view(chars_.data() + off[pos], off[pos + 1] - off[pos]);
+    }
+    /**
+     * the length of the longest prefix all strings share.
+     */
+    size_t common_prefix_length() const {
+        if (empty()) {
+            return 0;
+        }
+        std::string_view first = unchecked_at(0);
+        size_t len = first.size();
+        for (size_t i = 1; i < size() && len > 0; i++) {
+            std::string_view s = unchecked_at(i);
+            size_t j = 0;
+            while (j < len && j < s.size() && s[j] == first[j]) {
+                j++;
+            }
+            len = j;
+        }
+        return len;
+    }
+    /**
+     * bytes [skip, skip + 8) of s as a big-endian number, bytes past the
+     * end of s count as zero, so comparing prefixes compares strings.
+     */
+    static unsigned long long prefix_of(std::string_view s, size_t skip) {
+        unsigned long long p = 0;
+        for (size_t i = skip; i < skip + 8; i++) {
+            p = p << 8 | (i < s.size() ? static_cast<unsigned char>(s[i]) : 0);
+        }
+        return p;
+    }
+};
+
+}  // namespace sjtu
+
+#endif
@@ -0,0 +1,457 @@
+#ifndef SJTU_UINT_FIXED_HPP
+#define SJTU_UINT_FIXED_HPP
+
+#include "exceptions.hpp"
+
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+/**
+ * asks for the next loop to be unrolled completely, the loops over the
+ * limbs of a uint_fixed have a trip count known at compile time.
+ */
+#if defined(__GNUC__)
+#define SJTU_UNROLL _Pragma("GCC unroll 16")
+#else
+#define SJTU_UNROLL
+#endif
+
+namespace sjtu {
+namespace detail {
+
+/**
+ * a + b + carry, carry (0 or 1) becomes the carry out.
+ */
+constexpr unsigned long long add_with_carry(unsigned long long a, unsigned long long b, unsigned long long &carry) {
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 s = static_cast<unsigned __int128>(a) + b + carry;
+    carry = static_cast<unsigned long long>(s >> 64);
+    return static_cast<unsigned long long>(s);
+#else
+    unsigned long long s = a + b;
+    unsigned long long r = s + carry;
+    carry = (s < a) | (r < s);
+    return r;
+#endif
+}
+/**
+ * a - b - borrow, borrow (0 or 1) becomes the borrow out.
+ */
+constexpr unsigned long long sub_with_borrow(unsigned long long a, unsigned long long b, unsigned long long &borrow) {
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 d = static_cast<unsigned __int128>(a) - b - borrow;
+    borrow = static_cast<unsigned long long>(d >> 64) & 1;
+    return static_cast<unsigned long long>(d);
+#else
+    unsigned long long d = a - b;
+    unsigned long long r = d - borrow;
+    borrow = (a < b) | (d < borrow);
+    return r;
+#endif
+}
+/**
+ * a * b + c + d, which always fits in 128 bits: returns the low half and
+ * stores the high half in hi.
+ */
+constexpr unsigned long long mul_add(unsigned long long a, unsigned long long b, unsigned long long c,
+                                     unsigned long long d, unsigned long long &hi) {
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 p = static_cast<unsigned __int128>(a) * b + c + d;
+    hi = static_cast<unsigned long long>(p >> 64);
+    return static_cast<unsigned long long>(p);
+#else
+    const unsigned long long mask = 0xFFFFFFFFULL;
+    unsigned long long al = a & mask, ah = a >> 32, bl = b & mask, bh = b >> 32;
+    unsigned long long ll = al * bl, lh = al * bh, hl = ah * bl, hh = ah * bh;
+    unsigned long long mid = (ll >> 32) + (lh & mask) + (hl & mask);
+    unsigned long long lo = (mid << 32) | (ll & mask);
+    hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+    unsigned long long carry = 0;
+    lo = add_with_carry(lo, c, carry);
+    hi += carry;
+    carry = 0;
+    lo = add_with_carry(lo, d, carry);
+    hi += carry;
+    return lo;
+#endif
+}
+/**
+ * (hi * 2^64 + lo) / d with hi < d, the remainder goes to rem.
+ */
+constexpr unsigned long long div_wide(unsigned long long hi, unsigned long long lo, unsigned long long d,
+                                      unsigned long long &rem) {
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 n = (static_cast<unsigned __int128>(hi) << 64) | lo;
+    rem = static_cast<unsigned long long>(n % d);
+    return static_cast<unsigned long long>(n / d);
+#else
+    // one bit at a time, hi stays below d
+    unsigned long long q = 0;
+    for (int i = 63; i >= 0; i--) {
+        bool top = hi >> 63;
+        hi = (hi << 1) | ((lo >> i) & 1);
+        q <<= 1;
+        if (top || hi >= d) {
+            hi -= d;
+            q |= 1;
+        }
+    }
+    rem = hi;
+    return q;
+#endif
+}
+
+}  // namespace detail
+
+/**
+ * an unsigned integer of exactly Bits bits (a multiple of 64) with the
+ * arithmetic of the built-in unsigned types: everything is modulo
+ * 2^Bits and nothing is ever allocated. the value lives in Bits / 64
+ * limbs of 64 bits, least significant first; every operation is constexpr
+ * and loops over a number of limbs known at compile time, so the compiler
+ * unrolls it into straight-line code with 128-bit carries.
+ *   sjtu::uint256 x = sjtu::uint256::parse("340282366920938463463374607431768211456");
+ *   x = x * x + 1;
+ * Util::Bint converts to and from it, see class-bint.hpp.
+ */
+template <size_t Bits>
+class uint_fixed {
+    static_assert(Bits > 0 && Bits % 64 == 0, "uint_fixed is made of 64-bit limbs");
+
+public:
+    static constexpr size_t kBits = Bits;
+    static constexpr size_t kLimbs = Bits / 64;
+
+    constexpr uint_fixed() : limbs_{} { }
+    constexpr uint_fixed(unsigned long long value) : limbs_{} {
+        limbs_[0] = value;
+    }
+    /**
+     * zero-extends or truncates an integer of another width.
+     */
+    template <size_t Other>
+    constexpr explicit uint_fixed(const uint_fixed<Other> &other) : limbs_{} {
+        constexpr size_t n = kLimbs < uint_fixed<Other>::kLimbs ? kLimbs : uint_fixed<Other>::kLimbs;
+        SJTU_UNROLL
+        for (size_t i = 0; i < n; i++) {
+            limbs_[i] = other.limbs_[i];
+        }
+    }
+    /**
+     * the value of the n limbs at p, least significant first.
+     * throw runtime_error if it does not fit
+     */
+    static constexpr uint_fixed from_limbs(const unsigned long long *p, size_t n) {
+        uint_fixed x;
+        for (size_t i = 0; i < n; i++) {
+            if (i < kLimbs) {
+                x.limbs_[i] = p[i];
+            } else if (p[i] != 0) {
+                throw runtime_error();
+            }
+        }
+        return x;
+    }
+    /**
+     * reads a decimal number.
+     * throw runtime_error if s is empty, has a character other than a
+     * digit or does not fit
+     */
+    static constexpr uint_fixed parse(std::string_view s) {
+        if (s.empty()) {
+            throw runtime_error();
+        }
+        uint_fixed x;
+        for (char c : s) {
+            if (c < '0' || c > '9') {
+                throw runtime_error();
+            }
+            if (x.mul_add_small(10, static_cast<unsigned long long>(c - '0')) != 0) {
+                throw runtime_error();
+            }
+        }
+        return x;
+    }
+    /**
+     * 2^Bits - 1.
+     */
+    static constexpr uint_fixed max() {
+        return ~uint_fixed();
+    }
+
+    constexpr unsigned long long limb(const size_t &i) const {
+        return limbs_[i];
+    }
+    constexpr const unsigned long long *limbs() const {
+        return limbs_;
+    }
+    constexpr explicit operator bool() const {
+        SJTU_UNROLL
+        for (size_t i = 0; i < kLimbs; i++) {
+            if (limbs_[i] != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+    /**
+     * the low 64 bits.
+     */
+    constexpr explicit operator unsigned long long() const {
+        return limbs_[0];
+    }
+    /**
+     * the number of bits needed to write the value, 0 for zero.
+     */
+    constexpr size_t bit_width() const {
+        for (size_t i = kLimbs; i-- > 0;) {
+            if (limbs_[i] != 0) {
+                return i * 64 + std::bit_width(limbs_[i]);
+            }
+        }
+        return 0;
+    }
+
+    constexpr uint_fixed &operator+=(const uint_fixed &rhs) {
+        unsigned long long carry = 0;
+        SJTU_UNROLL
+        for (size_t i = 0; i < kLimbs; i++) {
+            limbs_[i] = detail::add_with_carry(limbs_[i], rhs.limbs_[i], carry);
+        }
+        return *this;
+    }
+    constexpr uint_fixed &operator-=(const uint_fixed &rhs) {
+        unsigned long long borrow = 0;
+        SJTU_UNROLL
+        for (size_t i = 0; i < kLimbs; i++) {
+            limbs_[i] = detail::sub_with_borrow(limbs_[i], rhs.limbs_[i], borrow);
+        }
+        return *this;
+    }
+    /**
+     * the low Bits bits of the product.
+     */
+    constexpr uint_fixed &operator*=(const uint_fixed &rhs) {
+        *this = *this * rhs;
+        return *this;
+    }
+    friend constexpr uint_fixed operator+(uint_fixed lhs, const uint_fixed &rhs) {
+        return lhs += rhs;
+    }
+    friend constexpr uint_fixed operator-(uint_fixed lhs, const uint_fixed &rhs) {
+        return lhs -= rhs;
+    }
+    friend constexpr uint_fixed operator*(const uint_fixed &lhs, const uint_fixed &rhs) {
+        uint_fixed r;
+        SJTU_UNROLL
+        for (size_t i = 0; i < kLimbs; i++) {
+            unsigned long long carry = 0;
+            SJTU_UNROLL
+            for (size_t j = 0; i + j < kLimbs; j++) {
+                r.limbs_[i + j] = detail::mul_add(lhs.limbs_[i], rhs.limbs_[j], r.limbs_[i + j], carry, carry);
+            }
+        }
+        return r;
+    }
+    /**
+     * the whole product, Bits + Other bits wide.
+     */
+    template <size_t Other>
+    constexpr uint_fixed<Bits + Other> mul_full(const uint_fixed<Other> &rhs) const {
+        uint_fixed<Bits + Other> r;
+        SJTU_UNROLL
+        for (size_t i = 0; i < kLimbs; i++) {
+            unsigned long long carry = 0;
+            SJTU_UNROLL
+            for (size_t j = 0; j < uint_fixed<Other>::kLimbs; j++) {
+                r.limbs_[i + j] = detail::mul_add(limbs_[i], rhs.limbs_[j], r.limbs_[i + j], carry, carry);
+            }
+            r.limbs_[i + uint_fixed<Other>::kLimbs] = carry;
+        }
+        return r;
+    }
+    /**
+     * divides by d in place and returns the remainder.
+     * throw runtime_error if d is zero
+     */
+    constexpr unsigned long long divmod(unsigned long long d) {
+        if (d == 0) {
+            throw runtime_error();
+        }
+        unsigned long long rem = 0;
+        SJTU_UNROLL
+        for (size_t j = 0; j < kLimbs; j++) {
+            size_t i = kLimbs - 1 - j;
+            limbs_[i] = detail::div_wide(rem, limbs_[i], d, rem);
+        }
+        return rem;
+    }
+    friend constexpr uint_fixed operator/(uint_fixed lhs, unsigned long long d) {
+        lhs.divmod(d);
+        return lhs;
+    }
+    friend constexpr unsigned long long operator%(uint_fixed lhs, unsigned long long d) {
+        return lhs.divmod(d);
+    }
+
+    constexpr uint_fixed operator-() const {
+        return uint_fixed() - *this;
+    }
+    constexpr uint_fixed operator~() const {
+        uint_fixed r;
+        SJTU_UNROLL
+        for (size_t i = 0; i < kLimbs; i++) {
+            r.limbs_[i] = ~limbs_[i];
+        }
+        return r;
+    }
+    constexpr uint_fixed &operator++() {
+        return *this += 1;
+    }
+    constexpr uint_fixed operator++(int) {
+        uint_fixed p = *this;
+        *this += 1;
+        return p;
+    }
+    constexpr uint_fixed &operator--() {
+        return *this -= 1;
+    }
+    constexpr uint_fixed operator--(int) {
+        uint_fixed p = *this;
+        *this -= 1;
+        return p;
+    }
+    constexpr uint_fixed &operator&=(const uint_fixed &rhs) {
+        SJTU_UNROLL
+        for (size_t i = 0; i < kLimbs; i++) {
+            limbs_[i] &= rhs.limbs_[i];
+        }
+        return *this;
+    }
+    constexpr uint_fixed &operator|=(const uint_fixed &rhs) {
+        SJTU_UNROLL
+        for (size_t i = 0; i < kLimbs; i++) {
+            limbs_[i] |= rhs.limbs_[i];
+        }
+        return *this;
+    }
+    constexpr uint_fixed &operator^=(const uint_fixed &rhs) {
+        SJTU_UNROLL
+        for (size_t i = 0; i < kLimbs; i++) {
+            limbs_[i] ^= rhs.limbs_[i];
+        }
+        return *this;
+    }
+    friend constexpr uint_fixed operator&(uint_fixed lhs, const uint_fixed &rhs) {
+        return lhs &= rhs;
+    }
+    friend constexpr uint_fixed operator|(uint_fixed lhs, const uint_fixed &rhs) {
+        return lhs |= rhs;
+    }
+    friend constexpr uint_fixed operator^(uint_fixed lhs, const uint_fixed &rhs) {
+        return lhs ^= rhs;
+    }
+    /**
+     * shifts by s bits, everything is shifted out once s >= Bits.
+     */
+    constexpr uint_fixed operator<<(size_t s) const {
+        uint_fixed r;
+        size_t limbs = s / 64, bits = s % 64;
+        for (size_t i = kLimbs; i-- > limbs;) {
+            r.limbs_[i] = limbs_[i - limbs] << bits;
+            if (bits != 0 && i > limbs) {
+                r.limbs_[i] |= limbs_[i - limbs - 1] >> (64 - bits);
+            }
+        }
+        return r;
+    }
+    constexpr uint_fixed operator>>(size_t s) const {
+        uint_fixed r;
+        size_t limbs = s / 64, bits = s % 64;
+        for (size_t i = 0; i + limbs < kLimbs; i++) {
+            r.limbs_[i] = limbs_[i + limbs] >> bits;
+            if (bits != 0 && i + limbs + 1 < kLimbs) {
+                r.limbs_[i] |= limbs_[i + limbs + 1] << (64 - bits);
+            }
+        }
+        return r;
+    }
+    constexpr uint_fixed &operator<<=(size_t s) {
+        return *this = *this << s;
+    }
+    constexpr uint_fixed &operator>>=(size_t s) {
+        return *this = *this >> s;
+    }
+
+    friend constexpr bool operator==(const uint_fixed &lhs, const uint_fixed &rhs) {
+        SJTU_UNROLL
+        for (size_t i = 0; i < kLimbs; i++) {
+            if (lhs.limbs_[i] != rhs.limbs_[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+    friend constexpr std::strong_ordering operator<=>(const uint_fixed &lhs, const uint_fixed &rhs) {
+        SJTU_UNROLL
+        for (size_t j = 0; j < kLimbs; j++) {
+            size_t i = kLimbs - 1 - j;
+            if (lhs.limbs_[i] != rhs.limbs_[i]) {
+                return lhs.limbs_[i] <=> rhs.limbs_[i];
+            }
+        }
+        return std::strong_ordering::equal;
+    }
+
+    /**
+     * the decimal digits, nineteen at a time.
+     */
+    std::string to_string() const {
+        static constexpr unsigned long long kChunk = 10000000000000000000ULL;
+        uint_fixed x = *this;
+        std::string s;
+        do {
+            unsigned long long chunk = x.divmod(kChunk);
+            for (int i = 0; i < 19 && (chunk != 0 || static_cast<bool>(x)); i++) {
+                s.push_back(static_cast<char>('0' + chunk % 10));
+                chunk /= 10;
+            }
+        } while (static_cast<bool>(x));
+        if (s.empty()) {
+            s.push_back('0');
+        }
+        return std::string(s.rbegin(), s.rend());
+    }
+    friend std::ostream &operator<<(std::ostream &os, const uint_fixed &x) {
+        return os << x.to_string();
+    }
+
+private:
+    unsigned long long limbs_[kLimbs];
+    template <size_t>
+    friend class uint_fixed;
+
+    /**
+     * *this = *this * m + a, returns what overflows.
+     */
+    constexpr unsigned long long mul_add_small(unsigned long long m, unsigned long long a) {
+        unsigned long long carry = a;
+        SJTU_UNROLL
+        for (size_t i = 0; i < kLimbs; i++) {
+            limbs_[i] = detail::mul_add(limbs_[i], m, carry, 0, carry);
+        }
+        return carry;
+    }
+};
+
+using uint128 = uint_fixed<128>;
+using uint256 = uint_fixed<256>;
+using uint512 = uint_fixed<512>;
+
+}  // namespace sjtu
+
+#endif
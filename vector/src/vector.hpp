@@ -2,9 +2,29 @@
 #define SJTU_VECTOR_HPP
 
 #include "exceptions.hpp"
+#include "ranges.hpp"
 
+#include <array>
 #include <climits>
 #include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+/**
+ * checked iterators are on in debug builds and off when NDEBUG is defined,
+ * define SJTU_CHECKED_ITERATORS to 1 or 0 to choose explicitly.
+ */
+#ifndef SJTU_CHECKED_ITERATORS
+#ifdef NDEBUG
+#define SJTU_CHECKED_ITERATORS 0
+#else
+#define SJTU_CHECKED_ITERATORS 1
+#endif
+#endif
 
 namespace sjtu {
 /**
@@ -14,15 +34,22 @@ namespace sjtu {
 template<typename T>
 class vector {
 public:
+    using value_type = T;
+
+#if SJTU_CHECKED_ITERATORS
     /**
      * a type for actions of the elements of a vector, and you should write
      *   a class named const_iterator with same interfaces.
+     * in the checked mode an iterator remembers its vector and the vector's
+     * generation when it was made; using it after the vector reallocated,
+     * inserted, erased or was cleared, dereferencing it outside [0, size),
+     * or mixing iterators of two vectors throws invalid_iterator.
      */
     /**
      * you can see RandomAccessIterator at CppReference for help.
      */
-    class const_iterator;
-    class iterator {
+    template <bool Const>
+    class checked_iterator {
     // The following code is written for the C++ type_traits library.
     // Type traits is a C++ feature for describing certain properties of a type.
     // For instance, for an iterator, iterator::value_type is the type that the
@@ -37,239 +64,262 @@ public:
     public:
         using difference_type = std::ptrdiff_t;
         using value_type = T;
-        using pointer = T*;
-        using reference = T&;
-        using iterator_category = std::output_iterator_tag;
+        using pointer = std::conditional_t<Const, const T*, T*>;
+        using reference = std::conditional_t<Const, const T&, T&>;
+        using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept = std::contiguous_iterator_tag;
 
     private:
+        const vector *owner_;
         pointer ptr_;
-        int idx_;
-        friend class const_iterator;
-    public:
-        iterator() : ptr_(nullptr), idx_(0) { }
-        iterator(pointer ptr, int idx) : ptr_(ptr), idx_(idx) { }
-        
-        /**
-         * return a new iterator which pointer n-next elements
-         * as well as operator-
-         */
-        iterator operator+(const int &n) const {
-            iterator p = *this;
-            p.idx_ += n;
-            return p;
-        }
-        iterator operator-(const int &n) const {
-            iterator p = *this;
-            p.idx_ += n;
-            return p;
-        }
-        // return the distance between two iterators,
-        // if these two iterators point to different vectors, throw invaild_iterator.
-        int operator-(const iterator &rhs) const {
-            if (ptr_ != rhs.ptr_) {
+        unsigned long long generation_;
+        friend class vector;
+        friend class checked_iterator<!Const>;
+
+        constexpr checked_iterator(const vector *owner, pointer ptr)
+            : owner_(owner), ptr_(ptr), generation_(owner->generation_) { }
+        constexpr void check() const {
+            if (owner_ == nullptr || generation_ != owner_->generation_) {
                 throw invalid_iterator();
             }
-            return idx_ - rhs.idx_;
-        }
-        iterator& operator+=(const int &n) {
-            idx_ += n;
-            return *this;
-        }
-        iterator& operator-=(const int &n) {
-            idx_ -= n;
-            return *this;
-        }
-        /**
-         * iter++
-         */
-        iterator operator++(int) {
-            iterator p = *this;
-            idx_++;
-            return p;
-        }
-        /**
-         * ++iter
-         */
-        iterator& operator++() {
-            idx_++;
-            return *this;
-        }
-        /**
-         * iter--
-         */
-        iterator operator--(int) {
-            iterator p = *this;
-            idx_--;
-            return p;
-        }
-        /**
-         * --iter
-         */
-        iterator& operator--() {
-            idx_--;
-            return *this;
-        }
-        /**
-         * *it
-         */
-        T& operator*() const {
-            return ptr_[idx_];
-        }
-        /**
-         * a operator to check whether two iterators are same (pointing to the same memory address).
-         */
-        bool operator==(const iterator &rhs) const {
-            return ptr_ == rhs.ptr_ && idx_ == rhs.idx_;
         }
-        bool operator==(const const_iterator &rhs) const {
-            return ptr_ == rhs.ptr_ && idx_ == rhs.idx_;
+        constexpr void check_same(const checked_iterator &rhs) const {
+            // value-initialized iterators compare like null pointers
+            if (owner_ == nullptr && rhs.owner_ == nullptr) {
+                return;
+            }
+            check();
+            rhs.check();
+            if (owner_ != rhs.owner_) {
+                throw invalid_iterator();
+            }
         }
+    public:
+        constexpr checked_iterator() : owner_(nullptr), ptr_(nullptr), generation_(0) { }
         /**
-         * some other operator for iterator.
+         * an iterator converts to a const_iterator.
          */
-        bool operator!=(const iterator &rhs) const {
-            return !((*this) == rhs);
-        }
-        bool operator!=(const const_iterator &rhs) const {
-            return !((*this) == rhs);
-        }
-    };
-    /**
-     * has same function as iterator, just for a const object.
-     */
-    class const_iterator {
-    public:
-        using difference_type = std::ptrdiff_t;
-        using value_type = const T;
-        using pointer = const T*;
-        using reference = const T&;
-        using iterator_category = std::output_iterator_tag;
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        constexpr checked_iterator(const checked_iterator<false> &it)
+            : owner_(it.owner_), ptr_(it.ptr_), generation_(it.generation_) { }
 
-    private:
-        const pointer ptr_;
-        int idx_;
-        friend class iterator;
-    public:
-        const_iterator() : ptr_(nullptr), idx_(0) { }
-        const_iterator(const pointer ptr, int idx) : ptr_(ptr), idx_(idx) { }
         /**
          * return a new iterator which pointer n-next elements
          * as well as operator-
          */
-        const_iterator operator+(const int &n) const {
-            const_iterator p = *this;
-            p.idx_ += n;
+        constexpr checked_iterator operator+(const difference_type &n) const {
+            check();
+            checked_iterator p = *this;
+            p.ptr_ += n;
             return p;
         }
-        const_iterator operator-(const int &n) const {
-            const_iterator p = *this;
-            p.idx_ += n;
+        constexpr checked_iterator operator-(const difference_type &n) const {
+            check();
+            checked_iterator p = *this;
+            p.ptr_ -= n;
             return p;
         }
+        friend constexpr checked_iterator operator+(const difference_type &n, const checked_iterator &it) {
+            return it + n;
+        }
         // return the distance between two iterators,
         // if these two iterators point to different vectors, throw invaild_iterator.
-        int operator-(const const_iterator &rhs) const {
-            if (ptr_ != rhs.ptr_) {
-                throw invalid_iterator();
-            }
-            return idx_ - rhs.idx_;
+        constexpr difference_type operator-(const checked_iterator &rhs) const {
+            check_same(rhs);
+            return ptr_ - rhs.ptr_;
         }
-        const_iterator& operator+=(const int &n) {
-            idx_ += n;
+        constexpr checked_iterator& operator+=(const difference_type &n) {
+            check();
+            ptr_ += n;
             return *this;
         }
-        const_iterator& operator-=(const int &n) {
-            idx_ -= n;
+        constexpr checked_iterator& operator-=(const difference_type &n) {
+            check();
+            ptr_ -= n;
             return *this;
         }
         /**
          * iter++
          */
-        const_iterator operator++(int) {
-            const_iterator p = *this;
-            idx_++;
+        constexpr checked_iterator operator++(int) {
+            checked_iterator p = *this;
+            *this += 1;
             return p;
         }
         /**
          * ++iter
          */
-        const_iterator& operator++() {
-            idx_++;
-            return *this;
+        constexpr checked_iterator& operator++() {
+            return *this += 1;
         }
         /**
          * iter--
          */
-        const_iterator operator--(int) {
-            const_iterator p = *this;
-            idx_--;
+        constexpr checked_iterator operator--(int) {
+            checked_iterator p = *this;
+            *this -= 1;
             return p;
         }
         /**
          * --iter
          */
-        const_iterator& operator--() {
-            idx_--;
-            return *this;
+        constexpr checked_iterator& operator--() {
+            return *this -= 1;
         }
         /**
          * *it
          */
-        const T& operator*() const {
-            return ptr_[idx_];
+        constexpr reference operator*() const {
+            check();
+            if (ptr_ < owner_->data_ || ptr_ >= owner_->data_ + owner_->size_) {
+                throw invalid_iterator();
+            }
+            return *ptr_;
         }
         /**
-         * a operator to check whether two iterators are same (pointing to the same memory address).
+         * only checks that the iterator is not stale, std::to_address uses
+         * it on end() too.
          */
-        bool operator==(const iterator &rhs) const {
-            return ptr_ == rhs.ptr_ && idx_ == rhs.idx_;
+        constexpr pointer operator->() const {
+            check();
+            return ptr_;
+        }
+        constexpr reference operator[](const difference_type &n) const {
+            return *(*this + n);
         }
-        bool operator==(const const_iterator &rhs) const {
-            return ptr_ == rhs.ptr_ && idx_ == rhs.idx_;
+        /**
+         * a operator to check whether two iterators are same (pointing to the same memory address).
+         * iterators of different vectors are never equal.
+         */
+        constexpr bool operator==(const checked_iterator &rhs) const {
+            if (owner_ != rhs.owner_) {
+                return false;
+            }
+            check_same(rhs);
+            return ptr_ == rhs.ptr_;
         }
         /**
          * some other operator for iterator.
          */
-        bool operator!=(const iterator &rhs) const {
+        constexpr bool operator!=(const checked_iterator &rhs) const {
             return !((*this) == rhs);
         }
-        bool operator!=(const const_iterator &rhs) const {
-            return !((*this) == rhs);
+        constexpr bool operator<(const checked_iterator &rhs) const {
+            check_same(rhs);
+            return ptr_ < rhs.ptr_;
+        }
+        constexpr bool operator>(const checked_iterator &rhs) const {
+            return rhs < *this;
+        }
+        constexpr bool operator<=(const checked_iterator &rhs) const {
+            return !(rhs < *this);
+        }
+        constexpr bool operator>=(const checked_iterator &rhs) const {
+            return !(*this < rhs);
         }
     };
+    using iterator = checked_iterator<false>;
+    /**
+     * has same function as iterator, just for a const object.
+     */
+    using const_iterator = checked_iterator<true>;
+#else
+    /**
+     * without SJTU_CHECKED_ITERATORS the iterators are plain pointers
+     * into the successive storage.
+     */
+    using iterator = T*;
+    using const_iterator = const T*;
+#endif
     /**
      * TODO Constructs
      * At least two: default constructor, copy constructor
      */
-    vector() { }
-    vector(const vector &other) {
-        *this = other;
+    constexpr vector() { }
+    /**
+     * constructs from the elements of rg, with a single allocation unless
+     * rg is a single-pass range of unknown size.
+     */
+    template <detail::container_compatible_range<T> R>
+    constexpr vector(from_range_t, R &&rg) {
+        // the destructor does not run if the constructor throws
+        try {
+            append_range(std::forward<R>(rg));
+        } catch (...) {
+            for (size_t i = 0; i < size_; i++) {
+                data_[i].~T();
+            }
+            deallocate(data_, capacity_);
+            throw;
+        }
+    }
+    constexpr vector(const vector &other) {
+        if (other.size_ == 0) {
+            return;
+        }
+        data_ = allocate(other.size_);
+        capacity_ = other.size_;
+        try {
+            copy_construct(data_, other.data_, other.size_);
+        } catch (...) {
+            deallocate(data_, capacity_);
+            throw;
+        }
+        size_ = other.size_;
     }
     /**
      * TODO Destructor
      */
-    ~vector() {
+    constexpr ~vector() {
         for (size_t i = 0; i < size_; i++) {
             data_[i].~T();
         }
-        free(data_);
+        deallocate(data_, capacity_);
     }
     /**
      * TODO Assignment operator
+     * the existing buffer is reused when it is large enough: elements both
+     * vectors have are assigned, the rest are constructed or destroyed.
+     * trivially copyable elements are copied as raw bytes.
      */
-    vector &operator=(const vector &other) {
+    constexpr vector &operator=(const vector &other) {
         if (this == &other) {
             return *this;
         }
-        for (size_t i = 0; i < size_; i++) {
-            data_[i].~T();
+        invalidate_iterators();
+        if (other.size_ > capacity_) {
+            T* new_data = allocate(other.size_);
+            try {
+                copy_construct(new_data, other.data_, other.size_);
+            } catch (...) {
+                deallocate(new_data, other.size_);
+                throw;
+            }
+            for (size_t i = 0; i < size_; i++) {
+                data_[i].~T();
+            }
+            deallocate(data_, capacity_);
+            data_ = new_data;
+            size_ = capacity_ = other.size_;
+            return *this;
         }
-        free(data_);
-        size_ = other.size_;
-        capacity_ = other.capacity_;
-        data_ = reinterpret_cast<T*>(malloc(capacity_ * sizeof(T)));
-        for (size_t i = 0; i < size_; i++) {
-            new (data_ + i) T(other.data_[i]);
+        if (std::is_trivially_copyable_v<T> && !std::is_constant_evaluated()) {
+            if (other.size_) {
+                memcpy(static_cast<void *>(data_), other.data_, other.size_ * sizeof(T));
+            }
+            size_ = other.size_;
+        } else {
+            size_t common = size_ < other.size_ ? size_ : other.size_;
+            for (size_t i = 0; i < common; i++) {
+                data_[i] = other.data_[i];
+            }
+            for (size_t i = other.size_; i < size_; i++) {
+                data_[i].~T();
+            }
+            size_ = common;
+            for (; size_ < other.size_; size_++) {
+                std::construct_at(data_ + size_, other.data_[size_]);
+            }
         }
         return *this;
     }
@@ -277,13 +327,13 @@ public:
      * assigns specified element with bounds checking
      * throw index_out_of_bound if pos is not in [0, size)
      */
-    T & at(const size_t &pos) {
+    constexpr T & at(const size_t &pos) {
         if (pos >= size_) {
             throw index_out_of_bound();
         }
         return data_[pos];
     }
-    const T & at(const size_t &pos) const {
+    constexpr const T & at(const size_t &pos) const {
         if (pos >= size_) {
             throw index_out_of_bound();
         }
@@ -295,13 +345,13 @@ public:
      * !!! Pay attentions
      *   In STL this operator does not check the boundary but I want you to do.
      */
-    T & operator[](const size_t &pos) {
+    constexpr T & operator[](const size_t &pos) {
         if (pos >= size_) {
             throw index_out_of_bound();
         }
         return data_[pos];
     }
-    const T & operator[](const size_t &pos) const {
+    constexpr const T & operator[](const size_t &pos) const {
         if (pos >= size_) {
             throw index_out_of_bound();
         }
@@ -311,7 +361,7 @@ public:
      * access the first element.
      * throw container_is_empty if size == 0
      */
-    const T & front() const {
+    constexpr const T & front() const {
         if (size_ == 0) {
             throw container_is_empty();
         }
@@ -321,7 +371,7 @@ public:
      * access the last element.
      * throw container_is_empty if size == 0
      */
-    const T & back() const {
+    constexpr const T & back() const {
         if (size_ == 0) {
             throw container_is_empty();
         }
@@ -330,46 +380,57 @@ public:
     /**
      * returns an iterator to the beginning.
      */
-    iterator begin() {
-        return iterator(data_, 0);
+    constexpr iterator begin() {
+        return make_iterator(data_);
     }
-    const_iterator begin() const {
-        return const_iterator(data_, 0);
+    constexpr const_iterator begin() const {
+        return make_const_iterator(data_);
     }
-    const_iterator cbegin() const {
-        return const_iterator(const_cast<const T*>(data_), 0);
+    constexpr const_iterator cbegin() const {
+        return make_const_iterator(data_);
     }
     /**
      * returns an iterator to the end.
      */
-    iterator end() {
-        return iterator(data_, size_);
+    constexpr iterator end() {
+        return make_iterator(data_ + size_);
     }
-    const_iterator end() const {
-        return const_iterator(data_, size_);
+    constexpr const_iterator end() const {
+        return make_const_iterator(data_ + size_);
     }
-    const_iterator cend() const {
-        return const_iterator(const_cast<typename const_iterator::pointer>(data_), size_);
+    constexpr const_iterator cend() const {
+        return make_const_iterator(data_ + size_);
     }
     /**
      * checks whether the container is empty
      */
-    bool empty() const {
+    constexpr bool empty() const {
         return size_ == 0;
     }
     /**
      * returns the number of elements
      */
-    size_t size() const {
+    constexpr size_t size() const {
         return size_;
     }
-    size_t capacity() const {
+    constexpr size_t capacity() const {
         return capacity_;
     }
+    /**
+     * returns a pointer to the underlying successive memory,
+     * [data(), data() + size()) is a valid range.
+     */
+    constexpr T * data() {
+        return data_;
+    }
+    constexpr const T * data() const {
+        return data_;
+    }
     /**
      * clears the contents
      */
-    void clear() {
+    constexpr void clear() {
+        invalidate_iterators();
         for (size_t i = 0; i < size_; i++) {
             data_[i].~T();
         }
@@ -379,8 +440,10 @@ public:
      * inserts value before pos
      * returns an iterator pointing to the inserted value.
      */
-    iterator insert(iterator pos, const T &value) {
-        return insert(pos - begin(), value);
+    template <typename Iter>
+        requires std::is_same_v<Iter, iterator> || std::is_same_v<Iter, const_iterator>
+    constexpr iterator insert(Iter pos, const T &value) {
+        return insert(index_of(pos), value);
     }
     /**
      * inserts value at index ind.
@@ -388,88 +451,292 @@ public:
      * returns an iterator pointing to the inserted value.
      * throw index_out_of_bound if ind > size (in this situation ind can be size because after inserting the size will increase 1.)
      */
-    iterator insert(const size_t &ind, const T &value) {
+    constexpr iterator insert(const size_t &ind, const T &value) {
         if (ind > size_) {
             throw index_out_of_bound();
         }
+        invalidate_iterators();
         if (size_ == capacity_) {
             reserve(capacity_ ? capacity_ * 2 : 1);
         }
-        size_++;
-        for (size_t i = size_ - 1; i > ind; i--) {
-            new (data_ + i) T(std::move(data_[i - 1]));
+        // every slot is destroyed before it is built again, constant
+        // evaluation rejects building over a live object
+        for (size_t i = size_; i > ind; i--) {
+            std::construct_at(data_ + i, std::move(data_[i - 1]));
+            data_[i - 1].~T();
         }
-        new (data_ + ind) T(value);
-        return iterator(data_, ind);
+        std::construct_at(data_ + ind, value);
+        size_++;
+        return make_iterator(data_ + ind);
     }
     /**
      * removes the element at pos.
      * return an iterator pointing to the following element.
      * If the iterator pos refers the last element, the end() iterator is returned.
      */
-    iterator erase(iterator pos) {
-        return erase(pos - begin());
+    template <typename Iter>
+        requires std::is_same_v<Iter, iterator> || std::is_same_v<Iter, const_iterator>
+    constexpr iterator erase(Iter pos) {
+        return erase(index_of(pos));
     }
     /**
      * removes the element with index ind.
      * return an iterator pointing to the following element.
      * throw index_out_of_bound if ind >= size
      */
-    iterator erase(const size_t &ind) {
+    constexpr iterator erase(const size_t &ind) {
         if (ind >= size_) {
             throw index_out_of_bound();
         }
-        data_[ind].~T();
-        size_--;
-        for (size_t i = ind; i < size_; i++) {
-            new (data_ + i) T(std::move(data_[i + 1]));
+        invalidate_iterators();
+        for (size_t i = ind; i + 1 < size_; i++) {
+            data_[i].~T();
+            std::construct_at(data_ + i, std::move(data_[i + 1]));
         }
-        return iterator(data_, ind);
+        size_--;
+        data_[size_].~T();
+        return make_iterator(data_ + ind);
     }
     /**
      * adds an element to the end.
      */
-    void push_back(const T &value) {
+    constexpr void push_back(const T &value) {
         if (size_ == capacity_) {
             reserve(capacity_ ? capacity_ * 2 : 1);
         }
-        new (data_ + size_) T(value); 
+        std::construct_at(data_ + size_, value);
         ++size_;
     }
     /**
      * remove the last element from the end.
      * throw container_is_empty if size() == 0
      */
-    void pop_back() {
+    constexpr void pop_back() {
         if (!size_) {
             throw container_is_empty();
         }
         size_--;
         data_[size_].~T();
     }
+    /**
+     * increases the capacity to at least new_capacity, does nothing if the
+     * capacity is already large enough.
+     */
+    constexpr void reserve(const size_t new_capacity) {
+        if (new_capacity <= capacity_) {
+            return;
+        }
+        invalidate_iterators();
+        T* new_data = allocate(new_capacity);
+        for (size_t i = 0; i < size_; i++) {
+            std::construct_at(new_data + i, std::move(data_[i]));
+            data_[i].~T();
+        }
+        deallocate(data_, capacity_);
+        data_ = new_data;
+        capacity_ = new_capacity;
+
+        // if (capacity_ < size_) {
+        //     size_ = capacity_;
+        // }
+    }
+    /**
+     * changes the size to n without initializing the new elements, for
+     * element types whose default construction does nothing anyway.
+     * the caller is expected to overwrite [old size, n) before reading it.
+     */
+    constexpr void resize_uninitialized(const size_t &n) requires std::is_trivially_default_constructible_v<T> {
+        if (n > capacity_) {
+            reserve(n > capacity_ * 2 ? n : capacity_ * 2);
+        }
+        if (n < size_) {
+            invalidate_iterators();
+        }
+        for (size_t i = n; i < size_; i++) {
+            data_[i].~T();
+        }
+        // constant evaluation does not allow reading storage no object lives in
+        if (std::is_constant_evaluated()) {
+            for (size_t i = size_; i < n; i++) {
+                std::construct_at(data_ + i);
+            }
+        }
+        size_ = n;
+    }
+    /**
+     * appends up to n elements written directly into the storage:
+     * writer(p, n) gets a pointer p to room for n elements behind the last
+     * one, constructs the first k of them and returns k, which becomes the
+     * number of appended elements. a writer returning void appends all n.
+     *   v.append_with(n, [&](int *p, size_t n) { return fread(p, sizeof(int), n, f); });
+     * throw runtime_error if the writer reports more than n elements
+     */
+    template <std::invocable<T *, size_t> Writer>
+    size_t append_with(const size_t &n, Writer writer) {
+        if (size_ + n > capacity_) {
+            reserve(size_ + n > capacity_ * 2 ? size_ + n : capacity_ * 2);
+        }
+        size_t written = n;
+        if constexpr (std::is_void_v<decltype(writer(data_ + size_, n))>) {
+            writer(data_ + size_, n);
+        } else {
+            written = writer(data_ + size_, n);
+            if (written > n) {
+                throw runtime_error();
+            }
+        }
+        size_ += written;
+        return written;
+    }
+    /**
+     * appends the elements of rg, reserving room for all of them first when
+     * their number is known (or countable) in advance.
+     */
+    template <detail::container_compatible_range<T> R>
+    constexpr void append_range(R &&rg) {
+        size_t n = detail::range_size_hint(rg);
+        if (size_ + n > capacity_) {
+            reserve(size_ + n > capacity_ * 2 ? size_ + n : capacity_ * 2);
+        }
+        if constexpr (detail::trivially_copyable_range<R, T>) {
+            if (!std::is_constant_evaluated()) {
+                if (n) {
+                    memcpy(static_cast<void *>(data_ + size_), std::ranges::data(rg), n * sizeof(T));
+                }
+                size_ += n;
+                return;
+            }
+        }
+        for (auto &&x : rg) {
+            push_back(x);
+        }
+    }
+    /**
+     * exchanges the contents of two vectors without copying elements,
+     * iterators of both are invalidated.
+     */
+    constexpr void swap(vector &other) noexcept {
+        invalidate_iterators();
+        other.invalidate_iterators();
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(data_, other.data_);
+    }
 
 private:
     size_t size_ = 0;
     size_t capacity_ = 0;
 
     T* data_ = nullptr;
+#if SJTU_CHECKED_ITERATORS
+    // bumped whenever iterators made so far may no longer be used
+    unsigned long long generation_ = 0;
+#endif
 
-    void reserve(const size_t new_capacity) {
-        capacity_ = new_capacity;
-        T* new_data = reinterpret_cast<T*>(malloc(capacity_ * sizeof(T)));
-        for (size_t i = 0; i < size_; i++) {
-            new (new_data + i) T(std::move(data_[i]));
-            data_[i].~T();
+    constexpr void invalidate_iterators() {
+#if SJTU_CHECKED_ITERATORS
+        ++generation_;
+#endif
+    }
+    constexpr iterator make_iterator(T *p) {
+#if SJTU_CHECKED_ITERATORS
+        return iterator(this, p);
+#else
+        return p;
+#endif
+    }
+    constexpr const_iterator make_const_iterator(const T *p) const {
+#if SJTU_CHECKED_ITERATORS
+        return const_iterator(this, p);
+#else
+        return p;
+#endif
+    }
+    /**
+     * the index pos refers to.
+     * throw invalid_iterator if pos is stale or belongs to another vector
+     */
+    template <typename Iter>
+    constexpr size_t index_of(const Iter &pos) const {
+#if SJTU_CHECKED_ITERATORS
+        if (pos.owner_ != this) {
+            throw invalid_iterator();
+        }
+        pos.check();
+        return pos.ptr_ - data_;
+#else
+        return pos - data_;
+#endif
+    }
+
+    /**
+     * raw storage for n elements. constant evaluation does not allow malloc,
+     * there the storage comes from std::allocator, which it does allow as
+     * long as it is freed again before the evaluation ends.
+     */
+    static constexpr T *allocate(size_t n) {
+        if (std::is_constant_evaluated()) {
+            return std::allocator<T>().allocate(n);
         }
-        free(data_);
-        data_ = new_data;
+        return static_cast<T*>(malloc(n * sizeof(T)));
+    }
+    static constexpr void deallocate(T *p, size_t n) {
+        if (std::is_constant_evaluated()) {
+            if (p != nullptr) {
+                std::allocator<T>().deallocate(p, n);
+            }
+            return;
+        }
+        free(p);
+    }
 
-        // if (capacity_ < size_) {
-        //     size_ = capacity_;
-        // }
+    /**
+     * copy-constructs n elements into raw memory at dst; if one constructor
+     * throws, the elements already built are destroyed again.
+     */
+    static constexpr void copy_construct(T *dst, const T *src, size_t n) {
+        if (std::is_trivially_copyable_v<T> && !std::is_constant_evaluated()) {
+            if (n) {
+                memcpy(static_cast<void *>(dst), src, n * sizeof(T));
+            }
+        } else {
+            size_t i = 0;
+            try {
+                for (; i < n; i++) {
+                    std::construct_at(dst + i, src[i]);
+                }
+            } catch (...) {
+                while (i--) {
+                    dst[i].~T();
+                }
+                throw;
+            }
+        }
     }
 };
 
+/**
+ * runs make() during compilation and copies the vector it returns into a
+ * std::array. a vector built in a constant expression has to be freed
+ * before the expression ends, the array does not, so tables computed this
+ * way are ready before main starts:
+ *   constexpr auto squares = sjtu::to_static_array<[] {
+ *       sjtu::vector<int> v;
+ *       for (int i = 0; i < 16; ++i) v.push_back(i * i);
+ *       return v;
+ *   }>();
+ */
+template <auto Make>
+consteval auto to_static_array() {
+    using V = decltype(Make());
+    constexpr size_t n = Make().size();
+    std::array<typename V::value_type, n> out{};
+    V v = Make();
+    for (size_t i = 0; i < n; i++) {
+        out[i] = v[i];
+    }
+    return out;
+}
 
 }
 